@@ -74,9 +74,9 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 		LUAParserClass parser;
 		int ret = 0;
 		if(pHandle == NULL){
-			parser.parse_luaFunction(functionName);
+			ret = parser.parse_luaFunction(functionName);
 		} else {
-			parser.parse_luaFunction(*pHandle);
+			ret = parser.parse_luaFunction(*pHandle);
 		}
 		if(ret == LUAParserClass::LUAParserError)
 		{
@@ -110,6 +110,17 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 
 		m_iIn = parser.num_in();
 		m_iOut = parser.num_out();
+
+	//	batched entry point, evaluating the function for n input sets in one
+	//	call. The function above is in the same file and can be inlined.
+		out << "\nint LUA2C_Batch(double *LUA2C_ret, const double *LUA2C_in, int n)\n";
+		out << "{\n";
+		out << "\tint i;\n";
+		out << "\tfor(i = 0; i < n; ++i)\n";
+		out << "\t\tif(!" << parser.function_name() << "(LUA2C_ret + i*" << m_iOut
+			<< ", LUA2C_in + i*" << m_iIn << ")) return 0;\n";
+		out << "\treturn 1;\n";
+		out << "}\n";
 		out.close();
 
 		UG_DLOG(DID_LUACOMPILER, 5, GetFileLines((p+"LUACompiler_output.c").c_str(), 1, -1, true) << "\n");
@@ -165,7 +176,8 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 			UG_LOG("Error is " << error << "\n");
 			return false;
 		}
-		m_f = (LUA2C_Function) GetLibraryProcedure(m_libHandle, functionName);
+		m_f = (LUA2C_Function) GetLibraryProcedure(m_libHandle, parser.function_name().c_str());
+		m_fBatch = (LUA2C_BatchFunction) GetLibraryProcedure(m_libHandle, "LUA2C_Batch");
 
 		if(m_f !=NULL) { UG_DLOG(DID_LUACOMPILER, 1, "OK\n"); }
 		else { UG_DLOG(DID_LUACOMPILER, 1, "FAILED\n"); }
@@ -195,9 +207,9 @@ bool LUACompiler::createVM(const char *functionName, LuaFunctionHandle* pHandle)
 	{
 		int ret = 0;
 		if(pHandle == NULL){
-			parser.parse_luaFunction(functionName);
+			ret = parser.parse_luaFunction(functionName);
 		} else {
-			parser.parse_luaFunction(*pHandle);
+			ret = parser.parse_luaFunction(*pHandle);
 		}
 		if(vm != NULL) delete vm;
 		vm = new VMAdd;
@@ -270,11 +282,28 @@ bool LUACompiler::call(double *ret, const double *in) const
 	else
 	{
 		UG_ASSERT(m_f != NULL, "function " << m_name << " not valid");
-		m_f(ret, in);
-		return true;
+		return m_f(ret, in) != 0;
 	}
 }
 
+bool LUACompiler::call_batch(double *ret, const double *in, size_t n) const
+{
+	if(!bVM && m_fBatch != NULL)
+		return m_fBatch(ret, in, (int)n) != 0;
+
+	for(size_t i = 0; i < n; ++i)
+		if(!call(ret + i*m_iOut, in + i*m_iIn))
+			return false;
+	return true;
+}
+
+const char* LUACompiler::backend() const
+{
+	if(!bInitialized) return "none";
+	if(bVM) return "LUA2VM";
+	return "LUA2C";
+}
+
 
 }
 }
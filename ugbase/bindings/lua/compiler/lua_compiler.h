@@ -51,6 +51,7 @@ class LUACompiler
 	
 private:
 	typedef int (*LUA2C_Function)(double *, const double *) ;
+	typedef int (*LUA2C_BatchFunction)(double *, const double *, int) ;
 	
 	DynLibHandle m_libHandle;
 	std::string m_pDyn;
@@ -59,12 +60,14 @@ private:
 public:
 	std::string m_name;
 	LUA2C_Function m_f;
+	LUA2C_BatchFunction m_fBatch;
 	int m_iIn, m_iOut;
 	bool bInitialized;
 	bool bVM;
 	LUACompiler()
 	{ 
 		m_f= NULL; 
+		m_fBatch = NULL;
 		m_name = "uninitialized"; 
 		m_pDyn = ""; 
 		m_libHandle = NULL;
@@ -98,6 +101,17 @@ public:
 	bool createC(const char *functionName, LuaFunctionHandle* pHandle = NULL);
 	
 	bool call(double *ret, const double *in) const;
+
+	///	evaluates the function for n input sets at once
+	/**
+	 * The input sets are stored consecutively in in (n*num_in() values),
+	 * the results are written consecutively to ret (n*num_out() values).
+	 * For LUA2C, this is a single call into the compiled library.
+	 */
+	bool call_batch(double *ret, const double *in, size_t n) const;
+
+	///	returns the name of the used backend ("LUA2C", "LUA2VM" or "none")
+	const char* backend() const;
 	virtual ~LUACompiler();
 };
 
@@ -103,6 +103,11 @@ public:
 	{
 		name = s;
 	}
+
+	const std::string& function_name() const
+	{
+		return name;
+	}
 	
 	void set_name(int id)
 	{
@@ -204,7 +209,7 @@ public:
 			i++;
 			a = a->opr.op[1];
 		}
-		return i;
+		return i+1;
 	}
 	
 	int num_out()
@@ -33,6 +33,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <map>
 
 // include bridge
 #include "bridge/bridge.h"
@@ -60,6 +61,31 @@ bool CheckLuaCallbackName(const char* name)
 	else return true;
 }
 
+///	evaluation path per (user data, callback)
+static map<pair<string, string>, string>& LuaCallbackEvalPaths()
+{
+	static map<pair<string, string>, string> paths;
+	return paths;
+}
+
+void SetLuaCallbackEvalPath(const std::string& userDataName,
+                            const std::string& callbackName,
+                            const std::string& path)
+{
+	LuaCallbackEvalPaths()[make_pair(userDataName, callbackName)] = path;
+}
+
+void PrintLuaCallbackReport()
+{
+	typedef map<pair<string, string>, string> Map;
+	const Map& paths = LuaCallbackEvalPaths();
+
+	UG_LOG("Lua callbacks used in user data (" << paths.size() << "):\n");
+	for(Map::const_iterator it = paths.begin(); it != paths.end(); ++it)
+		UG_LOG("  " << it->first.second << " (" << it->first.first << "): "
+				<< it->second << "\n");
+}
+
 
 LuaUserNumberNumberFunction::LuaUserNumberNumberFunction()
 {
@@ -255,6 +281,9 @@ static void Dimension(Registry& reg, string grp)
  */
 static void Common(Registry& reg, string grp)
 {
+	reg.add_function("PrintLuaCallbackReport", &PrintLuaCallbackReport, grp,
+	                 "", "", "prints for each lua callback used in a user data "
+	                 "if it is evaluated compiled (LUA2C, LUA2VM) or by lua");
 
 //	LuaUserNumberNumberFunction
 	{
@@ -77,6 +77,14 @@ namespace ug
 ///	returns true if callback exists
 bool CheckLuaCallbackName(const char* name);
 
+///	stores which evaluation path (compiled or lua) is used for a callback
+void SetLuaCallbackEvalPath(const std::string& userDataName,
+                            const std::string& callbackName,
+                            const std::string& path);
+
+///	prints the evaluation path used for each lua callback of a user data
+void PrintLuaCallbackReport();
+
 // predeclaration
 template <typename TData, int dim, typename TRet = void>
 class LuaUserDataFactory;
@@ -97,6 +105,11 @@ class LuaUserData
 	///	friend class
 		friend class LuaUserDataFactory<TData, dim, TRet>;
 
+	public:
+	///	type of base class
+		typedef StdGlobPosData<LuaUserData<TData, dim, TRet>, TData, dim, TRet> base_type;
+		using base_type::operator();
+
 	public:
 	///	Constructor
 	/**
@@ -135,10 +148,53 @@ class LuaUserData
 	///	evaluates the data at a given point and time
 		inline TRet evaluate(TData& D, const MathVector<dim>& x, number time, int si) const;
 
+	///	evaluates the data at all given points
+	/**
+	 * If the callback has been compiled (LUA2C or LUA2VM), all points are
+	 * evaluated by a single call of the compiled function. Otherwise, or if
+	 * the compiled call fails, the lua callback is called for each point.
+	 */
+		void evaluate(TData vValue[], const MathVector<dim> vGlobIP[],
+		              number time, int si, const size_t nip) const;
+
+	///	evaluates the data at all given points
+		virtual void operator()(TData vValue[], const MathVector<dim> vGlobIP[],
+		                        number time, int si, const size_t nip) const
+		{
+			evaluate(vValue, vGlobIP, time, si, nip);
+		}
+
+	///	implement as a UserData
+		virtual void compute(LocalVector* u, GridObject* elem,
+		                     const MathVector<dim> vCornerCoords[], bool bDeriv = false)
+		{
+			const number t = this->time();
+			const int si = this->subset();
+
+			for(size_t s = 0; s < this->num_series(); ++s)
+				evaluate(this->values(s), this->ips(s), t, si, this->num_ip(s));
+		}
+
+	///	implement as a UserData
+		virtual void compute(LocalVectorTimeSeries* u, GridObject* elem,
+		                     const MathVector<dim> vCornerCoords[], bool bDeriv = false)
+		{
+			const int si = this->subset();
+
+			for(size_t s = 0; s < this->num_series(); ++s)
+				evaluate(this->values(s), this->ips(s), this->time(s), si, this->num_ip(s));
+		}
+
+	///	returns the evaluation path used for the callback
+		std::string eval_path() const;
+
 	protected:
 	///	sets that LuaUserData is created by LuaUserDataFactory
 		void set_created_from_factory(bool bFromFactory) {m_bFromFactory = bFromFactory;}
 
+	///	checks if compiled function is usable and reports the evaluation path
+		void init_eval_path();
+
 	protected:
 	///	callback name as string
 		std::string m_callbackName;
@@ -150,6 +206,14 @@ class LuaUserData
     	/// LUACompiler type for compiled LUA code
 			bridge::LUACompiler m_luaComp;
 		#endif
+
+	///	flag, indicating if the compiled function is used
+		mutable bool m_bCompiled;
+
+	///	buffers for batched evaluation of the compiled function
+		mutable std::vector<double> m_vCompIn;
+		mutable std::vector<double> m_vCompOut;
+
 	///	flag, indicating if created from factory
 		bool m_bFromFactory;
 
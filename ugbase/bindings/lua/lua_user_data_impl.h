@@ -90,7 +90,7 @@ std::string LuaUserData<TData,dim,TRet>::name()
 
 template <typename TData, int dim, typename TRet>
 LuaUserData<TData,dim,TRet>::LuaUserData(const char* luaCallback)
-	: m_callbackName(luaCallback), m_bFromFactory(false)
+	: m_callbackName(luaCallback), m_bCompiled(false), m_bFromFactory(false)
 {
 //	get lua state
 	m_L = ug::script::GetDefaultLuaState();
@@ -113,11 +113,13 @@ LuaUserData<TData,dim,TRet>::LuaUserData(const char* luaCallback)
 	#ifdef USE_LUA2C
 		if(useLuaCompiler) m_luaComp.create(luaCallback);
 	#endif
+
+	init_eval_path();
 }
 
 template <typename TData, int dim, typename TRet>
 LuaUserData<TData,dim,TRet>::LuaUserData(LuaFunctionHandle handle)
-	: m_callbackName("__anonymous__lua__function__"), m_bFromFactory(false)
+	: m_callbackName("__anonymous__lua__function__"), m_bCompiled(false), m_bFromFactory(false)
 {
 //	get lua state
 	m_L = ug::script::GetDefaultLuaState();
@@ -132,6 +134,41 @@ LuaUserData<TData,dim,TRet>::LuaUserData(LuaFunctionHandle handle)
 //		UG_THROW("LuaFunctionHandle usage currently not supported with LUA2C.");
 		if(useLuaCompiler) m_luaComp.create(m_callbackName.c_str(), &handle);
 	#endif
+
+	init_eval_path();
+}
+
+template <typename TData, int dim, typename TRet>
+void LuaUserData<TData,dim,TRet>::init_eval_path()
+{
+	m_bCompiled = false;
+
+	#ifdef USE_LUA2C
+	if(useLuaCompiler && m_luaComp.is_valid())
+	{
+	//	the compiled function must match the callback signature
+		const int numIn = dim + 2;
+		const int numOut = lua_traits<TData>::size + lua_traits<TRet>::size;
+		if(m_luaComp.num_in() == numIn && m_luaComp.num_out() == numOut)
+			m_bCompiled = true;
+		else
+			UG_LOG("WARNING (in " << name() << "): compiled callback '"
+					<< m_callbackName << "' has " << m_luaComp.num_in()
+					<< " inputs and " << m_luaComp.num_out() << " outputs, but "
+					<< numIn << " and " << numOut << " are required. Using lua.\n");
+	}
+	#endif
+
+	SetLuaCallbackEvalPath(name(), m_callbackName, eval_path());
+}
+
+template <typename TData, int dim, typename TRet>
+std::string LuaUserData<TData,dim,TRet>::eval_path() const
+{
+	#ifdef USE_LUA2C
+	if(m_bCompiled) return m_luaComp.backend();
+	#endif
+	return "lua";
 }
 
 
@@ -283,7 +320,7 @@ evaluate(TData& D, const MathVector<dim>& x, number time, int si) const
 {
     PROFILE_CALLBACK()
     #ifdef USE_LUA2C
-	if(useLuaCompiler && m_luaComp.is_valid())
+	if(useLuaCompiler && m_bCompiled)
 	{
 		double d[dim+2];
 		for(int i=0; i<dim; i++)
@@ -349,6 +386,53 @@ evaluate(TData& D, const MathVector<dim>& x, number time, int si) const
 	}
 }
 
+template <typename TData, int dim, typename TRet>
+void LuaUserData<TData,dim,TRet>::
+evaluate(TData vValue[], const MathVector<dim> vGlobIP[],
+         number time, int si, const size_t nip) const
+{
+	PROFILE_CALLBACK()
+	if(nip == 0) return;
+
+	#ifdef USE_LUA2C
+	if(useLuaCompiler && m_bCompiled)
+	{
+		const size_t numIn = dim + 2;
+		const size_t numOut = lua_traits<TData>::size + lua_traits<TRet>::size;
+
+	//	pack all points
+		m_vCompIn.resize(nip * numIn);
+		m_vCompOut.resize(nip * numOut);
+		for(size_t ip = 0; ip < nip; ++ip)
+		{
+			double* d = &m_vCompIn[ip * numIn];
+			for(int i = 0; i < dim; ++i)
+				d[i] = vGlobIP[ip][i];
+			d[dim] = time;
+			d[dim+1] = si;
+		}
+
+	//	evaluate all points at once
+		if(m_luaComp.call_batch(&m_vCompOut[0], &m_vCompIn[0], nip))
+		{
+			TRet* t = NULL;
+			for(size_t ip = 0; ip < nip; ++ip)
+				lua_traits<TData>::read(vValue[ip], &m_vCompOut[ip * numOut], t);
+			return;
+		}
+
+	//	compiled call failed, use lua from now on
+		UG_LOG("WARNING (in " << name() << "): compiled callback '"
+				<< m_callbackName << "' failed. Using lua from now on.\n");
+		m_bCompiled = false;
+		SetLuaCallbackEvalPath(name(), m_callbackName, "lua (fallback)");
+	}
+	#endif
+
+	for(size_t ip = 0; ip < nip; ++ip)
+		evaluate(vValue[ip], vGlobIP[ip], time, si);
+}
+
 template <typename TData, int dim, typename TRet>
 LuaUserData<TData,dim,TRet>::~LuaUserData()
 {
@@ -458,6 +458,13 @@ static void Common(Registry& reg, string grp)
 		reg.add_class_to_group("IPositionProvider2d", "IPositionProvider", GetDimensionTag<2>());
 		reg.add_class_to_group("IPositionProvider3d", "IPositionProvider", GetDimensionTag<3>());
 	}
+
+//	execution format of SparseMatrix
+	{
+		reg.add_function("SetSparseMatrixSellCSigma", &SetSparseMatrixSellCSigma, grp,
+				"", "bEnable#chunkSize#sigma",
+				"applies matrices with fixed-size blocks in the SELL-C-sigma format");
+	}
 }
 
 }; // end Functionality
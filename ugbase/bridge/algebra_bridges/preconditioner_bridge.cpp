@@ -165,10 +165,38 @@ static void Algebra(Registry& reg, string grp)
 			.add_constructor()
 			.template add_constructor<void (*)(number)>("DampingFactor")
 			//.add_method("set_block", &T::set_block, "", "block", "if true, use block smoothing (default), else diagonal smoothing")
+			.add_method("set_float_storage", &T::set_float_storage, "", "enable",
+					"stores the inverse diagonal in single precision (correction is accumulated in double precision)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "Jacobi", tag);
 	}
 
+//	Chebyshev
+	{
+		typedef Chebyshev<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("Chebyshev").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Chebyshev polynomial smoother")
+			.add_constructor()
+			.template add_constructor<void (*)(int)>("Degree")
+			.add_method("set_degree", &T::set_degree, "", "degree",
+					"sets the number of diagonal scalings per application (default: 3)")
+			.add_method("set_eigenvalue_ratio", &T::set_eigenvalue_ratio, "", "ratio",
+					"sets lambda_max/lambda_min of the smoothed interval (default: 30)")
+			.add_method("set_num_estimation_steps", &T::set_num_estimation_steps, "", "steps",
+					"sets the number of CG-Lanczos steps for the estimation of lambda_max (default: 10)")
+			.add_method("set_safety_factor", &T::set_safety_factor, "", "factor",
+					"sets the factor the estimated lambda_max is multiplied with (default: 1.1)")
+			.add_method("set_eigenvalue_bounds", &T::set_eigenvalue_bounds, "", "lambda_min#lambda_max",
+					"sets the bounds of the spectrum of D^{-1}A explicitly (no estimation)")
+			.add_method("min_eigenvalue", &T::min_eigenvalue, "lambda_min", "",
+					"lower bound of the smoothed interval (available after init)")
+			.add_method("max_eigenvalue", &T::max_eigenvalue, "lambda_max", "",
+					"upper bound of the smoothed interval (available after init)")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Chebyshev", tag);
+	}
+
 //	GaussSeidelBase
 	{
 		typedef GaussSeidelBase<TAlgebra> T;
@@ -177,7 +205,9 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "Gauss-Seidel Base")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "makes the matrix and defect consistent at the proc. interfaces")
 			.add_method("set_sor_relax", &T::set_sor_relax,
-					"", "sor relaxation", "sets sor relaxation parameter");
+					"", "sor relaxation", "sets sor relaxation parameter")
+			.add_method("set_level_scheduling", &T::set_level_scheduling, "", "enable",
+					"processes independent rows of the sweep thread-parallel (same result as the sequential sweep)");
 		reg.add_class_to_group(name, "GaussSeidelBase", tag);
 	}
 
@@ -247,6 +277,10 @@ static void Algebra(Registry& reg, string grp)
 						"set whether preprocessing (notably, LU factorization) is to be disabled - usable when the operator has not changed; use with care")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "Make Matrix consistent for connections in interfaces.")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
+			.add_method("set_level_scheduling", &T::set_level_scheduling, "", "enable",
+						"processes independent rows of the triangular solves thread-parallel (same result as the sequential solve)")
+			.add_method("set_float_storage", &T::set_float_storage, "", "enable",
+						"stores the factors in single precision (triangular solves accumulate in double precision)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILU", tag);
 	}
@@ -264,6 +298,8 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("set_info", &T::set_info,
 						"", "info", "sets storage information output")
 			.add_method("set_sort", &T::set_sort, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in. default true")
+			.add_method("set_float_storage", &T::set_float_storage, "", "enable",
+						"stores the factors in single precision (triangular solves accumulate in double precision)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILUT", tag);
 	}
@@ -283,6 +319,28 @@ static void Algebra(Registry& reg, string grp)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILUTScalar", tag);
 	}
+//	AggregationAMG
+	{
+		typedef AggregationAMG<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("AggregationAMG").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Smoothed Aggregation Algebraic Multigrid")
+			.add_constructor()
+			.add_method("set_smoother", &T::set_smoother, "", "smoother", "sets the smoother (cloned for each level, default: Jacobi(0.66))")
+			.add_method("set_base_solver", &T::set_base_solver, "", "baseSolver", "sets the solver on the coarsest level (default: LU)")
+			.add_method("set_strong_connection_threshold", &T::set_strong_connection_threshold, "", "theta", "threshold for strong connections (default: 0.08)")
+			.add_method("set_prolongation_damping", &T::set_prolongation_damping, "", "factor", "damping of prolongation smoothing, omega = factor/rho (default: 4/3)")
+			.add_method("set_smooth_prolongation", &T::set_smooth_prolongation, "", "bSmooth", "if false, the tentative prolongation is used (default: true)")
+			.add_method("set_max_levels", &T::set_max_levels, "", "maxLevels", "maximal number of levels (default: 20)")
+			.add_method("set_max_base_size", &T::set_max_base_size, "", "maxBase", "size up to which the base solver is used (default: 200)")
+			.add_method("set_num_presmooth", &T::set_num_presmooth, "", "nu1", "number of presmoothing steps (default: 2)")
+			.add_method("set_num_postsmooth", &T::set_num_postsmooth, "", "nu2", "number of postsmoothing steps (default: 2)")
+			.add_method("set_reuse_hierarchy", &T::set_reuse_hierarchy, "", "bReuse", "if true, aggregates are reused for matrices of the same pattern (default: false)")
+			.add_method("set_info", &T::set_info, "", "bInfo", "prints the hierarchy after setup")
+			.add_method("num_levels", &T::num_levels, "number of levels")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "AggregationAMG", tag);
+	}
 
 //	LinearIteratorProduct
 	{
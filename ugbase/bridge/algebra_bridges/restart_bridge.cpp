@@ -142,6 +142,10 @@ end
 
 
 See also checkpoint_util.lua and time_step_util.lua on how to generate checkpointing/debugging mechanisms with this.
+
+Note that SaveToFile/ReadFromFile only store the vector. To restart without reloading,
+distributing and refining the grid, use the Checkpoint class (lib_disc/io/checkpoint.h),
+which additionally stores the multigrid, its subsets and its parallel interfaces.
  */
 
 template<typename T>
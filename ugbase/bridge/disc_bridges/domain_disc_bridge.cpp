@@ -237,6 +237,14 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T>(name+suffix, grp)
 			.add_method("set_matrix_is_const", &T::set_matrix_is_const, "",
 						"whether matrix is constant in time", "")
+			.add_method("set_num_threads", &T::set_num_threads, "",
+						"numThreads", "sets the number of threads used in the element loops (requires OpenMP)")
+			.add_method("set_reuse_matrix_pattern", &T::set_reuse_matrix_pattern, "",
+						"bReuse", "keeps the sparsity pattern of assembled matrices while the DoFDistribution is unchanged")
+			.add_method("set_cache_local_indices", &T::set_cache_local_indices, "",
+						"bCache", "caches the local indices and matrix positions of the elements")
+			.add_method("set_user_data_batch_size", &T::set_user_data_batch_size, "",
+						"blockSize", "evaluates position dependent user data for blocks of elements at once (0: off)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name+suffix, name, tag);
 	}
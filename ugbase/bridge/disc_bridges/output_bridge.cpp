@@ -46,6 +46,7 @@
 #include "lib_disc/function_spaces/approximation_space.h"
 
 #include "lib_disc/io/vtkoutput.h"
+#include "lib_disc/io/checkpoint.h"
 #include "common/profiler/profiler.h"
 
 #include "../util_overloaded.h"
@@ -146,6 +147,20 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "GridFunctionDebugWriter", tag);
 	}
 
+//	Checkpoint
+	{
+		typedef Checkpoint<TDomain, TAlgebra> T;
+		string name = string("Checkpoint").append(suffix);
+		reg.add_class_<T>(name, grp)
+			.template add_constructor<void (*)(SmartPtr<TDomain>)>("Domain")
+			.add_method("add", &T::add, "", "GridFunction # Name", "registers a grid function for save and restore")
+			.add_method("save", &T::save, "", "Filename", "writes domain and grid functions")
+			.add_method("load_domain", &T::load_domain, "", "Filename", "restores the (empty) domain")
+			.add_method("load_grid_functions", &T::load_grid_functions, "", "", "restores the grid functions")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Checkpoint", tag);
+	}
+
 //	GridFunctionPositionProvider
 	{
 		typedef GridFunctionPositionProvider<function_type> T;
@@ -448,9 +448,14 @@ static void Domain(Registry& reg, string grp)
 					"", "Domain # Filename # NumRefines | load-dialog | endings=[\"ugx\"]; description=\"*.ugx-Files\" # Number Refinements",
 					"Loads a domain and performs global refinement", "No help");
 //	SaveDomain
-	reg.add_function("SaveDomain", &SaveDomain<TDomain>, grp,
+	reg.add_function("SaveDomain", static_cast<void (*)(TDomain&, const char*)>(
+					 &SaveDomain<TDomain>), grp,
 					"", "Domain # Filename|save-dialog| endings=[\"ugx\"]",
 					"Saves a domain", "No help");
+	reg.add_function("SaveDomain", static_cast<void (*)(TDomain&, const char*, bool)>(
+					 &SaveDomain<TDomain>), grp,
+					"", "Domain # Filename|save-dialog| endings=[\"ugx\"] # binary",
+					"Saves a domain, optionally with binary data blocks in ugx-files", "No help");
 
 //	SavePartitionMap
 	reg.add_function("SavePartitionMap", &SavePartitionMap<TDomain>, grp,
@@ -463,6 +468,14 @@ static void Domain(Registry& reg, string grp)
 		static_cast<bool (*)(TDomain&, PartitionMap&, bool)>(&DistributeDomain<TDomain>),
 		grp);
 
+	reg.add_function("SavePartitionedDomain", &SavePartitionedDomain<TDomain>, grp,
+					 "success", "domain#partitionMap#filename",
+					 "Writes the partitions of a serial domain to one file, from which each process loads its own part. "
+					 "Refinement projectors and additional subset handlers are not written.");
+	reg.add_function("LoadPartitionedDomain", &LoadPartitionedDomain<TDomain>, grp,
+					 "success", "domain#filename",
+					 "Loads the partition of the local process from a file written by SavePartitionedDomain.");
+
 //	PartitionDomain
 	reg.add_function("PartitionDomain_MetisKWay",
 					 static_cast<bool (*)(TDomain&, PartitionMap&, int, size_t, int, int)>(&PartitionDomain_MetisKWay<TDomain>), grp);
@@ -47,6 +47,7 @@
 	#include "lib_grid/parallelization/load_balancer.h"
 	#include "lib_grid/parallelization/load_balancer_util.h"
 	#include "lib_grid/parallelization/partitioner_dynamic_bisection.h"
+	#include "lib_grid/parallelization/partitioner_space_filling_curve.h"
 	#include "lib_grid/parallelization/balance_weights_ref_marks.h"
 	#include "lib_grid/parallelization/partition_pre_processors/replace_coordinate.h"
 	#include "lib_grid/parallelization/partition_post_processors/smooth_partition_bounds.h"
@@ -197,6 +198,32 @@ static void RegisterDynamicBisectionPartitioner(
 	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
 }
 
+template <class TDomain, class TPartitioner>
+static void RegisterSpaceFillingCurvePartitioner(
+	Registry& reg,
+	string name,
+	string grpName,
+	string clsGrpName)
+{
+	reg.add_class_<TPartitioner, IPartitioner>(name, grpName)
+		.template add_constructor<void (*)(TDomain&)>()
+		.add_method("set_subset_handler",
+			&TPartitioner::set_subset_handler)
+		.add_method("enable_hilbert_curve",
+			&TPartitioner::enable_hilbert_curve)
+		.add_method("hilbert_curve_enabled",
+			&TPartitioner::hilbert_curve_enabled)
+		.add_method("set_tolerance",
+			&TPartitioner::set_tolerance)
+		.add_method("num_split_improvement_iterations",
+			&TPartitioner::num_split_improvement_iterations)
+		.add_method("set_num_split_improvement_iterations",
+			&TPartitioner::set_num_split_improvement_iterations)
+		.set_construct_as_smart_pointer(true);
+
+	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
+}
+
 template <class TDomain, class elem_t>
 static void RegisterSmoothPartitionBounds(
 	Registry& reg,
@@ -331,6 +358,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Edge, 1> > >(
+			reg,
+			"EdgePartitioner_SpaceFillingCurve1d",
+			grp,
+			"Partitioner_SpaceFillingCurve");
+
 
 		RegisterSmoothPartitionBounds<TDomain, Edge>(
 			reg,
@@ -357,6 +392,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"ManifoldPartitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Edge, 2> > >(
+			reg,
+			"EdgePartitioner_SpaceFillingCurve2d",
+			grp,
+			"ManifoldPartitioner_SpaceFillingCurve");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Face, 2> > >(
@@ -365,6 +408,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Face, 2> > >(
+			reg,
+			"FacePartitioner_SpaceFillingCurve2d",
+			grp,
+			"Partitioner_SpaceFillingCurve");
+
 		RegisterSmoothPartitionBounds<TDomain, Face>(
 			reg,
 			"SmoothPartitionBounds2d",
@@ -390,6 +441,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"HyperManifoldPartitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Edge, 3> > >(
+			reg,
+			"EdgePartitioner_SpaceFillingCurve3d",
+			grp,
+			"HyperManifoldPartitioner_SpaceFillingCurve");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Face, 3> > >(
@@ -398,6 +457,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"ManifoldPartitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Face, 3> > >(
+			reg,
+			"FacePartitioner_SpaceFillingCurve3d",
+			grp,
+			"ManifoldPartitioner_SpaceFillingCurve");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Volume, 3> > >(
@@ -406,6 +473,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Volume, 3> > >(
+			reg,
+			"VolumePartitioner_SpaceFillingCurve3d",
+			grp,
+			"Partitioner_SpaceFillingCurve");
+
 		RegisterSmoothPartitionBounds<TDomain, Volume>(
 			reg,
 			"SmoothPartitionBounds3d",
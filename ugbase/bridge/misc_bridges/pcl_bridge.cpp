@@ -37,6 +37,7 @@
 
 #ifdef UG_PARALLEL
 #include "pcl/pcl.h"
+#include "pcl/parallel_collective_io.h"
 #endif
 
 using namespace std;
@@ -148,6 +149,15 @@ void RegisterBridge_PCL(Registry& reg, string parentGroup)
 	reg.add_function("ParallelVecMin", &ParallelVecMin<double>, grp, "tmax", "t", "returns the minimum of t over all processes. note: you have to assure that all processes call this function.");
 	reg.add_function("ParallelVecMax", &ParallelVecMax<double>, grp, "tmin", "t", "returns the maximum of t over all processes. note: you have to assure that all processes call this function.");
 	reg.add_function("ParallelVecSum", &ParallelVecSum<double>, grp, "tsum", "t", "returns the sum of t over all processes. note: you have to assure that all processes call this function.");
+
+	reg.add_function("SetCollectiveIONumAggregators", &pcl::SetCollectiveIONumAggregators, grp,
+					 "", "numAggregators", "sets the number of processes writing to disk in collective file output (0: automatic)");
+	reg.add_function("SetCollectiveIOStripeSize", &pcl::SetCollectiveIOStripeSize, grp,
+					 "", "stripeSize", "sets the size in bytes of the file domains assigned to the aggregators");
+	reg.add_function("SetCollectiveIOAsync", &pcl::SetCollectiveIOAsync, grp,
+					 "", "bAsync", "if enabled, collective file output returns before the data is written to disk");
+	reg.add_function("CompletePendingFileWrites", &pcl::CompletePendingFileWrites, grp,
+					 "", "", "waits until all asynchronous collective file output is written to disk");
 }
 
 #else // UG_PARALLEL
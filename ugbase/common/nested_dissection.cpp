@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+#include "nested_dissection.h"
+
+namespace ug{
+
+///	a subgraph to be ordered and the first new index assigned to it
+struct NDSubgraph
+{
+	std::vector<size_t> vIndex;
+	size_t id;
+	size_t firstNew;
+};
+
+///	helper holding the marker fields for the breadth first searches
+class NDLevelStructure
+{
+	public:
+		NDLevelStructure(const std::vector<std::vector<size_t> >& vvNeighbour)
+			: m_vvNeighbour(vvNeighbour),
+			  m_vSubgraph(vvNeighbour.size(), 0),
+			  m_vVisited(vvNeighbour.size(), 0),
+			  m_vLevel(vvNeighbour.size(), 0),
+			  m_stamp(0)
+		{}
+
+	///	assigns the indices to a subgraph
+		void set_subgraph(const std::vector<size_t>& vIndex, size_t id)
+		{
+			for(size_t i = 0; i < vIndex.size(); ++i)
+				m_vSubgraph[vIndex[i]] = id;
+		}
+
+	///	computes the level structure of the subgraph id rooted at root
+	/**
+	 * \returns the number of indices reached
+	 */
+		size_t compute(size_t root, size_t id)
+		{
+			++m_stamp;
+			m_vIndex.clear(); m_vLevelStart.clear();
+
+			m_vIndex.push_back(root);
+			m_vVisited[root] = m_stamp;
+			m_vLevel[root] = 0;
+
+			size_t begin = 0, level = 0;
+			while(begin < m_vIndex.size())
+			{
+				const size_t end = m_vIndex.size();
+				m_vLevelStart.push_back(begin);
+				for(size_t k = begin; k < end; ++k)
+				{
+					const std::vector<size_t>& vNeighbour = m_vvNeighbour[m_vIndex[k]];
+					for(size_t j = 0; j < vNeighbour.size(); ++j)
+					{
+						const size_t w = vNeighbour[j];
+						if(m_vSubgraph[w] != id || m_vVisited[w] == m_stamp) continue;
+						m_vVisited[w] = m_stamp;
+						m_vLevel[w] = level + 1;
+						m_vIndex.push_back(w);
+					}
+				}
+				begin = end;
+				++level;
+			}
+			m_vLevelStart.push_back(m_vIndex.size());
+			return m_vIndex.size();
+		}
+
+	///	number of levels of the last computed level structure
+		size_t num_levels() const {return m_vLevelStart.size() - 1;}
+
+	///	indices of the last computed level structure, sorted by level
+		const std::vector<size_t>& indices() const {return m_vIndex;}
+
+	///	position of the first index of a level in indices()
+		size_t level_start(size_t lev) const {return m_vLevelStart[lev];}
+
+	///	returns if an index has been reached by the last search
+		bool visited(size_t i) const {return m_vVisited[i] == m_stamp;}
+
+	///	level of an index reached by the last search
+		size_t level(size_t i) const {return m_vLevel[i];}
+
+	///	returns if an index of the subgraph has a neighbor in the given level
+		bool has_neighbor_in_level(size_t i, size_t id, size_t lev) const
+		{
+			const std::vector<size_t>& vNeighbour = m_vvNeighbour[i];
+			for(size_t j = 0; j < vNeighbour.size(); ++j)
+			{
+				const size_t w = vNeighbour[j];
+				if(m_vSubgraph[w] == id && visited(w) && m_vLevel[w] == lev)
+					return true;
+			}
+			return false;
+		}
+
+	protected:
+		const std::vector<std::vector<size_t> >& m_vvNeighbour;
+		std::vector<size_t> m_vSubgraph;
+		std::vector<size_t> m_vVisited;
+		std::vector<size_t> m_vLevel;
+		size_t m_stamp;
+
+		std::vector<size_t> m_vIndex;
+		std::vector<size_t> m_vLevelStart;
+};
+
+// computes ordering using nested dissection
+void ComputeNestedDissectionOrder(std::vector<size_t>& vNewIndex,
+                                  const std::vector<std::vector<size_t> >& vvNeighbour,
+                                  size_t minSize)
+{
+	PROFILE_FUNC();
+	const size_t n = vvNeighbour.size();
+	vNewIndex.resize(n);
+	if(n == 0) return;
+	if(minSize < 1) minSize = 1;
+
+	NDLevelStructure ls(vvNeighbour);
+	size_t numIds = 1;
+
+//	start with the whole graph
+	std::vector<NDSubgraph> vStack(1);
+	vStack[0].vIndex.resize(n);
+	for(size_t i = 0; i < n; ++i) vStack[0].vIndex[i] = i;
+	vStack[0].id = 0;
+	vStack[0].firstNew = 0;
+
+	while(!vStack.empty())
+	{
+		NDSubgraph sg;
+		sg.vIndex.swap(vStack.back().vIndex);
+		sg.id = vStack.back().id;
+		sg.firstNew = vStack.back().firstNew;
+		vStack.pop_back();
+
+		const std::vector<size_t>& vIndex = sg.vIndex;
+		const size_t size = vIndex.size();
+
+	//	small subgraphs keep their order
+		if(size <= minSize)
+		{
+			for(size_t k = 0; k < size; ++k)
+				vNewIndex[vIndex[k]] = sg.firstNew + k;
+			continue;
+		}
+
+	//	split off the connected component of the first index
+		size_t root = vIndex[0];
+		if(ls.compute(root, sg.id) < size)
+		{
+			NDSubgraph comp, rest;
+			comp.vIndex = ls.indices();
+			for(size_t k = 0; k < size; ++k)
+				if(!ls.visited(vIndex[k])) rest.vIndex.push_back(vIndex[k]);
+
+			comp.id = numIds++; comp.firstNew = sg.firstNew;
+			rest.id = numIds++; rest.firstNew = sg.firstNew + comp.vIndex.size();
+			ls.set_subgraph(comp.vIndex, comp.id);
+			ls.set_subgraph(rest.vIndex, rest.id);
+
+			vStack.push_back(NDSubgraph()); vStack.back().id = rest.id;
+			vStack.back().firstNew = rest.firstNew; vStack.back().vIndex.swap(rest.vIndex);
+			vStack.push_back(NDSubgraph()); vStack.back().id = comp.id;
+			vStack.back().firstNew = comp.firstNew; vStack.back().vIndex.swap(comp.vIndex);
+			continue;
+		}
+
+	//	search pseudo-peripheral index: restart from an index of minimal
+	//	degree in the last level as long as the number of levels grows
+		for(size_t iter = 0; iter < 8; ++iter)
+		{
+			const size_t numLevels = ls.num_levels();
+			const std::vector<size_t>& vLS = ls.indices();
+			size_t cand = vLS[ls.level_start(numLevels-1)];
+			for(size_t k = ls.level_start(numLevels-1); k < ls.level_start(numLevels); ++k)
+				if(vvNeighbour[vLS[k]].size() < vvNeighbour[cand].size())
+					cand = vLS[k];
+
+			ls.compute(cand, sg.id);
+			if(ls.num_levels() <= numLevels)
+			{
+				ls.compute(root, sg.id);
+				break;
+			}
+			root = cand;
+		}
+
+	//	too few levels for a separator: keep order
+		const size_t numLevels = ls.num_levels();
+		if(numLevels < 3)
+		{
+			for(size_t k = 0; k < size; ++k)
+				vNewIndex[vIndex[k]] = sg.firstNew + k;
+			continue;
+		}
+
+	//	separator level: level containing the median index
+		size_t sepLev = ls.level(ls.indices()[size / 2]);
+		if(sepLev < 1) sepLev = 1;
+		if(sepLev > numLevels - 2) sepLev = numLevels - 2;
+
+	//	split: indices of the separator level without neighbor in the next
+	//	level are moved to the first part
+		NDSubgraph partA, partB;
+		std::vector<size_t> vSep;
+		const std::vector<size_t>& vLS = ls.indices();
+		for(size_t k = 0; k < size; ++k)
+		{
+			const size_t i = vLS[k];
+			const size_t lev = ls.level(i);
+			if(lev < sepLev) partA.vIndex.push_back(i);
+			else if(lev > sepLev) partB.vIndex.push_back(i);
+			else if(ls.has_neighbor_in_level(i, sg.id, sepLev + 1)) vSep.push_back(i);
+			else partA.vIndex.push_back(i);
+		}
+
+	//	separator is numbered last
+		const size_t sepFirst = sg.firstNew + partA.vIndex.size() + partB.vIndex.size();
+		for(size_t k = 0; k < vSep.size(); ++k)
+			vNewIndex[vSep[k]] = sepFirst + k;
+
+		partA.id = numIds++; partA.firstNew = sg.firstNew;
+		partB.id = numIds++; partB.firstNew = sg.firstNew + partA.vIndex.size();
+		ls.set_subgraph(partA.vIndex, partA.id);
+		ls.set_subgraph(partB.vIndex, partB.id);
+		ls.set_subgraph(vSep, numIds++);
+
+		vStack.push_back(NDSubgraph()); vStack.back().id = partB.id;
+		vStack.back().firstNew = partB.firstNew; vStack.back().vIndex.swap(partB.vIndex);
+		vStack.push_back(NDSubgraph()); vStack.back().id = partA.id;
+		vStack.back().firstNew = partA.firstNew; vStack.back().vIndex.swap(partA.vIndex);
+	}
+}
+
+} // end namespace ug
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__NESTED_DISSECTION__
+#define __H__UG__COMMON__NESTED_DISSECTION__
+
+#include <vector>
+#include <cstddef>
+
+namespace ug{
+
+/// returns an array describing the index mapping of a nested dissection ordering
+/**
+ * This function computes a fill-reducing ordering of a symmetric index graph
+ * by recursive (automatic) nested dissection: In every step a pseudo-peripheral
+ * index of the (sub-)graph is searched, the graph is split into levels by a
+ * breadth first search from this index and the middle level is used as
+ * separator. The two parts are ordered recursively before the separator.
+ * Subgraphs with at most minSize indices are not split further and keep their
+ * relative order. Disconnected parts are ordered one after the other.
+ *
+ * The adjacency must be symmetric, i.e. if j is a neighbor of i, then i must be
+ * a neighbor of j. Self references are ignored.
+ *
+ * On exit, the index field vNewIndex is filled with the index mapping:
+ * newInd = vNewIndex[oldInd]
+ *
+ * \param[out]	vNewIndex		vector returning new index for old index
+ * \param[in]	vvNeighbour		vector of adjacent indices for each index
+ * \param[in]	minSize			maximal size of subgraphs that are not split
+ */
+void ComputeNestedDissectionOrder(std::vector<size_t>& vNewIndex,
+                                  const std::vector<std::vector<size_t> >& vvNeighbour,
+                                  size_t minSize = 64);
+
+} // end namespace ug
+
+#endif /* __H__UG__COMMON__NESTED_DISSECTION__ */
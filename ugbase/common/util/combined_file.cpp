@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cstdio>
+#include <stdint.h>
+#include <vector>
+#include "combined_file.h"
+#include "common/error.h"
+
+namespace ug{
+
+void WriteCombinedFileSerial(BinaryBuffer& buf, const std::string& filename)
+{
+//	format, number of processes, 64 bit end offset of the data, data
+	FILE* f = fopen(filename.c_str(), "wb");
+	UG_COND_THROW(!f, "WriteCombinedFileSerial: Could not open '" << filename << "'.");
+
+	int header[2] = {COMBINED_FILE_FORMAT_OFFSET64, 1};
+	int64_t nextOffset = 2 * sizeof(int) + sizeof(int64_t) + (int64_t)buf.write_pos();
+	bool success = (fwrite(header, sizeof(int), 2, f) == 2)
+				&& (fwrite(&nextOffset, sizeof(int64_t), 1, f) == 1)
+				&& (fwrite(buf.buffer(), sizeof(char), buf.write_pos(), f) == buf.write_pos());
+	fclose(f);
+	UG_COND_THROW(!success, "WriteCombinedFileSerial: Could not write '" << filename << "'.");
+}
+
+void ReadCombinedFileSerial(BinaryBuffer& buf, const std::string& filename)
+{
+	FILE* f = fopen(filename.c_str(), "rb");
+	UG_COND_THROW(!f, "ReadCombinedFileSerial: Could not open '" << filename << "'.");
+
+//	files with int offsets start with the number of processes, files with
+//	64 bit offsets with the format tag
+	int header[2] = {0, 0};
+	bool success = (fread(header, sizeof(int), 2, f) == 2);
+
+	int numProcs = header[0];
+	int64_t begin = 2 * sizeof(int);
+	int64_t end = header[1];
+	if(success && header[0] == COMBINED_FILE_FORMAT_OFFSET64){
+		numProcs = header[1];
+		success = (numProcs != 1) || (fread(&end, sizeof(int64_t), 1, f) == 1);
+		begin += sizeof(int64_t);
+	}
+
+	if(!success || numProcs != 1 || end < begin){
+		fclose(f);
+		UG_COND_THROW(!success, "ReadCombinedFileSerial: Could not read header of '"
+					  << filename << "'.");
+		UG_COND_THROW(numProcs != 1, "ReadCombinedFileSerial: '" << filename
+					  << "' was written on " << numProcs << " processes, but is read"
+					  " by 1 process.");
+		UG_THROW("ReadCombinedFileSerial: Invalid header in '" << filename << "'.");
+	}
+
+//	the data of the only process directly follows the header
+	size_t size = (size_t)(end - begin);
+	std::vector<char> data(size);
+	success = (size == 0) || (fread(&data.front(), sizeof(char), size, f) == size);
+	fclose(f);
+	UG_COND_THROW(!success, "ReadCombinedFileSerial: Could not read '" << filename << "'.");
+
+	buf.clear();
+	buf.reserve(size);
+	if(size > 0)
+		buf.write(&data.front(), size);
+}
+
+}// end of namespace
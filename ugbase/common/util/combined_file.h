@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__UTIL__COMBINED_FILE__
+#define __H__UG__COMMON__UTIL__COMBINED_FILE__
+
+#include <string>
+#include "binary_buffer.h"
+
+namespace ug{
+
+///	first int of a combined parallel file with 64 bit offsets
+/**
+ * Combined parallel files (see pcl::WriteCombinedParallelFile) start with
+ * this format tag, the number of processes and the 64 bit end offsets of the
+ * data of each process. Files with int offsets start with the (positive)
+ * number of processes instead.
+ *
+ * The tag is defined here and not in pcl, since such files are also written
+ * and read in serial builds (checkpoints, partitioned grids).
+ */
+const int COMBINED_FILE_FORMAT_OFFSET64 = -2;
+
+///	writes a combined parallel file with the data of one process
+/**	The file has the layout of a file written by pcl::WriteCombinedParallelFile
+ * on one process. Throws an UGError if the file can not be written.*/
+void WriteCombinedFileSerial(BinaryBuffer& buf, const std::string& filename);
+
+///	reads a combined parallel file with the data of one process
+/**	Both the format with int offsets and the one with 64 bit offsets are
+ * read. Throws an UGError if the file can not be read or contains the data
+ * of more than one process.*/
+void ReadCombinedFileSerial(BinaryBuffer& buf, const std::string& filename);
+
+}// end of namespace
+
+#endif
@@ -32,6 +32,9 @@
 
 #ifndef __H__UG__CPU_ALGEBRA__CORE_SMOOTHERS__
 #define __H__UG__CPU_ALGEBRA__CORE_SMOOTHERS__
+
+#include "lib_algebra/cpu_algebra/algebra_misc.h"
+#include "level_schedule.h"
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace ug
@@ -200,6 +203,124 @@ void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const
 	gs_step_UR(A, c, c, relaxFactor);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	level scheduled gauss-seidel steps
+/**
+ * \brief Performs a forward gauss-seidel-step, processing the rows level by level.
+ * The result is identical to gs_step_LL, but all rows of one level of the
+ * schedule (computed by LevelSchedule::init_lower for A) are independent and
+ * processed thread-parallel if OpenMP is enabled.
+ *
+ * \param A Matrix \f$A = D - L - U\f$
+ * \param c Vector. \f$ c = N * d = (D-L)^{-1} * d \f$
+ * \param d Vector d.
+ * \param sched level schedule of the lower left part of A
+ * \sa gs_step_LL
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_LL(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                const LevelSchedule& sched)
+{
+	UG_ASSERT(sched.num_rows() == c.size(), "level schedule does not match vector size");
+	const size_t numLevels = sched.num_levels();
+
+#ifdef UG_OPENMP
+	#pragma omp parallel if(sched.parallel_worthwhile())
+#endif
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		const int begin = (int)sched.level_begin(lev), end = (int)sched.level_end(lev);
+#ifdef UG_OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for(int k = begin; k < end; ++k)
+		{
+			const size_t i = sched.row(k);
+			typename Vector_type::value_type s = d[i];
+
+			for(typename Matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i)
+			&& it.index() < i; ++it)
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+			InverseMatMult(c[i], relaxFactor, A(i,i), s);
+		}
+	}
+}
+
+/**
+ * \brief Performs a backward gauss-seidel-step, processing the rows level by level.
+ * The result is identical to gs_step_UR, but all rows of one level of the
+ * schedule (computed by LevelSchedule::init_upper for A) are independent and
+ * processed thread-parallel if OpenMP is enabled.
+ *
+ * \param A Matrix \f$A = D - L - U\f$
+ * \param c will be \f$c = N * d = (D-U)^{-1} * d \f$
+ * \param d the vector d.
+ * \param sched level schedule of the upper right part of A
+ * \sa gs_step_UR
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_UR(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                const LevelSchedule& sched)
+{
+	UG_ASSERT(sched.num_rows() == c.size(), "level schedule does not match vector size");
+	const size_t numLevels = sched.num_levels();
+
+#ifdef UG_OPENMP
+	#pragma omp parallel if(sched.parallel_worthwhile())
+#endif
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		const int begin = (int)sched.level_begin(lev), end = (int)sched.level_end(lev);
+#ifdef UG_OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for(int k = begin; k < end; ++k)
+		{
+			const size_t i = sched.row(k);
+			typename Vector_type::value_type s = d[i];
+			typename Matrix_type::const_row_iterator diag = A.get_connection(i, i);
+
+			typename Matrix_type::const_row_iterator it = diag; ++it;
+			for(; it != A.end_row(i); ++it)
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+			InverseMatMult(c[i], relaxFactor, diag.value(), s);
+		}
+	}
+}
+
+/**
+ * \brief Performs a symmetric gauss-seidel step with level scheduled sweeps.
+ * \param A Matrix \f$A = D - L - R\f$
+ * \param c will be \f$c = N * d = (D-U)^{-1} D (D-L)^{-1} d \f$
+ * \param d the vector d.
+ * \param lowerSched level schedule of the lower left part of A
+ * \param upperSched level schedule of the upper right part of A
+ * \sa sgs_step
+ */
+template<typename Matrix_type, typename Vector_type>
+void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+              const LevelSchedule& lowerSched, const LevelSchedule& upperSched)
+{
+	// c1 = (D-L)^{-1} d
+	gs_step_LL(A, c, d, relaxFactor, lowerSched);
+
+	// c2 = D c1
+	const int n = (int)c.size();
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(int i = 0; i < n; i++)
+	{
+		typename Vector_type::value_type s = c[i];
+		MatMult(c[i], 1.0, A(i, i), s);
+	}
+
+	// c3 = (D-U)^{-1} c2
+	gs_step_UR(A, c, c, relaxFactor, upperSched);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 //	diag_step
 /**
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__FUSED_REDUCTION__
+#define __H__UG__LIB_ALGEBRA__FUSED_REDUCTION__
+
+#include <vector>
+#include <cmath>
+#include "common/common.h"
+#include "common/error.h"
+#include "lib_algebra/algebra_common/multi_vector_ops.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl.h"
+#endif
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	sums several scalar products and squared norms over all processes at once
+/**
+ * The process-local parts of the added scalar products and squared norms
+ * are collected and summed up over all processes by one single allreduce,
+ * instead of one allreduce per value. The summation can be started
+ * non-blocking, so that local work (e.g. a preconditioner or a matrix-vector
+ * product) can be performed while the reduction is in progress.
+ *
+ * The local parts are computed by VecProdLocal and VecNormSquaredLocal. For
+ * parallel vectors those may change the storage type like dotprod() and
+ * norm() do; choose the storage types such that no communication is needed
+ * (additive <-> consistent or unique <-> unique for products, unique for
+ * norms).
+ *
+ * Usage:
+ * \code
+ * FusedReduction<vector_type> red;
+ * const size_t iRho = red.add_dotprod(r, z);
+ * const size_t iNorm = red.add_norm_squared(r);
+ * red.start();
+ * // ... local work ...
+ * red.finish();
+ * number rho = red.value(iRho), norm = red.norm(iNorm);
+ * \endcode
+ *
+ * \tparam	TVector		vector type
+ */
+template <typename TVector>
+class FusedReduction
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	public:
+		FusedReduction() : m_bPending(false)
+#ifdef UG_PARALLEL
+			, m_request(MPI_REQUEST_NULL)
+#endif
+		{}
+
+		~FusedReduction()
+		{
+			if(m_bPending) finish();
+		}
+
+	///	removes all values
+		void clear()
+		{
+			UG_COND_THROW(m_bPending, "FusedReduction: cannot clear while reduction pending.");
+			m_vLocal.clear();
+			m_vGlobal.clear();
+		}
+
+	///	adds the process-local part of (a,b) and returns the index of the value
+		size_t add_dotprod(vector_type& a, vector_type& b)
+		{
+			add_vector(a);
+			m_vLocal.push_back(VecProdLocal(a, b));
+			return m_vLocal.size() - 1;
+		}
+
+	///	adds the process-local parts of (v_i,w), i=0,...,n-1, and returns the index of the first value
+	/**
+	 * The products are computed in one sweep over the entries by
+	 * VecProdMultiLocal. No storage type is changed, thus w and the v_i must
+	 * be unique (or w additive and the v_i consistent).
+	 */
+		size_t add_dotprods(const std::vector<SmartPtr<vector_type> >& vV, size_t n,
+		                    vector_type& w)
+		{
+			add_vector(w);
+#ifdef UG_PARALLEL
+			for(size_t i = 0; i < n; ++i)
+			{
+				const bool bUnique = w.has_storage_type(PST_UNIQUE)
+										&& vV[i]->has_storage_type(PST_UNIQUE);
+				const bool bAddCons = w.has_storage_type(PST_ADDITIVE)
+										&& vV[i]->has_storage_type(PST_CONSISTENT);
+				UG_COND_THROW(!bUnique && !bAddCons, "FusedReduction::add_dotprods: "
+							"Inadequate storage format of vector "<<i<<".");
+			}
+#endif
+			const size_t first = m_vLocal.size();
+			m_vLocal.resize(first + n);
+			if(n > 0) VecProdMultiLocal(&m_vLocal[first], vV, n, w);
+			return first;
+		}
+
+	///	adds the process-local part of ||a||^2 and returns the index of the value
+		size_t add_norm_squared(vector_type& a)
+		{
+			add_vector(a);
+			m_vLocal.push_back(VecNormSquaredLocal(a));
+			return m_vLocal.size() - 1;
+		}
+
+	///	starts the summation of all added values (non-blocking if supported)
+		void start()
+		{
+			UG_COND_THROW(m_bPending, "FusedReduction: reduction already started.");
+			m_vGlobal.resize(m_vLocal.size());
+			if(m_vLocal.empty()) return;
+
+#ifdef UG_PARALLEL
+			if(!m_procComm.empty())
+			{
+				m_procComm.iallreduce(&m_vLocal[0], &m_vGlobal[0], (int)m_vLocal.size(),
+									  PCL_DT_DOUBLE, PCL_RO_SUM, m_request);
+				m_bPending = true;
+				return;
+			}
+#endif
+			m_vGlobal = m_vLocal;
+		}
+
+	///	waits until the summation started by start() is completed
+		void finish()
+		{
+#ifdef UG_PARALLEL
+			if(m_bPending) pcl::MPI_Wait(&m_request);
+#endif
+			m_bPending = false;
+		}
+
+	///	sums all added values (blocking)
+		void reduce() {start(); finish();}
+
+	///	returns if a started summation has not been finished yet
+		bool pending() const {return m_bPending;}
+
+	///	number of added values
+		size_t size() const {return m_vLocal.size();}
+
+	///	returns the summed value i (valid after finish())
+		number value(size_t i) const
+		{
+			UG_ASSERT(!m_bPending && i < m_vGlobal.size(), "FusedReduction: value "<<i<<" not available.");
+			return m_vGlobal[i];
+		}
+
+	///	returns the square root of the summed value i (for norms added by add_norm_squared)
+		number norm(size_t i) const {return std::sqrt(value(i));}
+
+	protected:
+	///	remembers the communicator of the vectors
+		void add_vector(vector_type& a)
+		{
+			UG_COND_THROW(m_bPending, "FusedReduction: cannot add values while reduction pending.");
+#ifdef UG_PARALLEL
+			if(m_vLocal.empty())
+				m_procComm = a.layouts()->proc_comm();
+#endif
+		}
+
+	protected:
+	///	process-local and summed values
+		std::vector<double> m_vLocal;
+		std::vector<double> m_vGlobal;
+
+	///	flag if a non-blocking summation is in progress
+		bool m_bPending;
+
+#ifdef UG_PARALLEL
+	///	communicator of the vectors and request of the running summation
+		pcl::ProcessCommunicator m_procComm;
+		MPI_Request m_request;
+#endif
+};
+
+// end group lib_algebra
+///	@}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__FUSED_REDUCTION__ */
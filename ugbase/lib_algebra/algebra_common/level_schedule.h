@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__LEVEL_SCHEDULE__
+#define __H__UG__CPU_ALGEBRA__LEVEL_SCHEDULE__
+
+#include <vector>
+#include <algorithm>
+
+namespace ug
+{
+
+/// \addtogroup lib_algebra
+///	@{
+
+#ifdef UG_OPENMP
+//! minimal mean number of rows per level for which a level scheduled
+//! triangular sweep is executed thread-parallel. Below, the synchronization
+//! after each level costs more than the work that is distributed.
+#define UG_LEVEL_SCHEDULE_OMP_MIN_ROWS_PER_LEVEL 64
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	LevelSchedule
+/**
+ * \brief Partitions the rows of a sparse triangular system into independent levels.
+ *
+ * A row i of the lower (resp. upper) triangular part of a matrix A only depends on
+ * the rows j < i (resp. j > i) with A(i,j) != 0. The level of a row is one more
+ * than the maximal level of the rows it depends on, so that all rows of the same
+ * level can be processed concurrently, once all previous levels are done.
+ * Processing the rows level by level computes exactly the same values as the
+ * sequential forward (resp. backward) substitution, since every row still sees
+ * the final values of all the rows it depends on.
+ *
+ * The rows are stored level by level, within a level in ascending order.
+ */
+class LevelSchedule
+{
+	public:
+		LevelSchedule() {}
+
+	///	computes the levels for the forward substitution with the lower left part of A
+		template<typename TMatrix>
+		void init_lower(const TMatrix& A)
+		{
+			const size_t n = A.num_rows();
+			std::vector<size_t> vLevel(n, 0);
+			for(size_t i = 0; i < n; ++i)
+			{
+				size_t lev = 0;
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it)
+					if(it.index() < i)
+						lev = std::max(lev, vLevel[it.index()] + 1);
+				vLevel[i] = lev;
+			}
+			sort_rows_by_level(vLevel);
+		}
+
+	///	computes the levels for the backward substitution with the upper right part of A
+		template<typename TMatrix>
+		void init_upper(const TMatrix& A)
+		{
+			const size_t n = A.num_rows();
+			std::vector<size_t> vLevel(n, 0);
+			for(size_t i = n; i-- != 0; )
+			{
+				size_t lev = 0;
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it)
+					if(it.index() > i)
+						lev = std::max(lev, vLevel[it.index()] + 1);
+				vLevel[i] = lev;
+			}
+			sort_rows_by_level(vLevel);
+		}
+
+	///	removes the schedule
+		void clear()
+		{
+			m_vRow.clear();
+			m_vLevelStart.clear();
+		}
+
+	///	number of rows the schedule has been computed for
+		size_t num_rows() const {return m_vRow.size();}
+
+	///	number of levels
+		size_t num_levels() const {return m_vLevelStart.empty() ? 0 : m_vLevelStart.size() - 1;}
+
+	///	first position of level lev in the row list
+		size_t level_begin(size_t lev) const {return m_vLevelStart[lev];}
+
+	///	end position of level lev in the row list
+		size_t level_end(size_t lev) const {return m_vLevelStart[lev+1];}
+
+	///	row at position k of the row list
+		size_t row(size_t k) const {return m_vRow[k];}
+
+	///	returns if the levels are wide enough to be processed thread-parallel
+		bool parallel_worthwhile() const
+		{
+#ifdef UG_OPENMP
+			return num_levels() > 0
+				&& num_rows() >= UG_LEVEL_SCHEDULE_OMP_MIN_ROWS_PER_LEVEL * num_levels();
+#else
+			return false;
+#endif
+		}
+
+	protected:
+	///	bucket sort of the rows by their level
+		void sort_rows_by_level(const std::vector<size_t>& vLevel)
+		{
+			const size_t n = vLevel.size();
+			size_t numLevel = 0;
+			for(size_t i = 0; i < n; ++i)
+				numLevel = std::max(numLevel, vLevel[i] + 1);
+
+			m_vLevelStart.assign(numLevel + 1, 0);
+			for(size_t i = 0; i < n; ++i)
+				m_vLevelStart[vLevel[i] + 1]++;
+			for(size_t lev = 0; lev < numLevel; ++lev)
+				m_vLevelStart[lev+1] += m_vLevelStart[lev];
+
+			std::vector<size_t> vPos(m_vLevelStart.begin(), m_vLevelStart.end() - 1);
+			m_vRow.resize(n);
+			for(size_t i = 0; i < n; ++i)
+				m_vRow[vPos[vLevel[i]]++] = i;
+		}
+
+	protected:
+	///	rows ordered by level
+		std::vector<size_t> m_vRow;
+
+	///	start of each level in m_vRow (plus end of the last level)
+		std::vector<size_t> m_vLevelStart;
+};
+
+// end group lib_algebra
+///	@}
+
+} // end namespace ug
+
+#endif // __H__UG__CPU_ALGEBRA__LEVEL_SCHEDULE__
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__MULTI_VECTOR_OPS__
+#define __H__UG__LIB_ALGEBRA__MULTI_VECTOR_OPS__
+
+#include <vector>
+#include <algorithm>
+#include "common/common.h"
+#include "common/util/smart_pointer.h"
+#include "lib_algebra/cpu_algebra/algebra_misc.h"
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	number of vector entries processed at once by the multi-vector kernels
+/**
+ * The entries of a vector set are traversed in chunks of this size, such that
+ * the chunk of the single vector w stays in cache while all vectors of the
+ * set are processed. Thus w is only read (and written) once from memory.
+ */
+#define UG_MULTI_VECTOR_CHUNK_SIZE 256
+
+///	computes the process-local parts of (v_i, w) for i = 0,...,n-1 in one sweep
+/**
+ * The entries are accessed directly, i.e. no parallel storage type is
+ * changed. The caller has to ensure that the storage types of w and the v_i
+ * allow a local computation (e.g. all unique).
+ *
+ * \param[out]	res		array of size n, res[i] = local part of (v_i, w)
+ * \param[in]	vV		vector set
+ * \param[in]	n		number of vectors of the set to be used
+ * \param[in]	w		vector
+ */
+template <typename TVector>
+void VecProdMultiLocal(double* res, const std::vector<SmartPtr<TVector> >& vV,
+                       size_t n, const TVector& w)
+{
+	UG_ASSERT(n <= vV.size(), "VecProdMultiLocal: only "<<vV.size()<<" vectors given.");
+	const size_t size = w.size();
+	const size_t numChunks = (size + UG_MULTI_VECTOR_CHUNK_SIZE - 1) / UG_MULTI_VECTOR_CHUNK_SIZE;
+
+	for(size_t i = 0; i < n; ++i) res[i] = 0.0;
+
+#ifdef UG_OPENMP
+	#pragma omp parallel if(size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	{
+	//	thread-local sums
+		std::vector<double> vSum(n, 0.0);
+
+#ifdef UG_OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for(size_t c = 0; c < numChunks; ++c)
+		{
+			const size_t begin = c * UG_MULTI_VECTOR_CHUNK_SIZE;
+			const size_t end = std::min(begin + UG_MULTI_VECTOR_CHUNK_SIZE, size);
+
+			for(size_t i = 0; i < n; ++i)
+			{
+				const TVector& v = *vV[i];
+				double sum = 0.0;
+				for(size_t k = begin; k < end; ++k)
+					sum += VecProd(v[k], w[k]);
+				vSum[i] += sum;
+			}
+		}
+
+#ifdef UG_OPENMP
+		#pragma omp critical
+#endif
+		for(size_t i = 0; i < n; ++i) res[i] += vSum[i];
+	}
+}
+
+///	computes w := w + sum_i alpha_i * v_i for i = 0,...,n-1 in one sweep
+/**
+ * The entries are accessed directly, i.e. no parallel storage type is
+ * changed. The caller has to ensure that w and the v_i have the same storage
+ * type (e.g. all unique).
+ *
+ * \param[in,out]	w		vector
+ * \param[in]		vV		vector set
+ * \param[in]		n		number of vectors of the set to be used
+ * \param[in]		alpha	array of size n, scaling factors
+ */
+template <typename TVector>
+void VecScaleAppendMulti(TVector& w, const std::vector<SmartPtr<TVector> >& vV,
+                         size_t n, const number* alpha)
+{
+	UG_ASSERT(n <= vV.size(), "VecScaleAppendMulti: only "<<vV.size()<<" vectors given.");
+	const size_t size = w.size();
+	const size_t numChunks = (size + UG_MULTI_VECTOR_CHUNK_SIZE - 1) / UG_MULTI_VECTOR_CHUNK_SIZE;
+
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t c = 0; c < numChunks; ++c)
+	{
+		const size_t begin = c * UG_MULTI_VECTOR_CHUNK_SIZE;
+		const size_t end = std::min(begin + UG_MULTI_VECTOR_CHUNK_SIZE, size);
+
+		for(size_t i = 0; i < n; ++i)
+		{
+			const TVector& v = *vV[i];
+			const number a = alpha[i];
+			for(size_t k = begin; k < end; ++k)
+				VecScaleAdd(w[k], 1.0, w[k], a, v[k]);
+		}
+	}
+}
+
+// end group lib_algebra
+///	@}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__MULTI_VECTOR_OPS__ */
@@ -51,6 +51,13 @@ namespace ug
 //! prevent unused variable-warnings
 #define UNUSED_VARIABLE(var) ((void) var);
 
+#ifdef UG_OPENMP
+//! minimal number of vector entries / matrix rows for which the cpu algebra
+//! kernels are executed thread-parallel. All kernels use a static schedule,
+//! so that the same thread always works on the same part of a vector.
+#define UG_CPU_ALGEBRA_OMP_MIN_SIZE 4096
+#endif
+
 
 //!
 //! template struct for sorting some keys after values
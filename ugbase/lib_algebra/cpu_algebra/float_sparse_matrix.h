@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__FLOAT_SPARSE_MATRIX__
+#define __H__UG__CPU_ALGEBRA__FLOAT_SPARSE_MATRIX__
+
+#include <vector>
+#include "common/common.h"
+#include "../small_algebra/small_algebra.h"
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+/// \{
+
+/**
+ * Read-only copy of a sparse matrix with the entries stored in single
+ * precision. It is meant for preconditioners whose application is bound by
+ * the memory bandwidth (e.g. the triangular solves of an ILU): The entries
+ * are read as float, but all products are accumulated in double precision
+ * into the (double precision) vectors, so that only the precision of the
+ * operator is reduced, not the one of the iteration.
+ *
+ * Only matrices with blocks of static size (double or fixed block sizes) are
+ * supported. The entries of a block are stored row-wise, the columns of a row
+ * are sorted ascending.
+ *
+ * \tparam TValue	block type of the (double precision) matrix
+ */
+template<typename TValue>
+class FloatSparseMatrix
+{
+public:
+	typedef TValue value_type;
+
+	enum { blockRows = block_traits<TValue>::static_num_rows };
+	enum { blockCols = block_traits<TValue>::static_num_cols };
+	enum { blockSize = blockRows * blockCols };
+
+	FloatSparseMatrix() {}
+
+	//! returns if the block type can be stored in single precision
+	static bool supported() { return block_traits<TValue>::is_static; }
+
+	//! copies a matrix (must provide num_rows and sorted row iterators)
+	template<typename TMatrix>
+	void build(const TMatrix &A);
+
+	//! frees the memory
+	void clear();
+
+	size_t num_rows() const { return m_vLowerEnd.size(); }
+	size_t total_num_connections() const { return m_vCol.size(); }
+
+	//! first entry of row i
+	size_t row_begin(size_t i) const { return m_vRowStart[i]; }
+	//! end of row i
+	size_t row_end(size_t i) const { return m_vRowStart[i+1]; }
+	//! end of the lower part of row i (first entry with column >= i)
+	size_t lower_end(size_t i) const { return m_vLowerEnd[i]; }
+	//! start of the upper part of row i (first entry with column > i)
+	size_t upper_begin(size_t i) const { return has_diag(i) ? m_vLowerEnd[i] + 1 : m_vLowerEnd[i]; }
+	//! returns if row i has a diagonal entry (at position lower_end(i))
+	bool has_diag(size_t i) const
+	{
+		return m_vLowerEnd[i] < m_vRowStart[i+1] && m_vCol[m_vLowerEnd[i]] == (int)i;
+	}
+
+	//! column of the k'th entry
+	size_t col(size_t k) const { return m_vCol[k]; }
+
+	//! copies the k'th entry to a block of double precision
+	void get_block(value_type &b, size_t k) const
+	{
+		const float *a = &m_vValue[k * blockSize];
+		for(size_t r = 0; r < (size_t)blockRows; ++r)
+			for(size_t c = 0; c < (size_t)blockCols; ++c)
+				BlockRef(b, r, c) = a[r * blockCols + c];
+	}
+
+	//! calculates s -= sum_{k=begin}^{end-1} A_k * x[col(k)]
+	template<typename TVecValue, typename TVector>
+	void sub_mult(TVecValue &s, size_t begin, size_t end, const TVector &x) const
+	{
+		for(size_t k = begin; k < end; ++k)
+		{
+			const float *a = &m_vValue[k * blockSize];
+			const typename TVector::value_type &xj = x[m_vCol[k]];
+			for(size_t r = 0; r < (size_t)blockRows; ++r)
+			{
+				double sum = 0.0;
+				for(size_t c = 0; c < (size_t)blockCols; ++c)
+					sum += a[r * blockCols + c] * BlockRef(xj, c);
+				BlockRef(s, r) -= sum;
+			}
+		}
+	}
+
+private:
+	//! start of row i in m_vCol (size: numRows+1)
+	std::vector<size_t> m_vRowStart;
+
+	//! end of the lower part of each row
+	std::vector<size_t> m_vLowerEnd;
+
+	//! column indices
+	std::vector<int> m_vCol;
+
+	//! entries, blockSize floats per connection
+	std::vector<float> m_vValue;
+};
+
+template<typename TValue>
+template<typename TMatrix>
+void FloatSparseMatrix<TValue>::build(const TMatrix &A)
+{
+	typedef typename TMatrix::const_row_iterator const_row_iterator;
+	UG_COND_THROW(!supported(), "FloatSparseMatrix: only blocks of static size "
+	              "can be stored in single precision.");
+
+	const size_t n = A.num_rows();
+	m_vRowStart.resize(n + 1);
+	m_vLowerEnd.resize(n);
+	m_vRowStart[0] = 0;
+	for(size_t i = 0; i < n; ++i)
+		m_vRowStart[i+1] = m_vRowStart[i] + A.num_connections(i);
+
+	m_vCol.resize(m_vRowStart[n]);
+	m_vValue.resize(m_vRowStart[n] * blockSize);
+
+	for(size_t i = 0; i < n; ++i)
+	{
+		size_t k = m_vRowStart[i];
+		m_vLowerEnd[i] = m_vRowStart[i+1];
+		for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it, ++k)
+		{
+			const size_t j = it.index();
+			UG_ASSERT(k == m_vRowStart[i] || (size_t)m_vCol[k-1] < j,
+			          "FloatSparseMatrix: rows must be sorted");
+			if(j >= i && m_vLowerEnd[i] == m_vRowStart[i+1]) m_vLowerEnd[i] = k;
+
+			m_vCol[k] = j;
+			float *a = &m_vValue[k * blockSize];
+			for(size_t r = 0; r < (size_t)blockRows; ++r)
+				for(size_t c = 0; c < (size_t)blockCols; ++c)
+					a[r * blockCols + c] = (float) BlockRef(it.value(), r, c);
+		}
+	}
+}
+
+template<typename TValue>
+void FloatSparseMatrix<TValue>::clear()
+{
+	std::vector<size_t>().swap(m_vRowStart);
+	std::vector<size_t>().swap(m_vLowerEnd);
+	std::vector<int>().swap(m_vCol);
+	std::vector<float>().swap(m_vValue);
+}
+
+// end group lib_algebra
+/// \}
+
+} // end namespace ug
+
+#endif // __H__UG__CPU_ALGEBRA__FLOAT_SPARSE_MATRIX__
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__CPU_ALGEBRA__SPARSE_TRIPLE_PRODUCT__
+#define __H__UG__LIB_ALGEBRA__CPU_ALGEBRA__SPARSE_TRIPLE_PRODUCT__
+
+#include <vector>
+#include <algorithm>
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+#include "algebra_misc.h"
+#include "sparsematrix.h"
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	sparse triple product M += A*B*C with a reusable symbolic phase
+/**
+ * The product is computed in two phases:
+ * - symbolic: the sparsity pattern of A*B*C is computed (sorted rows).
+ * - numeric: the values of A*B*C are accumulated row-wise directly into the
+ *   positions of this pattern. No row has to be searched or sorted.
+ *
+ * Both phases are executed thread-parallel over the rows of A (if compiled
+ * with UG_OPENMP). The patterns of A, B and C are remembered, such that the
+ * symbolic phase is only recomputed if one of them changed. This is the case
+ * for Galerkin products R*A*P in multigrid methods, where the transfer
+ * operators and the pattern of A stay the same while A changes, e.g. in
+ * nonlinear or time dependent problems.
+ *
+ * The product is added to M. If M already contains all entries of the
+ * pattern (e.g. M has been reset by M.set(0.0) after a previous product),
+ * the values are added in place, otherwise the missing entries are created.
+ *
+ * \tparam	TMatrix		SparseMatrix or a type derived from it (e.g. ParallelMatrix)
+ */
+template <typename TMatrix>
+class SparseTripleProduct
+{
+	public:
+		typedef typename TMatrix::value_type value_type;
+		typedef SparseMatrix<value_type> sparse_matrix_type;
+
+	public:
+		SparseTripleProduct() : m_bSymbolic(false) {}
+
+	///	computes M += A*B*C, the symbolic phase is reused if no pattern changed
+		void add_multiply_of(TMatrix& M, const TMatrix& A, const TMatrix& B, const TMatrix& C)
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			UG_COND_THROW(C.num_rows() != B.num_cols() || B.num_rows() != A.num_cols(),
+			              "SparseTripleProduct: sizes of A, B, C do not match.");
+			UG_COND_THROW(M.num_rows() != A.num_rows() || M.num_cols() != C.num_cols(),
+			              "SparseTripleProduct: size of M does not match, M is "
+			              << M.num_rows() << "x" << M.num_cols() << ", A*B*C is "
+			              << A.num_rows() << "x" << C.num_cols());
+
+		//	all three patterns are compared
+			bool bSame = update_pattern(m_patA, A);
+			bSame = update_pattern(m_patB, B) && bSame;
+			bSame = update_pattern(m_patC, C) && bSame;
+
+			if(!bSame || !m_bSymbolic) symbolic();
+			numeric(A, B, C);
+			add_to(M);
+		}
+
+	///	forces a new symbolic phase in the next product
+		void clear() {m_bSymbolic = false;}
+
+	protected:
+	///	sparsity pattern of a matrix (row i: vCol[vRowStart[i]], ..., vCol[vRowStart[i+1]-1])
+		struct Pattern
+		{
+			Pattern() : numCols(0) {}
+			size_t num_rows() const {return vRowStart.empty() ? 0 : vRowStart.size() - 1;}
+
+			size_t numCols;
+			std::vector<size_t> vRowStart;
+			std::vector<int> vCol;
+		};
+
+	///	stores the pattern of mat, returns true if it has not changed
+		static bool update_pattern(Pattern& pat, const sparse_matrix_type& mat)
+		{
+			const size_t n = mat.num_rows();
+
+			if(pat.vRowStart.size() == n + 1 && pat.numCols == mat.num_cols())
+			{
+				bool bSame = true;
+				for(size_t i = 0; i < n && bSame; ++i)
+				{
+					const int start = mat.rowStart[i], end = mat.rowEnd[i];
+					if(end - start != (int)(pat.vRowStart[i+1] - pat.vRowStart[i]))
+						bSame = false;
+					else if(end > start)
+						bSame = std::equal(mat.cols.begin() + start, mat.cols.begin() + end,
+						                   pat.vCol.begin() + pat.vRowStart[i]);
+				}
+				if(bSame) return true;
+			}
+
+			pat.numCols = mat.num_cols();
+			pat.vRowStart.resize(n + 1);
+			pat.vCol.clear();
+			pat.vRowStart[0] = 0;
+			for(size_t i = 0; i < n; ++i)
+			{
+				if(mat.rowEnd[i] > mat.rowStart[i])
+					pat.vCol.insert(pat.vCol.end(), mat.cols.begin() + mat.rowStart[i],
+					                mat.cols.begin() + mat.rowEnd[i]);
+				pat.vRowStart[i+1] = pat.vCol.size();
+			}
+			return false;
+		}
+
+	///	computes the pattern of A*B*C
+		void symbolic()
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			const Pattern& A = m_patA;
+			const Pattern& B = m_patB;
+			const Pattern& C = m_patC;
+			const size_t n = A.num_rows();
+			m_vRowStart.assign(n + 1, 0);
+
+		//	count the entries of each row
+#ifdef UG_OPENMP
+			#pragma omp parallel if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+			{
+				std::vector<size_t> vMark(C.numCols, n);
+#ifdef UG_OPENMP
+				#pragma omp for schedule(static)
+#endif
+				for(size_t i = 0; i < n; ++i)
+				{
+					size_t cnt = 0;
+					for(size_t a = A.vRowStart[i]; a < A.vRowStart[i+1]; ++a)
+					{
+						const size_t k = A.vCol[a];
+						for(size_t b = B.vRowStart[k]; b < B.vRowStart[k+1]; ++b)
+						{
+							const size_t l = B.vCol[b];
+							for(size_t c = C.vRowStart[l]; c < C.vRowStart[l+1]; ++c)
+							{
+								const size_t j = C.vCol[c];
+								if(vMark[j] != i) {vMark[j] = i; ++cnt;}
+							}
+						}
+					}
+					m_vRowStart[i+1] = cnt;
+				}
+			}
+
+			for(size_t i = 0; i < n; ++i)
+				m_vRowStart[i+1] += m_vRowStart[i];
+			m_vCol.resize(m_vRowStart[n]);
+
+		//	fill and sort the rows
+#ifdef UG_OPENMP
+			#pragma omp parallel if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+			{
+				std::vector<size_t> vMark(C.numCols, n);
+#ifdef UG_OPENMP
+				#pragma omp for schedule(static)
+#endif
+				for(size_t i = 0; i < n; ++i)
+				{
+					size_t pos = m_vRowStart[i];
+					for(size_t a = A.vRowStart[i]; a < A.vRowStart[i+1]; ++a)
+					{
+						const size_t k = A.vCol[a];
+						for(size_t b = B.vRowStart[k]; b < B.vRowStart[k+1]; ++b)
+						{
+							const size_t l = B.vCol[b];
+							for(size_t c = C.vRowStart[l]; c < C.vRowStart[l+1]; ++c)
+							{
+								const size_t j = C.vCol[c];
+								if(vMark[j] != i) {vMark[j] = i; m_vCol[pos++] = j;}
+							}
+						}
+					}
+					std::sort(m_vCol.begin() + m_vRowStart[i], m_vCol.begin() + pos);
+				}
+			}
+
+			m_vValue.resize(m_vCol.size());
+			m_bSymbolic = true;
+		}
+
+	///	computes the values of A*B*C in the pattern computed by symbolic()
+		void numeric(const sparse_matrix_type& A, const sparse_matrix_type& B,
+		             const sparse_matrix_type& C)
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			typedef typename block_multiply_traits<value_type, value_type>::ReturnType ab_type;
+			const size_t n = A.num_rows();
+
+		//	blocks of static size can be reset before the accumulation, others
+		//	are sized by the first contribution
+			const bool bStatic = block_traits<value_type>::is_static;
+
+#ifdef UG_OPENMP
+			#pragma omp parallel if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+			{
+			//	position of column j in the current row and flag for first contribution
+				std::vector<size_t> vPos(C.num_cols());
+				std::vector<char> vFirst(C.num_cols(), 0);
+				ab_type ab;
+
+#ifdef UG_OPENMP
+				#pragma omp for schedule(static)
+#endif
+				for(size_t i = 0; i < n; ++i)
+				{
+					for(size_t p = m_vRowStart[i]; p < m_vRowStart[i+1]; ++p)
+					{
+						vPos[m_vCol[p]] = p;
+						if(bStatic) m_vValue[p] = 0.0;
+						else vFirst[m_vCol[p]] = 1;
+					}
+
+				// 	M_ij = \sum_kl A_ik * B_kl * C_lj
+					for(int a = A.rowStart[i]; a < A.rowEnd[i]; ++a)
+					{
+						const size_t k = A.cols[a];
+						for(int b = B.rowStart[k]; b < B.rowEnd[k]; ++b)
+						{
+							AssignMult(ab, A.values[a], B.values[b]);
+
+							const size_t l = B.cols[b];
+							for(int c = C.rowStart[l]; c < C.rowEnd[l]; ++c)
+							{
+								const size_t j = C.cols[c];
+								value_type& m = m_vValue[vPos[j]];
+								if(bStatic || !vFirst[j]) AddMult(m, ab, C.values[c]);
+								else {AssignMult(m, ab, C.values[c]); vFirst[j] = 0;}
+							}
+						}
+					}
+				}
+			}
+		}
+
+	///	adds the computed product to M
+		void add_to(TMatrix& M) const
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			typedef typename TMatrix::row_iterator row_iterator;
+			std::vector<size_t> vMissing;
+
+			for(size_t i = 0; i < M.num_rows(); ++i)
+			{
+				vMissing.clear();
+
+			//	add to existing entries (both rows are sorted)
+				{
+					row_iterator it = M.begin_row(i);
+					row_iterator itEnd = M.end_row(i);
+					for(size_t p = m_vRowStart[i]; p < m_vRowStart[i+1]; ++p)
+					{
+						const size_t j = m_vCol[p];
+						while(it != itEnd && it.index() < j) ++it;
+						if(it != itEnd && it.index() == j) it.value() += m_vValue[p];
+						else vMissing.push_back(p);
+					}
+				}
+
+			//	create missing entries
+				for(size_t k = 0; k < vMissing.size(); ++k)
+					M(i, m_vCol[vMissing[k]]) += m_vValue[vMissing[k]];
+			}
+		}
+
+	protected:
+	///	patterns of the factors
+		Pattern m_patA, m_patB, m_patC;
+
+	///	flag if the pattern of the product is computed for the current factors
+		bool m_bSymbolic;
+
+	///	pattern and values of the product A*B*C
+		std::vector<size_t> m_vRowStart;
+		std::vector<size_t> m_vCol;
+		std::vector<value_type> m_vValue;
+};
+
+/// @}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__CPU_ALGEBRA__SPARSE_TRIPLE_PRODUCT__ */
@@ -43,6 +43,7 @@
 #include "../algebra_common/connection.h"
 #include "../algebra_common/matrixrow.h"
 #include "../common/operations_mat/operations_mat.h"
+#include "sparsematrix_sell.h"
 
 #define PROFILE_SPMATRIX(name) PROFILE_BEGIN_GROUP(name, "SparseMatrix algebra")
 
@@ -82,6 +83,8 @@ namespace ug{
 // cols : 2 3 5 6 | 2 3 6 7 | 8 9 10
 
 
+template<typename TMatrix> class SparseTripleProduct;
+
 /** SparseMatrix
  *  \brief sparse matrix for big, variable sparse matrices.
  *
@@ -167,6 +170,16 @@ public:
 	void apply_ignore_zero_rows(vector_t &dest,
 			const number &beta1, const vector_t &w1) const;
 
+	//! calculates dest[i] = (A*w1)[i] for the rows firstRow <= i < lastRow that have no connection
+	//! to an index j with vMark[j] != 0. For the other rows, vSkipped[i] = 1 and dest[i] is not changed.
+	template<typename vector_t>
+	void apply_unmarked_rows(vector_t &dest, const vector_t &w1, const std::vector<char> &vMark,
+			std::vector<char> &vSkipped, size_t firstRow, size_t lastRow) const;
+
+	//! calculates dest[i] = (A*w1)[i] for the rows with vSkipped[i] != 0
+	template<typename vector_t>
+	void apply_skipped_rows(vector_t &dest, const vector_t &w1, const std::vector<char> &vSkipped) const;
+
 	//! calculated dest = beta1*A*w1 . For empty cols of A (=empty rows of A^T), dest will not be changed
 	template<typename vector_t>
 	void apply_transposed_ignore_zero_rows(vector_t &dest,
@@ -292,6 +305,62 @@ public:
         return values[j];
     }
 
+	/** position (size_t r, size_t c)
+	 * returns the storage position of connection (r, c)
+	 * \param r row
+	 * \param c column
+	 * \note (r,c) is added to sparsity pattern if not already there.
+	 * The position stays valid as long as the sparsity pattern is not changed,
+	 * use is_position_of to check this.
+	 * \return position of (r,c) to be used with value_at
+	 */
+	int position(size_t r, size_t c)
+	{
+		check_rc(r, c);
+		return get_index(r, c);
+	}
+
+	//! returns if pos is the (current) storage position of connection (r, c)
+	bool is_position_of(int pos, size_t r, size_t c) const
+	{
+		return pos >= 0 && pos >= rowStart[r] && pos < rowEnd[r] && cols[pos] == (int)c;
+	}
+
+	//! access the connection stored at position pos
+	value_type &value_at(int pos)
+	{
+		UG_ASSERT(pos >= 0 && pos < maxValues, "invalid position " << pos);
+		invalidate_spmv_format();
+		return values[pos];
+	}
+
+	//! access the connection stored at position pos without marking the
+	//! SELL-C-sigma copy as outdated. Distinct positions may be accessed by
+	//! several threads at once, values_changed() must be called afterwards.
+	value_type &value_at_concurrent(int pos)
+	{
+		UG_ASSERT(pos >= 0 && pos < maxValues, "invalid position " << pos);
+		return values[pos];
+	}
+
+	//! marks the values as changed (needed after value_at_concurrent)
+	void values_changed() {invalidate_spmv_format();}
+
+	//! tags the sparsity pattern, e.g. with the revision of the DoFDistribution
+	//! it has been built for. The tag is reset by resize_and_clear and
+	//! resize_and_keep_values.
+	void set_pattern_tag(const void* pObj, uint64 cnt)
+	{
+		m_pPatternTagObj = pObj;
+		m_patternTagCnt = cnt;
+	}
+
+	//! returns if the sparsity pattern has been tagged with the given tag since its last rebuild
+	bool has_pattern_tag(const void* pObj, uint64 cnt) const
+	{
+		return pObj != NULL && m_pPatternTagObj == pObj && m_patternTagCnt == cnt;
+	}
+
 public:
 	// row functions
 
@@ -363,8 +432,8 @@ public:
         size_t i;
     public:
         inline void check() const {A.check_row(row, i); }
-        row_iterator(SparseMatrix &_A, size_t _row, size_t _i) : A(_A), row(_row), i(_i) { A.add_iterator(row); }
-        row_iterator(const row_iterator &other) : A(other.A), row(other.row), i(other.i) { A.add_iterator(row); }
+        row_iterator(SparseMatrix &_A, size_t _row, size_t _i) : A(_A), row(_row), i(_i) { A.add_iterator(row); A.invalidate_spmv_format(); }
+        row_iterator(const row_iterator &other) : A(other.A), row(other.row), i(other.i) { A.add_iterator(row); A.invalidate_spmv_format(); }
         ~row_iterator() { A.remove_iterator(row); }
         row_iterator *operator ->() { return this; }
         value_type &value() { check(); return A.values[i];   }
@@ -578,6 +647,10 @@ public:
 
 
 
+private:
+	// the triple product works directly on the row arrays of its factors
+	template<typename TMatrix> friend class SparseTripleProduct;
+
 private:
 	// private functions
 
@@ -602,6 +675,16 @@ private:
 	{
 		UG_ASSERT(i < rowEnd[row] && i >= rowStart[row], "row iterator row " << row << " pos " << i << " out of bounds [" << rowStart[row] << ", " << rowEnd[row] << "]");
 	}
+
+	//! marks the SELL-C-sigma copy as outdated, called on every non-const access
+	void invalidate_spmv_format()
+	{
+		m_sell.invalidate();
+		m_sellApplyCnt = 0;
+	}
+
+	//! returns if the SELL-C-sigma copy is used for the matrix-vector product (builds it if needed)
+	bool use_spmv_format() const;
     void assureValuesSize(size_t s);
     size_t get_nnz() const { return nnz; }
 
@@ -638,6 +721,15 @@ protected:
     int m_numCols;
     mutable int iIterators;
 
+    //! read-only copy in SELL-C-sigma format used for matrix-vector products
+    mutable SellCSigmaStorage<value_type> m_sell;
+    //! number of matrix-vector products since the last change of the matrix
+    mutable int m_sellApplyCnt;
+
+    //! tag of the sparsity pattern (see set_pattern_tag)
+    const void* m_pPatternTagObj;
+    uint64 m_patternTagCnt;
+
 #ifdef CHECK_ROW_ITERATORS
 public:
     mutable std::vector<int> nrOfRowIterators;
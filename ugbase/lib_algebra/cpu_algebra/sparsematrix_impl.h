@@ -41,6 +41,7 @@
 #include "lib_algebra/common/operations_vec.h"
 #include "common/profiler/profiler.h"
 #include "sparsematrix.h"
+#include "algebra_misc.h"
 #include <vector>
 #include <algorithm>
 
@@ -57,6 +58,9 @@ SparseMatrix<T>::SparseMatrix()
 	nnz = 0;
 	m_numCols = 0;
 	maxValues = 0;
+	m_sellApplyCnt = 0;
+	m_pPatternTagObj = NULL;
+	m_patternTagCnt = 0;
 	cols.resize(32);
 	if(bNeedsValues) values.resize(32);
 }
@@ -65,6 +69,8 @@ template<typename T>
 void SparseMatrix<T>::resize_and_clear(size_t newRows, size_t newCols)
 {
 	PROFILE_SPMATRIX(SparseMatrix_resize_and_clear);
+	invalidate_spmv_format();
+	set_pattern_tag(NULL, 0);
 	rowStart.clear(); rowStart.resize(newRows+1, -1);
 	rowMax.clear(); rowMax.resize(newRows);
 	rowEnd.clear(); rowEnd.resize(newRows, -1);
@@ -86,6 +92,8 @@ template<typename T>
 void SparseMatrix<T>::resize_and_keep_values(size_t newRows, size_t newCols)
 {
 	PROFILE_SPMATRIX(SparseMatrix_resize_and_keep_values);
+	invalidate_spmv_format();
+	set_pattern_tag(NULL, 0);
 	//UG_LOG("SparseMatrix resize " << newRows << "x" << newCols << "\n");
 	if(newRows == 0 && newCols == 0)
 		return resize_and_clear(0,0);
@@ -168,7 +176,11 @@ template<typename vector_t>
 void SparseMatrix<T>::apply_ignore_zero_rows(vector_t &dest,
 		const number &beta1, const vector_t &w1) const
 {
-	for(size_t i=0; i < num_rows(); i++)
+	const size_t numRows = num_rows();
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(numRows >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i=0; i < numRows; i++)
 	{
 		size_t rowIt=rowStart[i];
 		size_t itEnd=rowEnd[i];
@@ -183,6 +195,62 @@ void SparseMatrix<T>::apply_ignore_zero_rows(vector_t &dest,
 }
 
 
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::apply_unmarked_rows(vector_t &dest, const vector_t &w1,
+		const std::vector<char> &vMark, std::vector<char> &vSkipped,
+		size_t firstRow, size_t lastRow) const
+{
+	PROFILE_SPMATRIX(SparseMatrix_apply_unmarked_rows);
+	check_fragmentation();
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(lastRow - firstRow >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i = firstRow; i < lastRow; i++)
+	{
+		const int rowIt = rowStart[i];
+		const int itEnd = rowEnd[i];
+
+	//	rows coupled to a marked index are computed later
+		bool bMarked = false;
+		for(int k = rowIt; k < itEnd; ++k)
+			if(vMark[cols[k]]) {bMarked = true; break;}
+		vSkipped[i] = bMarked;
+		if(bMarked) continue;
+
+		if(rowIt == itEnd)
+		{
+			dest[i] = 0.0;
+			continue;
+		}
+		MatMult(dest[i], 1.0, values[rowIt], w1[cols[rowIt]]);
+		for(int k = rowIt+1; k < itEnd; ++k)
+			MatMultAdd(dest[i], 1.0, dest[i], 1.0, values[k], w1[cols[k]]);
+	}
+}
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::apply_skipped_rows(vector_t &dest, const vector_t &w1,
+		const std::vector<char> &vSkipped) const
+{
+	PROFILE_SPMATRIX(SparseMatrix_apply_skipped_rows);
+	const size_t numRows = num_rows();
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(numRows >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i = 0; i < numRows; i++)
+	{
+		if(!vSkipped[i]) continue;
+		const int rowIt = rowStart[i];
+		const int itEnd = rowEnd[i];
+		MatMult(dest[i], 1.0, values[rowIt], w1[cols[rowIt]]);
+		for(int k = rowIt+1; k < itEnd; ++k)
+			MatMultAdd(dest[i], 1.0, dest[i], 1.0, values[k], w1[cols[k]]);
+	}
+}
+
+
 // calculate dest = alpha1*v1 + beta1*A*w1 (A = this matrix)
 template<typename T>
 template<typename vector_t>
@@ -192,9 +260,19 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 {
 	PROFILE_SPMATRIX(SparseMatrix_axpy);
 	check_fragmentation();
+	if(use_spmv_format())
+	{
+		m_sell.axpy(dest, alpha1, v1, beta1, w1);
+		return;
+	}
+
+	const size_t numRows = num_rows();
 	if(alpha1 == 0.0)
 	{
-		for(size_t i=0; i < num_rows(); i++)
+#ifdef UG_OPENMP
+		#pragma omp parallel for schedule(static) if(numRows >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+		for(size_t i=0; i < numRows; i++)
 		{
 			size_t rowIt=rowStart[i];
 			size_t itEnd=rowEnd[i];
@@ -212,20 +290,31 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	else if(&dest == &v1)
 	{
 		if(alpha1 != 1.0) {
-			for(size_t i=0; i < num_rows(); i++)
+#ifdef UG_OPENMP
+			#pragma omp parallel for schedule(static) if(numRows >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+			for(size_t i=0; i < numRows; i++)
 			{
 				dest[i] *= alpha1;
 				mat_mult_add_row(i, dest[i], beta1, w1);
 			}
 		}
 		else
-			for(size_t i=0; i < num_rows(); i++)
+		{
+#ifdef UG_OPENMP
+			#pragma omp parallel for schedule(static) if(numRows >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+			for(size_t i=0; i < numRows; i++)
 				mat_mult_add_row(i, dest[i], beta1, w1);
+		}
 
 	}
 	else
 	{
-		for(size_t i=0; i < num_rows(); i++)
+#ifdef UG_OPENMP
+		#pragma omp parallel for schedule(static) if(numRows >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+		for(size_t i=0; i < numRows; i++)
 		{
 			VecScaleAssign(dest[i], alpha1, v1[i]);
 			mat_mult_add_row(i, dest[i], beta1, w1);
@@ -233,6 +322,22 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	}
 }
 
+template<typename T>
+bool SparseMatrix<T>::use_spmv_format() const
+{
+	const SellCSigmaSettings& settings = GetSellCSigmaSettings();
+	if(!settings.bEnabled || !block_traits<value_type>::is_static)
+		return false;
+	if(m_sell.valid()) return true;
+
+//	build the copy only for matrices applied more than once without change
+	if(++m_sellApplyCnt < 2) return false;
+
+	PROFILE_SPMATRIX(SparseMatrix_build_sell_c_sigma);
+	m_sell.build(*this, settings.chunkSize, settings.sigma);
+	return true;
+}
+
 // calculate dest = alpha1*v1 + beta1*A^T*w1 (A = this matrix)
 template<typename T>
 template<typename vector_t>
@@ -490,6 +595,7 @@ int SparseMatrix<T>::get_index_const(int r, int c) const
 template<typename T>
 int SparseMatrix<T>::get_index(int r, int c)
 {
+	invalidate_spmv_format();
 //	UG_LOG("get_index " << r << ", " << c << "\n");
 //	UG_LOG(rowStart[r] << " - " << rowMax[r] << " - " << rowEnd[r] << " - " << cols.size() << " - "  << maxValues << "\n");
 	if(rowStart[r] == -1 || rowStart[r] == rowEnd[r])
@@ -616,26 +722,41 @@ void SparseMatrix<T>::copyToNewSize(size_t newSize, size_t maxCol)
 
 	std::vector<value_type> v(newSize);
 	std::vector<int> c(newSize);
+	const size_t numRows = num_rows();
+
+//	compute the new row starts first, such that the rows can be copied
+//	independently afterwards
+	std::vector<int> newStart(numRows+1);
 	size_t j=0;
-	for(size_t r=0; r<num_rows(); r++)
+	for(size_t r=0; r<numRows; r++)
 	{
-		if(rowStart[r] == -1)
-			rowStart[r] = rowEnd[r] = rowMax[r] = j;
-		else
+		newStart[r] = j;
+		if(rowStart[r] == -1) continue;
+		for(int k=rowStart[r]; k<rowEnd[r]; k++)
+			if(cols[k] < (int)maxCol) j++;
+	}
+	newStart[numRows] = j;
+
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(numRows >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t r=0; r<numRows; r++)
+	{
+		if(rowStart[r] != -1)
 		{
-			size_t start=j;
+			int jr = newStart[r];
 			for(int k=rowStart[r]; k<rowEnd[r]; k++)
 			{
 				if(cols[k] < (int)maxCol)
 				{
-					if(bNeedsValues) v[j] = values[k];
-					c[j] = cols[k];
-					j++;
+					if(bNeedsValues) v[jr] = values[k];
+					c[jr] = cols[k];
+					jr++;
 				}
 			}
-			rowStart[r] = start;
-			rowEnd[r] = rowMax[r] = j;
 		}
+		rowStart[r] = newStart[r];
+		rowEnd[r] = rowMax[r] = newStart[r+1];
 	}
 	rowStart[num_rows()] = rowEnd[num_rows()-1];
 	fragmented = 0;
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__SPARSEMATRIX_SELL__
+#define __H__UG__CPU_ALGEBRA__SPARSEMATRIX_SELL__
+
+#include <vector>
+#include <algorithm>
+#include "common/common.h"
+#include "algebra_misc.h"
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+/// \{
+
+//! maximal number of rows per chunk of the SELL-C-sigma format
+#define UG_SELL_MAX_CHUNK_SIZE 32
+
+//! settings for the SELL-C-sigma execution format of SparseMatrix
+struct SellCSigmaSettings
+{
+	SellCSigmaSettings() : bEnabled(false), chunkSize(8), sigma(256) {}
+
+	//! flag if matrices are applied in the SELL-C-sigma format
+	bool bEnabled;
+
+	//! number of rows per chunk (C)
+	size_t chunkSize;
+
+	//! number of rows sorted by length at once (sigma)
+	size_t sigma;
+};
+
+//! returns the (global) settings for the SELL-C-sigma execution format
+inline SellCSigmaSettings& GetSellCSigmaSettings()
+{
+	static SellCSigmaSettings settings;
+	return settings;
+}
+
+/**
+ * enables the SELL-C-sigma execution format for the matrix-vector products
+ * of SparseMatrix with fixed-size blocks
+ * \param bEnable		flag if format is used
+ * \param chunkSize		number of rows per chunk (C, at most UG_SELL_MAX_CHUNK_SIZE)
+ * \param sigma			number of rows that are sorted by length (sigma)
+ */
+inline void SetSparseMatrixSellCSigma(bool bEnable, size_t chunkSize, size_t sigma)
+{
+	if(chunkSize == 0 || chunkSize > UG_SELL_MAX_CHUNK_SIZE)
+		UG_THROW("SetSparseMatrixSellCSigma: chunk size must be in [1, "
+				<< UG_SELL_MAX_CHUNK_SIZE << "], but is " << chunkSize);
+
+	SellCSigmaSettings& s = GetSellCSigmaSettings();
+	s.bEnabled = bEnable;
+	s.chunkSize = chunkSize;
+	s.sigma = std::max(sigma, chunkSize);
+}
+
+/**
+ * Read-only copy of a sparse matrix in the SELL-C-sigma format.
+ * The rows are sorted by their number of connections within windows of sigma
+ * rows and grouped into chunks of C rows. The entries of a chunk are stored
+ * column-wise, i.e. the j-th entries of all rows of a chunk are contiguous,
+ * and rows are padded to the longest row of the chunk. Thus, the innermost
+ * loop of the matrix-vector product runs over the C rows of a chunk with unit
+ * stride, which allows the compiler to vectorize it. Since the rows of a chunk
+ * are sorted by decreasing length, the padding entries of each column of the
+ * chunk form a tail, which is skipped using the stored row lengths. Hence,
+ * padding entries are never multiplied (e.g. with a NaN or Inf entry of the
+ * vector).
+ *
+ * \tparam TValue	block type of the matrix
+ */
+template<typename TValue>
+class SellCSigmaStorage
+{
+public:
+	typedef TValue value_type;
+
+	SellCSigmaStorage() : m_C(0), m_numRows(0), m_bValid(false) {}
+
+	//! builds the format from a matrix (must provide num_rows, num_connections and row iterators)
+	template<typename TMatrix>
+	void build(const TMatrix &A, size_t chunkSize, size_t sigma);
+
+	//! returns if the format has been built and the matrix not been changed since
+	bool valid() const { return m_bValid; }
+
+	//! marks the format as outdated (memory is kept for the next build)
+	void invalidate() { m_bValid = false; }
+
+	//! calculates dest = alpha1*v1 + beta1*A*w1
+	template<typename vector_t>
+	void axpy(vector_t &dest,
+			const number &alpha1, const vector_t &v1,
+			const number &beta1, const vector_t &w1) const;
+
+private:
+	size_t m_C;
+	size_t m_numRows;
+	bool m_bValid;
+
+	//! original row index of the i'th sorted row
+	std::vector<int> m_vPerm;
+
+	//! number of connections of the i'th sorted row
+	std::vector<size_t> m_vRowLen;
+
+	//! start of chunk k in m_vCol/m_vValue (size: numChunks+1)
+	std::vector<size_t> m_vChunkOffset;
+
+	//! column indices, chunk-wise in column-major order
+	std::vector<int> m_vCol;
+
+	//! values, chunk-wise in column-major order
+	std::vector<value_type> m_vValue;
+};
+
+template<typename TValue>
+template<typename TMatrix>
+void SellCSigmaStorage<TValue>::build(const TMatrix &A, size_t chunkSize, size_t sigma)
+{
+	typedef typename TMatrix::const_row_iterator const_row_iterator;
+
+	m_C = std::min(std::max(chunkSize, (size_t)1), (size_t)UG_SELL_MAX_CHUNK_SIZE);
+	sigma = ((std::max(sigma, m_C) + m_C - 1) / m_C) * m_C;
+	m_numRows = A.num_rows();
+
+//	sort the rows by decreasing length within windows of sigma rows
+	std::vector<sortStruct<int> > vSort(m_numRows);
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		vSort[i].index = i;
+		vSort[i].sortValue = -(int)A.num_connections(i);
+	}
+	for(size_t start = 0; start < m_numRows; start += sigma)
+		std::stable_sort(vSort.begin() + start,
+		                 vSort.begin() + std::min(start + sigma, m_numRows));
+
+	m_vPerm.resize(m_numRows);
+	m_vRowLen.resize(m_numRows);
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		m_vPerm[i] = vSort[i].index;
+		m_vRowLen[i] = -vSort[i].sortValue;
+	}
+
+//	chunk offsets
+	const size_t numChunks = (m_numRows + m_C - 1) / m_C;
+	m_vChunkOffset.resize(numChunks + 1);
+	m_vChunkOffset[0] = 0;
+	for(size_t k = 0; k < numChunks; ++k)
+	{
+	//	rows are sorted decreasingly, so the first row of a chunk is the longest
+		const size_t width = m_vRowLen[k*m_C];
+		m_vChunkOffset[k+1] = m_vChunkOffset[k] + width * m_C;
+	}
+
+//	fill the chunks, padding entries (never used in axpy) are set to column 0 and value 0
+	m_vCol.assign(m_vChunkOffset[numChunks], 0);
+	m_vValue.resize(m_vChunkOffset[numChunks]);
+	for(size_t i = 0; i < m_vValue.size(); ++i)
+		m_vValue[i] = 0.0;
+
+	for(size_t i = 0; i < m_numRows; ++i)
+	{
+		const size_t k = i / m_C, r = i % m_C;
+		size_t pos = m_vChunkOffset[k] + r;
+		for(const_row_iterator it = A.begin_row(m_vPerm[i]); it != A.end_row(m_vPerm[i]); ++it, pos += m_C)
+		{
+			m_vCol[pos] = it.index();
+			m_vValue[pos] = it.value();
+		}
+	}
+
+	m_bValid = true;
+}
+
+template<typename TValue>
+template<typename vector_t>
+void SellCSigmaStorage<TValue>::axpy(vector_t &dest,
+		const number &alpha1, const vector_t &v1,
+		const number &beta1, const vector_t &w1) const
+{
+	typedef typename vector_t::value_type vec_value_type;
+	UG_ASSERT(m_bValid, "SELL-C-sigma format used, but not built.");
+
+	const size_t C = m_C;
+	const int numChunks = (int) (m_vChunkOffset.size() - 1);
+
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(m_numRows >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(int k = 0; k < numChunks; ++k)
+	{
+		const size_t firstRow = k*C;
+		const size_t nr = std::min(C, m_numRows - firstRow);
+		const int* vPerm = &m_vPerm[firstRow];
+		const size_t* vRowLen = &m_vRowLen[firstRow];
+
+	//	initialize with alpha1*v1
+		vec_value_type sum[UG_SELL_MAX_CHUNK_SIZE];
+		for(size_t r = 0; r < nr; ++r)
+		{
+			if(alpha1 == 0.0) sum[r] = 0.0;
+			else VecScaleAssign(sum[r], alpha1, v1[vPerm[r]]);
+		}
+
+	//	add beta1*A*w1, column by column of the chunk. Rows are sorted by
+	//	decreasing length, so only the first na rows have an entry in column j
+		size_t na = nr;
+		for(size_t pos = m_vChunkOffset[k], j = 0; pos < m_vChunkOffset[k+1]; pos += C, ++j)
+		{
+			while(na > 0 && vRowLen[na-1] <= j) --na;
+			const value_type* vVal = &m_vValue[pos];
+			const int* vCol = &m_vCol[pos];
+			for(size_t r = 0; r < na; ++r)
+				MatMultAdd(sum[r], 1.0, sum[r], beta1, vVal[r], w1[vCol[r]]);
+		}
+
+		for(size_t r = 0; r < nr; ++r)
+			dest[vPerm[r]] = sum[r];
+	}
+}
+
+// end group lib_algebra
+/// \}
+
+} // end namespace ug
+
+#endif // __H__UG__CPU_ALGEBRA__SPARSEMATRIX_SELL__
@@ -34,6 +34,7 @@
 #define __H__UG__CPU_ALGEBRA__VECTOR__
 
 #include "sparsematrix.h"
+#include "algebra_misc.h"
 
 #include "../common/template_expressions.h"
 #include "../common/operations.h"
@@ -169,7 +170,10 @@ public:
 
 	inline void operator *= (const number &a)
 	{
-		for(size_t i=0; i<size(); i++) values[i] *= a;
+#ifdef UG_OPENMP
+		#pragma omp parallel for schedule(static) if(m_size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+		for(size_t i=0; i<m_size; i++) values[i] *= a;
 	}
 
 	//! return sqrt(sum values[i]^2) (euclidian norm)
@@ -74,6 +74,9 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 	UG_ASSERT(m_size == w.m_size,  *this << " has not same size as " << w);
 
 	double sum=0;
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) reduction(+:sum) if(m_size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
 	for(size_t i=0; i<m_size; i++)	sum += VecProd(values[i], w[i]);
 	return sum;
 }
@@ -82,6 +85,9 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 template<typename value_type>
 inline double Vector<value_type>::operator = (double d)
 {
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(m_size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] = d;
 	return d;
@@ -100,6 +106,9 @@ template<typename value_type>
 inline void Vector<value_type>::operator = (const vector_type &v)
 {
 	resize(v.size());
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(m_size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] = v[i];
 }
@@ -108,6 +117,9 @@ template<typename value_type>
 inline void Vector<value_type>::operator += (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(m_size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] += v[i];
 }
@@ -116,6 +128,9 @@ template<typename value_type>
 inline void Vector<value_type>::operator -= (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(m_size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] -= v[i];
 }
@@ -162,6 +177,14 @@ void Vector<value_type>::create(size_t size)
 	m_size = size;
 	values = new value_type[size];
 	m_capacity = size;
+
+#ifdef UG_OPENMP
+//	first touch with the same static partition as used by the kernels, such
+//	that the memory pages are placed near the thread working on them
+	#pragma omp parallel for schedule(static) if(size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+	for(size_t i=0; i<size; i++)
+		values[i] = 0.0;
+#endif
 }
 
 
@@ -197,8 +220,14 @@ void Vector<value_type>::reserve_exactly(size_t newCapacity, bool bCopyValues)
 	// we cannot use memcpy here bcs of variable blocks.
 	if(values != NULL && bCopyValues)
 	{
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(newCapacity >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
 		for(size_t i=0; i<m_size; i++)
 			std::swap(new_values[i], values[i]);
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(newCapacity >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
 		for(size_t i=m_size; i<newCapacity; i++)
 			new_values[i] = 0.0;
 	}
@@ -245,6 +274,9 @@ void Vector<value_type>::create(const Vector &v)
 	m_capacity = m_size;
 
 	// we cannot use memcpy here bcs of variable blocks.
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(m_size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
 	for(size_t i=0; i<m_size; i++)
 		values[i] = v.values[i];
 }
@@ -323,11 +355,105 @@ template<typename value_type>
 inline double Vector<value_type>::norm() const
 {
 	double d=0;
-	for(size_t i=0; i<size(); ++i)
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) reduction(+:d) if(m_size >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i=0; i<m_size; ++i)
 		d+=BlockNorm2(values[i]);
 	return sqrt(d);
 }
 
+
+// The following overloads are more specialized than the generic ones in
+// operations_vec.h and are used for the cpu vector itself (but not for its
+// blocks), such that the BLAS-1 kernels can be run thread-parallel.
+
+//! calculates dest = alpha1*v1
+template<typename value_type>
+inline void VecScaleAssign(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1)
+{
+	const size_t n = dest.size();
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i=0; i<n; i++)
+		VecScaleAssign(dest[i], alpha1, v1[i]);
+}
+
+//! sets dest = v1 entrywise
+template<typename value_type>
+inline void VecAssign(Vector<value_type> &dest, const Vector<value_type> &v1)
+{
+	const size_t n = dest.size();
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i=0; i<n; i++)
+		dest[i] = v1[i];
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2
+template<typename value_type>
+inline void VecScaleAdd(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1,
+                        double alpha2, const Vector<value_type> &v2)
+{
+	const size_t n = dest.size();
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i=0; i<n; i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i]);
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2 + alpha3*v3
+template<typename value_type>
+inline void VecScaleAdd(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1,
+                        double alpha2, const Vector<value_type> &v2,
+                        double alpha3, const Vector<value_type> &v3)
+{
+	const size_t n = dest.size();
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i=0; i<n; i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i], alpha3, v3[i]);
+}
+
+//! returns scal<a, b>
+template<typename value_type>
+inline double VecProd(const Vector<value_type> &a, const Vector<value_type> &b)
+{
+	return const_cast<Vector<value_type>* >(&a)->dotprod(b);
+}
+
+//! returns norm_2^2(a)
+template<typename value_type>
+inline double VecNormSquared(const Vector<value_type> &a)
+{
+	const size_t n = a.size();
+	double sum=0;
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) reduction(+:sum) if(n >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+	for(size_t i=0; i<n; i++)
+		VecNormSquaredAdd(a[i], sum);
+	return sum;
+}
+
+//! returns scal<a, b> of the process-local entries (equals VecProd for sequential vectors)
+template<typename value_type>
+inline double VecProdLocal(const Vector<value_type> &a, const Vector<value_type> &b)
+{
+	return VecProd(a, b);
+}
+
+//! returns norm_2^2(a) of the process-local entries (equals VecNormSquared for sequential vectors)
+template<typename value_type>
+inline double VecNormSquaredLocal(const Vector<value_type> &a)
+{
+	return VecNormSquared(a);
+}
+
 template<typename TValueType>
 void CloneVector(Vector<TValueType> &dest, const Vector<TValueType>& src)
 {
@@ -151,6 +151,9 @@ class AlgebraicConvCheck : public IConvergenceCheck<TVector>
 	/// calculates the 2-norm of the entries of the vector vec specified by index
 		number norm(const TVector& vec, size_t cmp);
 
+	/// calculates the 2-norms of all components at once (one reduction only)
+		void norms(const TVector& vec, std::vector<number>& vNorm);
+
 	protected:
 
 		struct CmpInfo{
@@ -112,8 +112,10 @@ void AlgebraicConvCheck<TVector>::start(const TVector& vec)
 	if (m_bTimeMeas)	m_stopwatch.start();
 
 	// update defects
+	std::vector<number> vNorm;
+	norms(vec, vNorm);
 	for (size_t fct = 0; fct < m_vCmpInfo.size(); fct++){
-		m_vCmpInfo[fct].currDefect = m_vCmpInfo[fct].initDefect = norm(vec, fct);
+		m_vCmpInfo[fct].currDefect = m_vCmpInfo[fct].initDefect = vNorm[fct];
 	}
 
 	m_currentStep = 0;
@@ -193,9 +195,11 @@ template <class TVector>
 void AlgebraicConvCheck<TVector>::update(const TVector& vec)
 {
 	// update defects
+	std::vector<number> vNorm;
+	norms(vec, vNorm);
 	for (size_t fct = 0; fct < m_vCmpInfo.size(); fct++){
 		m_vCmpInfo[fct].lastDefect = m_vCmpInfo[fct].currDefect;
-		m_vCmpInfo[fct].currDefect = norm(vec, fct);
+		m_vCmpInfo[fct].currDefect = vNorm[fct];
 	}
 
 	//vec.print(); // debug only!
@@ -377,6 +381,41 @@ norm(const TVector& vec, size_t cmp)
 	return sqrt((number) norm);
 }
 
+
+template <class TVector>
+void AlgebraicConvCheck<TVector>::
+norms(const TVector& vec, std::vector<number>& vNorm)
+{
+#ifdef UG_PARALLEL
+
+	// 	make vector d additive unique
+	if (!const_cast<TVector*>(&vec)->change_storage_type(PST_UNIQUE))
+		UG_THROW("AlgebraicConvCheck::norms(): Cannot change ParallelStorageType to unique.");
+#endif
+
+	// compute squared local norms of all components
+	std::vector<double> vNormSq(m_vCmpInfo.size());
+	for (size_t cmp = 0; cmp < m_vCmpInfo.size(); cmp++)
+	{
+		ConstScalarSubVectorAdapter<TVector, typename ug::Vector<double> > dummy (vec,cmp);
+		vNormSq[cmp] = VecNormSquared(dummy);
+	}
+
+#ifdef UG_PARALLEL
+	// sum squared local norms of all components in one reduction
+	if (!vNormSq.empty())
+	{
+		std::vector<double> vLocal(vNormSq);
+		vec.layouts()->proc_comm().allreduce(vLocal, vNormSq, PCL_RO_SUM);
+	}
+#endif
+
+	// return global norms
+	vNorm.resize(vNormSq.size());
+	for (size_t cmp = 0; cmp < vNormSq.size(); cmp++)
+		vNorm[cmp] = sqrt((number) vNormSq[cmp]);
+}
+
 } // end namespace ug
 
 
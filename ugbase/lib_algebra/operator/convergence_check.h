@@ -83,6 +83,15 @@ class IConvergenceCheck
 		/// computes the defect and sets it a the next defect value
 		virtual void update(const TVector& d) = 0;
 
+		/// returns if start(d) and update(d) only depend on the two norm of d
+		/**
+		 * If true, a solver may compute the two norm of the defect itself
+		 * (e.g. together with other scalar products in one reduction) and pass
+		 * it to start_defect() and update_defect() instead of calling start()
+		 * and update().
+		 */
+		virtual bool uses_two_norm_only() const {return false;}
+
 		/** iteration_ended
 		 *
 		 *	Checks if the iteration must be ended.
@@ -198,6 +207,8 @@ class StdConvCheck : public IConvergenceCheck<TVector>
 
 		void update(const TVector& d);
 
+		virtual bool uses_two_norm_only() const {return true;}
+
 		bool iteration_ended();
 
 		bool post();
@@ -69,6 +69,9 @@ class FixedConvergenceCheck : public IConvergenceCheck<TVector>
 			m_currentStep++;
 		}
 
+		/// the defect is not used at all
+		virtual bool uses_two_norm_only() const {return true;}
+
 		/** iteration_ended
 		 *
 		 *	Checks if the iteration must be ended.
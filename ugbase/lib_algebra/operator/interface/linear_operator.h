@@ -34,6 +34,10 @@
 #define __H__LIB_ALGEBRA__OPERATOR__INTERFACE__LINEAR_OPERATOR__
 
 #include "operator.h"
+#ifdef UG_PARALLEL
+	#include "common/error.h"
+	#include "lib_algebra/parallelization/parallel_storage_type.h"
+#endif
 
 namespace ug{
 
@@ -138,6 +142,25 @@ class ILinearOperator : public IOperator<X,Y>
 	 */
 		virtual void apply_sub(Y& f, const X& u) = 0;
 
+	// 	changes u to consistent storage and applies the operator
+	/**
+	 * This method is used by iterative schemes that have to make a vector
+	 * consistent right before applying the operator to it. Matrix based
+	 * operators overlap the interface communication with the computation.
+	 *
+	 * \param[in,out]	u		domain function (consistent on exit)
+	 * \param[out]		f		codomain function
+	 */
+		virtual void apply_and_make_consistent(Y& f, X& u)
+		{
+		#ifdef UG_PARALLEL
+			if(!u.change_storage_type(PST_CONSISTENT))
+				UG_THROW("ILinearOperator::apply_and_make_consistent: "
+						"Cannot change parallel storage type to consistent.");
+		#endif
+			apply(f, u);
+		}
+
 	/// virtual	destructor
 		virtual ~ILinearOperator() {};
 };
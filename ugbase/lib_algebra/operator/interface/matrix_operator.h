@@ -70,6 +70,11 @@ class MatrixOperator :	public virtual ILinearOperator<X,Y>,
 	// 	Apply Operator, i.e. f = f - L*u;
 		virtual void apply_sub(Y& f, const X& u) {matrix_type::matmul_minus(f,u);}
 
+#ifdef UG_PARALLEL
+	// 	Make u consistent and apply f = L*u, overlapping the communication
+		virtual void apply_and_make_consistent(Y& f, X& u) {matrix_type::apply_and_make_consistent(f,u);}
+#endif
+
 	// 	Access to matrix
 		virtual M& get_matrix() {return *this;};
 };
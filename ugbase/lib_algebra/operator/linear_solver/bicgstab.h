@@ -40,6 +40,7 @@
 #include "lib_algebra/operator/interface/operator.h"
 #include "lib_algebra/operator/interface/linear_solver_profiling.h"
 #include "lib_algebra/operator/interface/pprocess.h"
+#include "lib_algebra/algebra_common/fused_reduction.h"
 #ifdef UG_PARALLEL
 	#include "lib_algebra/parallelization/parallelization.h"
 #endif
@@ -141,9 +142,18 @@ class BiCGStab
 				UG_THROW("BiCGStab: Cannot convert b to unique vector.");
 			#endif
 
+		//	if the convergence check only needs the defect norm, the norms are
+		//	summed up together with the other scalar products of the iteration
+			const bool bFused = convergence_check()->uses_two_norm_only();
+			FusedReduction<vector_type> red;
+
 		//	needed variables
 			number rho = 1, alpha = 1, omega = 1, norm_r0 = 0.0;
 
+		//	(r0,r) of the current r, if already computed together with ||r||
+			number rhoNext = 0.0;
+			bool bRhoNextValid = false;
+
 		//	restart flag (set to true at first run)
 			bool bRestart = true;
 
@@ -183,6 +193,9 @@ class BiCGStab
 				//	remember start norm
 					norm_r0 = convergence_check()->defect();
 
+				//	r0 has changed, (r0,r) must be recomputed
+					bRhoNextValid = false;
+
 				//	remove restart flag
 					bRestart = false;
 				}
@@ -193,6 +206,8 @@ class BiCGStab
 			// 	Compute rho new
 				if (!r.size())
 					rho = 1.0;
+				else if(bRhoNextValid)
+					rho = rhoNext;
 				else
 					rho = VecProd(r0, r);
 
@@ -277,13 +292,16 @@ class BiCGStab
 			//  compute s = r - alpha*v
 				VecScaleAdd(s, 1.0, r, -alpha, v);
 
-			// 	check convergence
-				convergence_check()->update(s);
-
-			//	if finished: set output to last defect and exist loop
-				if(convergence_check()->iteration_ended())
+			// 	check convergence (if fused, done together with (t,t), (s,t))
+				if(!bFused)
 				{
-					r = s; break;
+					convergence_check()->update(s);
+
+				//	if finished: set output to last defect and exist loop
+					if(convergence_check()->iteration_ended())
+					{
+						r = s; break;
+					}
 				}
 
 			// 	apply q = M^-1 * s ...
@@ -319,18 +337,41 @@ class BiCGStab
 					UG_THROW("BiCGStab: Cannot convert t to unique vector.");
 				#endif
 
-			// 	tt = (t,t)
+			// 	tt = (t,t), omega = (s,t)
 				number tt;
-				if (!t.size())
-					tt = 1.0;
-				else
-					tt = VecProd(t, t);
+				if(bFused)
+				{
+				//	sum ||s||, (t,t) and (s,t) in one reduction
+					red.clear();
+					const size_t iNorm = red.add_norm_squared(s);
+					const size_t iTT = red.add_dotprod(t, t);
+					const size_t iST = red.add_dotprod(s, t);
+					red.reduce();
+
+				// 	check convergence
+					convergence_check()->update_defect(red.norm(iNorm));
+
+				//	if finished: set output to last defect and exist loop
+					if(convergence_check()->iteration_ended())
+					{
+						r = s; break;
+					}
 
-			// 	omega = (s,t)
-				if (!s.size())
-					omega = 1.0;
+					tt = (!t.size()) ? 1.0 : red.value(iTT);
+					omega = (!s.size()) ? 1.0 : red.value(iST);
+				}
 				else
-					omega = VecProd(s, t);
+				{
+					if (!t.size())
+						tt = 1.0;
+					else
+						tt = VecProd(t, t);
+
+					if (!s.size())
+						omega = 1.0;
+					else
+						omega = VecProd(s, t);
+				}
 
 			//	check tt
 				if(tt == 0.0)
@@ -350,7 +391,19 @@ class BiCGStab
 				VecScaleAdd(r, 1.0, s, -omega, t);
 
 			// 	check convergence
-				convergence_check()->update(r);
+				if(bFused)
+				{
+				//	sum ||r|| and (r0,r) for the next rho in one reduction
+					red.clear();
+					const size_t iNorm = red.add_norm_squared(r);
+					const size_t iRho = red.add_dotprod(r0, r);
+					red.reduce();
+					convergence_check()->update_defect(red.norm(iNorm));
+					rhoNext = red.value(iRho);
+					bRhoNextValid = true;
+				}
+				else
+					convergence_check()->update(r);
 
 			//	check values
 				if(omega == 0.0)
@@ -39,6 +39,7 @@
 #include "lib_algebra/operator/interface/operator.h"
 #include "common/profiler/profiler.h"
 #include "lib_algebra/operator/interface/pprocess.h"
+#include "lib_algebra/algebra_common/fused_reduction.h"
 #ifdef UG_PARALLEL
 	#include "lib_algebra/parallelization/parallelization.h"
 #endif
@@ -143,16 +144,31 @@ class CG
 		//	post-process the correction
 			m_corr_post_process.apply (z);
 
-		//	compute start defect
+		//	if the convergence check only needs the defect norm, the norm is
+		//	summed up together with (z,r) in one reduction
+			const bool bFused = convergence_check()->uses_two_norm_only();
+			FusedReduction<vector_type> red;
+
+		//	compute start defect and start rho
 			prepare_conv_check();
-			convergence_check()->start(r);
+			number rhoOld, rho;
+			if(bFused)
+			{
+				const size_t iNorm = red.add_norm_squared(r);
+				const size_t iRho = red.add_dotprod(z, r);
+				red.reduce();
+				convergence_check()->start_defect(red.norm(iNorm));
+				rhoOld = red.value(iRho);
+			}
+			else
+			{
+				convergence_check()->start(r);
+				rhoOld = VecProd(z, r);
+			}
 
 		// 	start search direction
 			p = z;
 
-		// 	start rho
-			number rhoOld = VecProd(z, r), rho;
-
 		// 	Iteration loop
 			while(!convergence_check()->iteration_ended())
 			{
@@ -180,8 +196,11 @@ class CG
 				VecScaleAdd(r, 1.0, r, -alpha, q);
 
 			// 	Check convergence
-				convergence_check()->update(r);
-				if(convergence_check()->iteration_ended()) break;
+				if(!bFused)
+				{
+					convergence_check()->update(r);
+					if(convergence_check()->iteration_ended()) break;
+				}
 
 			// 	Preconditioning
 				if(preconditioner().valid())
@@ -206,8 +225,19 @@ class CG
 			//	post-process the correction
 				m_corr_post_process.apply (z);
 
-			// 	new rho = (z,r)
-				rho = VecProd(z, r);
+			// 	new rho = (z,r), check convergence if not done before
+				if(bFused)
+				{
+					red.clear();
+					const size_t iNorm = red.add_norm_squared(r);
+					const size_t iRho = red.add_dotprod(z, r);
+					red.reduce();
+					convergence_check()->update_defect(red.norm(iNorm));
+					if(convergence_check()->iteration_ended()) break;
+					rho = red.value(iRho);
+				}
+				else
+					rho = VecProd(z, r);
 
 			// 	new beta = rho / rhoOld
 				const number beta = rho/rhoOld;
@@ -39,6 +39,9 @@
 #include "lib_algebra/operator/interface/operator.h"
 #include "common/profiler/profiler.h"
 #include "lib_algebra/operator/interface/pprocess.h"
+#include "lib_algebra/algebra_common/fused_reduction.h"
+#include "lib_algebra/algebra_common/multi_vector_ops.h"
+#include "lib_algebra/small_algebra/storage/variable_array.h"
 #ifdef UG_PARALLEL
 	#include "lib_algebra/parallelization/parallelization.h"
 #endif
@@ -58,6 +61,14 @@ namespace ug{
  *
  * - Saad, "Iterative Methods For Sparse Linear Systems"
  *
+ * The new Krylov vector is orthogonalized against the basis either by the
+ * modified Gram-Schmidt method (default), which needs one global reduction per
+ * basis vector, or by the classical Gram-Schmidt method with one
+ * reorthogonalization (CGS2, see Giraud, Langou, Rozloznik, "The loss of
+ * orthogonality in the Gram-Schmidt orthogonalization process", 2005). CGS2
+ * computes all projections in one sweep over the basis and needs two global
+ * reductions per step only, independent of the size of the basis.
+ *
  * \tparam 	TVector		vector type
  */
 template <typename TVector>
@@ -79,15 +90,18 @@ class GMRES
 
 	public:
 	///	default constructor
-		GMRES(size_t restart) : m_restart(restart) {};
+		GMRES(size_t restart) : m_restart(restart), m_bCGS2(false) {};
 
 	///	constructor setting the preconditioner and the convergence check
 		GMRES( size_t restart,
 		       SmartPtr<ILinearIterator<vector_type> > spPrecond,
 		       SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
-			: base_type(spPrecond, spConvCheck), m_restart(restart)
+			: base_type(spPrecond, spConvCheck), m_restart(restart), m_bCGS2(false)
 		{};
 
+	///	sets if classical Gram-Schmidt with reorthogonalization (CGS2) is used
+		void set_cgs2(bool bCGS2) {m_bCGS2 = bCGS2;}
+
 	///	name of solver
 		virtual const char* name() const {return "GMRES";}
 
@@ -120,10 +134,10 @@ class GMRES
 		//	compute start defect norm
 			convergence_check()->start(*spR);
 
-		//	storage for v, h, gamma
+		//	storage for v, h, gamma (h is stored column-wise, such that the
+		//	projection coefficients of one step are contiguous)
 			std::vector<SmartPtr<vector_type> > v(m_restart+1);
-			std::vector<std::vector<number> > h(m_restart+1);
-			for(size_t i = 0; i < h.size(); ++i) h[i].resize(m_restart+1);
+			VariableArray2<number> h; h.resize(m_restart+1, m_restart+1);
 			std::vector<number> gamma(m_restart+1);
 			std::vector<number> c(m_restart+1);
 			std::vector<number> s(m_restart+1);
@@ -173,13 +187,8 @@ class GMRES
 				//	get storage for v[j+1]
 					if(v[j+1].invalid()) v[j+1] = x.clone_without_values();
 
-#ifdef UG_PARALLEL
-					if(!v[j]->change_storage_type(PST_CONSISTENT))
-						UG_THROW("GMRES: Cannot convert v["<<j+1<<"] to consistent vector.");
-#endif
-
-				//	compute r = A*v[j]
-					linear_operator()->apply(*spR, *v[j]);
+				//	compute r = A*v[j], v[j] is made consistent (overlapped with A*v[j])
+					linear_operator()->apply_and_make_consistent(*spR, *v[j]);
 
 				// 	apply v[j+1] = M^-1 * A * v[j]
 					if(preconditioner().valid()){
@@ -204,36 +213,42 @@ class GMRES
 				//	post-process the correction
 					m_corr_post_process.apply (*v[j+1]);
 
-				//	loop previous steps
-					for(size_t i = 0; i <= j; ++i)
+				//	orthogonalize v[j+1] and compute h_{j+1,j}
+					if(m_bCGS2)
+						h(j+1, j) = orthogonalize_cgs2(v, j, &h(0, j));
+					else
 					{
-					//	h_ij := (r, v[j])
-						h[i][j] = VecProd(*v[j+1], *v[i]);
+					//	loop previous steps
+						for(size_t i = 0; i <= j; ++i)
+						{
+						//	h_ij := (r, v[j])
+							h(i, j) = VecProd(*v[j+1], *v[i]);
+
+						//	v[j+1] -= h_ij * v[i]
+							VecScaleAppend(*v[j+1], *v[i], (-1)*h(i, j));
+						}
 
-					//	v[j+1] -= h_ij * v[i]
-						VecScaleAppend(*v[j+1], *v[i], (-1)*h[i][j]);
+					//	compute h_{j+1,j}
+						h(j+1, j) = v[j+1]->norm();
 					}
 
-				//	compute h_{j+1,j}
-					h[j+1][j] = v[j+1]->norm();
-
 				//	update h
 					for(size_t i = 0; i < j; ++i)
 					{
-						const number hij = h[i][j];
-						const number hi1j = h[i+1][j];
+						const number hij = h(i, j);
+						const number hi1j = h(i+1, j);
 
-						h[i][j]   =  c[i+1]*hij + s[i+1]*hi1j;
-						h[i+1][j] =  s[i+1]*hij - c[i+1]*hi1j;
+						h(i, j)   =  c[i+1]*hij + s[i+1]*hi1j;
+						h(i+1, j) =  s[i+1]*hij - c[i+1]*hi1j;
 					}
 
 				//	alpha := sqrt(h_jj ^2 + h_{j+1,j}^2)
-					const number alpha = sqrt(h[j][j]*h[j][j] + h[j+1][j]*h[j+1][j]);
+					const number alpha = sqrt(h(j, j)*h(j, j) + h(j+1, j)*h(j+1, j));
 
 				//	update s, c
-					s[j+1] = h[j+1][j] / alpha;
-					c[j+1] = h[j][j]   / alpha;
-					h[j][j] = alpha;
+					s[j+1] = h(j+1, j) / alpha;
+					c[j+1] = h(j, j)   / alpha;
+					h(j, j) = alpha;
 
 				//	compute new norm
 					gamma[j+1] = s[j+1]*gamma[j];
@@ -251,15 +266,15 @@ class GMRES
 					}
 
 				//	normalize v[j+1]
-					*v[j+1] *= 1./(h[j+1][j]);
+					*v[j+1] *= 1./(h(j+1, j));
 				}
 
 			//	compute current x
 				for(size_t i = numIter; ; --i){
 					for(size_t j = i+1; j <= numIter; ++j)
-						gamma[i] -= h[i][j] * gamma[j];
+						gamma[i] -= h(i, j) * gamma[j];
 
-					gamma[i] /= h[i][i];
+					gamma[i] /= h(i, i);
 
 				//	x = x + gamma[i] * v[i]
 					VecScaleAppend(x, *v[i], gamma[i]);
@@ -283,7 +298,7 @@ class GMRES
 		virtual std::string config_string() const
 		{
 			std::stringstream ss;
-			ss << "GMRes ( restart = " << m_restart << ")\n";
+			ss << "GMRes ( restart = " << m_restart << ", CGS2 = " << m_bCGS2 << ")\n";
 			ss << base_type::config_string_preconditioner_convergence_check();
 			return ss.str();
 		}
@@ -317,10 +332,63 @@ class GMRES
 			convergence_check()->set_info(s);
 		}
 
+	protected:
+	///	orthogonalizes v[j+1] against v[0],...,v[j] by CGS2
+	/**
+	 * Computes hCol[i] = (v[j+1], v[i]) for i = 0,...,j and
+	 * v[j+1] -= sum_i hCol[i] * v[i] in two passes. In each pass all
+	 * projections are computed in one sweep and summed in one reduction. The
+	 * norm of the orthogonalized vector is summed together with the second
+	 * pass and corrected by the (small) second projection.
+	 *
+	 * \return the norm of the orthogonalized v[j+1]
+	 */
+		number orthogonalize_cgs2(std::vector<SmartPtr<vector_type> >& v,
+		                          size_t j, number* hCol)
+		{
+			vector_type& w = *v[j+1];
+			const size_t n = j+1;
+			std::vector<number> vCoeff(n);
+			FusedReduction<vector_type> red;
+
+		//	first pass: hCol = V^T w, w := w - V hCol
+			red.add_dotprods(v, n, w);
+			red.reduce();
+			for(size_t i = 0; i < n; ++i){
+				hCol[i] = red.value(i);
+				vCoeff[i] = -hCol[i];
+			}
+			VecScaleAppendMulti(w, v, n, &vCoeff[0]);
+
+		//	second pass (reorthogonalization) with ||w||^2 in the same reduction
+			red.clear();
+			red.add_dotprods(v, n, w);
+			const size_t iNorm = red.add_norm_squared(w);
+			red.reduce();
+			number corr = 0.0;
+			for(size_t i = 0; i < n; ++i){
+				const number hi = red.value(i);
+				hCol[i] += hi;
+				vCoeff[i] = -hi;
+				corr += hi*hi;
+			}
+			VecScaleAppendMulti(w, v, n, &vCoeff[0]);
+
+		//	||w - V h||^2 = ||w||^2 - ||h||^2, since V is orthonormal. If
+		//	cancellation occurs, the norm is recomputed.
+			const number normSq = red.value(iNorm) - corr;
+			if(normSq <= 0.5 * red.value(iNorm))
+				return w.norm();
+			return sqrt(normSq);
+		}
+
 	protected:
 	///	restart parameter
 		size_t m_restart;
 
+	///	flag if classical Gram-Schmidt with reorthogonalization is used
+		bool m_bCGS2;
+
 	///	postprocessor for the correction in the iterations
 		/**
 		 * These postprocess operations are applied to the preconditioned
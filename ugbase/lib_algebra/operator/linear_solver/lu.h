@@ -44,6 +44,7 @@
 #include "../preconditioner/ilut_scalar.h"
 #include "../interface/preconditioned_linear_operator_inverse.h"
 #include "linear_solver.h"
+#include "multifrontal_lu.h"
 
 #include "lib_algebra/cpu_algebra_types.h"
 
@@ -75,7 +76,8 @@ class LU
 
 	public:
 	///	constructor
-		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false)
+		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false),
+			m_bMultifrontal(true)
 		{
 #ifdef LAPACK_AVAILABLE
 			m_iMinimumForSparse = 4000;
@@ -93,6 +95,9 @@ class LU
 			m_iMinimumForSparse=N;
 		}
 
+	///	sets if a Cuthill-McKee sorting is used to reduce the fill-in of ILUT(0)
+	/**	Only used if the multifrontal LU is disabled by set_multifrontal(false),
+	 * the multifrontal LU always uses its nested dissection ordering.*/
 		void set_sort_sparse(bool b)
 		{
 			m_bSortSparse = b;
@@ -103,6 +108,18 @@ class LU
 			m_bInfo = b;
 		}
 
+	///	sets if the multifrontal LU (true, default) or ILUT(0) is used for sparse matrices
+	/**
+	 * The multifrontal LU uses a nested dissection ordering and reuses the
+	 * ordering and symbolic factorization if only the values of the matrix
+	 * changed since the last init. The setting of set_sort_sparse is only
+	 * used by ILUT(0).
+	 */
+		void set_multifrontal(bool b)
+		{
+			m_bMultifrontal = b;
+		}
+
 		virtual const char* name() const {return "LU";}
 
 	private:
@@ -185,6 +202,14 @@ class LU
 				print_info(A);
 				UG_LOG("\n");
 			}
+
+			if(m_bMultifrontal)
+			{
+				m_multifrontal.set_info(m_bInfo);
+				m_multifrontal.init(A);
+				return true;
+			}
+
 			ilut_scalar = make_sp(new ILUTScalarPreconditioner<algebra_type>(0.0));
 			ilut_scalar->set_sort(m_bSortSparse);
 			ilut_scalar->set_info(m_bInfo);
@@ -221,6 +246,21 @@ class LU
 		bool solve_sparse(vector_type &x, const vector_type &b)
 		{
 			PROFILE_FUNC();
+			if(m_bMultifrontal)
+			{
+				m_vTmp.resize(m_size);
+				for(size_t i=0, k=0; i<b.size(); i++)
+					for(size_t j=0; j<GetSize(b[i]); j++)
+						m_vTmp[k++] = BlockRef(b[i],j);
+
+				m_multifrontal.solve(&m_vTmp[0], &m_vTmp[0]);
+
+				for(size_t i=0, k=0; i<x.size(); i++)
+					for(size_t j=0; j<GetSize(x[i]); j++)
+						BlockRef(x[i],j) = m_vTmp[k++];
+				return true;
+			}
+
 			ilut_scalar->solve(x, b);
 			return true;
 		}
@@ -380,6 +420,7 @@ class LU
 			ss << " Minimum Entries for Sparse LU: " << m_iMinimumForSparse;
 			if(m_iMinimumForSparse==0)
 				ss << " (= always Sparse LU)";
+			ss << "\n Sparse LU: " << (m_bMultifrontal ? "multifrontal" : "ILUT(0)");
 			return ss.str();
 		}
 
@@ -405,6 +446,11 @@ class LU
 		SmartPtr<ILUTScalarPreconditioner<algebra_type> > ilut_scalar;
 		size_t m_iMinimumForSparse;
 		bool m_bSortSparse, m_bInfo;
+
+	///	multifrontal sparse LU
+		bool m_bMultifrontal;
+		MultifrontalLU m_multifrontal;
+		std::vector<double> m_vTmp;
 };
 
 } // end namespace ug
@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include "multifrontal_lu.h"
+#include "common/nested_dissection.h"
+#include "common/profiler/profiler.h"
+#include "common/log.h"
+
+namespace ug{
+
+///	number of pivot columns processed at once in the dense kernels
+#define MFLU_PANEL_SIZE 64
+
+///	computes the elimination tree of a symmetric pattern (Liu's algorithm)
+/**
+ * \param[out]	vParent		parent of each index (n for roots)
+ * \param[in]	vvLower		for each index k the adjacent indices i < k
+ */
+static void ComputeEliminationTree(std::vector<size_t>& vParent,
+                                   const std::vector<std::vector<size_t> >& vvLower)
+{
+	const size_t n = vvLower.size();
+	vParent.assign(n, n);
+	std::vector<size_t> vAncestor(n, n);
+
+	for(size_t k = 0; k < n; ++k)
+		for(size_t j = 0; j < vvLower[k].size(); ++j)
+		{
+		//	climb up from i to the root of its current subtree
+			size_t i = vvLower[k][j];
+			while(vAncestor[i] != n && vAncestor[i] != k)
+			{
+				const size_t next = vAncestor[i];
+				vAncestor[i] = k;
+				i = next;
+			}
+			if(vAncestor[i] == n)
+			{
+				vAncestor[i] = k;
+				vParent[i] = k;
+			}
+		}
+}
+
+///	computes a postorder of a forest given by parents (n for roots)
+/**
+ * \param[out]	vPost		new number of each index
+ * \param[in]	vParent		parent of each index
+ */
+static void ComputePostorder(std::vector<size_t>& vPost, const std::vector<size_t>& vParent)
+{
+	const size_t n = vParent.size();
+	vPost.resize(n);
+
+//	children lists (first child, next sibling), children in increasing order
+	std::vector<size_t> vFirstChild(n, n), vNextSibling(n, n);
+	for(size_t k = n; k-- > 0; )
+		if(vParent[k] != n)
+		{
+			vNextSibling[k] = vFirstChild[vParent[k]];
+			vFirstChild[vParent[k]] = k;
+		}
+
+	size_t cnt = 0;
+	std::vector<size_t> vStack;
+	for(size_t root = 0; root < n; ++root)
+	{
+		if(vParent[root] != n) continue;
+		vStack.push_back(root);
+		while(!vStack.empty())
+		{
+			const size_t k = vStack.back();
+			const size_t child = vFirstChild[k];
+			if(child != n)
+			{
+			//	descend and remove child from list
+				vFirstChild[k] = vNextSibling[child];
+				vStack.push_back(child);
+			}
+			else
+			{
+				vPost[k] = cnt++;
+				vStack.pop_back();
+			}
+		}
+	}
+}
+
+///	position of a (new) index in the front of a supernode
+static size_t FrontPosition(const std::vector<size_t>& vRow, size_t first, size_t num, size_t i)
+{
+	if(i >= first && i < first + num) return i - first;
+	std::vector<size_t>::const_iterator it = std::lower_bound(vRow.begin(), vRow.end(), i);
+	UG_ASSERT(it != vRow.end() && *it == i, "MultifrontalLU: index "<<i<<" not in front.");
+	return num + (it - vRow.begin());
+}
+
+bool MultifrontalLU::same_pattern(const std::vector<size_t>& vRowStart,
+                                  const std::vector<size_t>& vColInd) const
+{
+	return m_vRowStart == vRowStart && m_vColInd == vColInd;
+}
+
+void MultifrontalLU::analyze(size_t n, const std::vector<size_t>& vRowStart,
+                             const std::vector<size_t>& vColInd)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(vRowStart.size() != n+1, "MultifrontalLU: wrong size of row start array.");
+
+	m_n = n;
+	m_vRowStart = vRowStart;
+	m_vColInd = vColInd;
+	m_vSN.clear();
+	m_vvLevel.clear();
+	m_vNewIndex.clear();
+	if(n == 0) return;
+
+//	symmetrized adjacency without diagonal
+	std::vector<std::vector<size_t> > vvAdj(n);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t k = vRowStart[r]; k < vRowStart[r+1]; ++k)
+		{
+			const size_t c = vColInd[k];
+			if(c == r) continue;
+			vvAdj[r].push_back(c);
+			vvAdj[c].push_back(r);
+		}
+	for(size_t r = 0; r < n; ++r)
+	{
+		std::sort(vvAdj[r].begin(), vvAdj[r].end());
+		vvAdj[r].erase(std::unique(vvAdj[r].begin(), vvAdj[r].end()), vvAdj[r].end());
+	}
+
+//	fill-reducing ordering
+	std::vector<size_t> vND;
+	ComputeNestedDissectionOrder(vND, vvAdj, m_minNDSize);
+
+//	elimination tree of the reordered pattern
+	std::vector<std::vector<size_t> > vvLower(n);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t j = 0; j < vvAdj[r].size(); ++j)
+			if(vND[vvAdj[r][j]] < vND[r])
+				vvLower[vND[r]].push_back(vND[vvAdj[r][j]]);
+	std::vector<size_t> vParentND;
+	ComputeEliminationTree(vParentND, vvLower);
+
+//	postorder the tree, such that the supernodes are contiguous
+	std::vector<size_t> vPost;
+	ComputePostorder(vPost, vParentND);
+
+	m_vNewIndex.resize(n);
+	for(size_t i = 0; i < n; ++i) m_vNewIndex[i] = vPost[vND[i]];
+
+	std::vector<size_t> vParent(n, n);
+	for(size_t k = 0; k < n; ++k)
+		if(vParentND[k] != n) vParent[vPost[k]] = vPost[vParentND[k]];
+
+//	upper adjacency (indices i > k) in the final ordering
+	std::vector<std::vector<size_t> > vvUpper(n);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t j = 0; j < vvAdj[r].size(); ++j)
+			if(m_vNewIndex[vvAdj[r][j]] > m_vNewIndex[r])
+				vvUpper[m_vNewIndex[r]].push_back(m_vNewIndex[vvAdj[r][j]]);
+	vvAdj.clear(); vvLower.clear();
+
+	std::vector<std::vector<size_t> > vvChild(n);
+	for(size_t k = 0; k < n; ++k)
+		if(vParent[k] != n) vvChild[vParent[k]].push_back(k);
+
+//	column structures of L (rows below the diagonal). A structure is kept
+//	until the parent column has been computed. Columns are grouped to a
+//	supernode, if the previous column is the only child and has the same
+//	structure (plus the diagonal).
+	std::vector<std::vector<size_t> > vvStruct(n);
+	std::vector<size_t> vMark(n, n);
+	std::vector<size_t> vColToSN(n);
+	size_t first = 0;
+	for(size_t k = 0; k < n; ++k)
+	{
+		std::vector<size_t>& vStruct = vvStruct[k];
+		vMark[k] = k;
+		for(size_t j = 0; j < vvUpper[k].size(); ++j)
+		{
+			const size_t i = vvUpper[k][j];
+			if(vMark[i] != k) {vMark[i] = k; vStruct.push_back(i);}
+		}
+		for(size_t c = 0; c < vvChild[k].size(); ++c)
+		{
+			const std::vector<size_t>& vChildStruct = vvStruct[vvChild[k][c]];
+			for(size_t j = 0; j < vChildStruct.size(); ++j)
+			{
+				const size_t i = vChildStruct[j];
+				if(vMark[i] != k) {vMark[i] = k; vStruct.push_back(i);}
+			}
+		}
+		std::sort(vStruct.begin(), vStruct.end());
+
+		const bool bJoin = k > 0 && vParent[k-1] == k && vvChild[k].size() == 1
+							&& vvStruct[k-1].size() == vStruct.size() + 1;
+		if(k > 0 && !bJoin)
+		{
+			m_vSN.push_back(Supernode());
+			m_vSN.back().first = first;
+			m_vSN.back().num = k - first;
+			m_vSN.back().vRow = vvStruct[k-1];
+			first = k;
+		}
+		vColToSN[k] = m_vSN.size();
+
+		for(size_t c = 0; c < vvChild[k].size(); ++c)
+			std::vector<size_t>().swap(vvStruct[vvChild[k][c]]);
+	}
+	m_vSN.push_back(Supernode());
+	m_vSN.back().first = first;
+	m_vSN.back().num = n - first;
+	m_vSN.back().vRow = vvStruct[n-1];
+	vvStruct.clear();
+
+//	tree of supernodes and positions of the children rows in the parent front
+	for(size_t s = 0; s < m_vSN.size(); ++s)
+	{
+		Supernode& sn = m_vSN[s];
+		const size_t p = vParent[sn.first + sn.num - 1];
+		sn.parent = (p == n) ? -1 : (int)vColToSN[p];
+		if(sn.parent < 0) continue;
+
+		Supernode& par = m_vSN[sn.parent];
+		par.vChild.push_back(s);
+		sn.vRelIdx.resize(sn.vRow.size());
+		for(size_t i = 0; i < sn.vRow.size(); ++i)
+			sn.vRelIdx[i] = FrontPosition(par.vRow, par.first, par.num, sn.vRow[i]);
+	}
+
+//	positions of the matrix entries in the fronts
+	for(size_t r = 0; r < n; ++r)
+		for(size_t k = vRowStart[r]; k < vRowStart[r+1]; ++k)
+		{
+			const size_t nr = m_vNewIndex[r], nc = m_vNewIndex[vColInd[k]];
+			Supernode& sn = m_vSN[vColToSN[std::min(nr, nc)]];
+			const size_t m = sn.front_size();
+			sn.vAssembleVal.push_back(k);
+			sn.vAssemblePos.push_back(FrontPosition(sn.vRow, sn.first, sn.num, nr)
+							+ m * FrontPosition(sn.vRow, sn.first, sn.num, nc));
+		}
+
+//	group supernodes by height (children are always numbered before parents)
+	std::vector<size_t> vHeight(m_vSN.size(), 0);
+	for(size_t s = 0; s < m_vSN.size(); ++s)
+	{
+		for(size_t c = 0; c < m_vSN[s].vChild.size(); ++c)
+			vHeight[s] = std::max(vHeight[s], vHeight[m_vSN[s].vChild[c]] + 1);
+		if(vHeight[s] >= m_vvLevel.size()) m_vvLevel.resize(vHeight[s] + 1);
+		m_vvLevel[vHeight[s]].push_back(s);
+	}
+
+	if(m_bInfo)
+	{
+		size_t nnzL = 0, maxFront = 0;
+		for(size_t s = 0; s < m_vSN.size(); ++s)
+		{
+			const Supernode& sn = m_vSN[s];
+			nnzL += sn.num * (sn.num + 1) / 2 + sn.num * sn.vRow.size();
+			maxFront = std::max(maxFront, sn.front_size());
+		}
+		UG_LOG("MultifrontalLU: " << n << " unknowns, " << m_vSN.size()
+		       << " supernodes, " << m_vvLevel.size() << " levels, max. front size "
+		       << maxFront << ", nnz(L+U) = " << 2*nnzL - n << "\n");
+	}
+}
+
+bool MultifrontalLU::factorize_supernode(Supernode& sn, const std::vector<double>& vValue)
+{
+	const size_t p = sn.num, r = sn.vRow.size(), m = p + r;
+
+//	assemble front from matrix entries and contribution blocks of the children
+	std::vector<double>& F = sn.vL;
+	F.assign(m*m, 0.0);
+	for(size_t a = 0; a < sn.vAssembleVal.size(); ++a)
+		F[sn.vAssemblePos[a]] += vValue[sn.vAssembleVal[a]];
+
+	for(size_t c = 0; c < sn.vChild.size(); ++c)
+	{
+		Supernode& child = m_vSN[sn.vChild[c]];
+		const size_t rc = child.vRow.size();
+		for(size_t j = 0; j < rc; ++j)
+		{
+			double* col = &F[child.vRelIdx[j] * m];
+			const double* cb = &child.vCB[j * rc];
+			for(size_t i = 0; i < rc; ++i)
+				col[child.vRelIdx[i]] += cb[i];
+		}
+		std::vector<double>().swap(child.vCB);
+	}
+
+//	eliminate the pivots: L11\U11 and L21 in the first p columns, U12 in the
+//	first p rows of the remaining columns. The pivots are processed in panels
+//	of MFLU_PANEL_SIZE columns, such that every other column is loaded once
+//	per panel only.
+	for(size_t k0 = 0; k0 < p; k0 += MFLU_PANEL_SIZE)
+	{
+		const size_t k1 = std::min(k0 + MFLU_PANEL_SIZE, p);
+
+	//	factorize panel
+		for(size_t k = k0; k < k1; ++k)
+		{
+			double* colK = &F[k*m];
+			const double piv = colK[k];
+			if(piv == 0.0) return false;
+
+			for(size_t i = k+1; i < m; ++i) colK[i] /= piv;
+
+			for(size_t j = k+1; j < k1; ++j)
+			{
+				double* colJ = &F[j*m];
+				const double ukj = colJ[k];
+				if(ukj == 0.0) continue;
+				for(size_t i = k+1; i < m; ++i)
+					colJ[i] -= colK[i] * ukj;
+			}
+		}
+
+	//	update the remaining columns by the panel (rows of the contribution
+	//	block are updated later)
+#ifdef UG_OPENMP
+		#pragma omp parallel for schedule(static) if(m - k1 >= 256)
+#endif
+		for(size_t j = k1; j < m; ++j)
+		{
+			double* colJ = &F[j*m];
+			const size_t iEnd = (j < p) ? m : p;
+			for(size_t k = k0; k < k1; ++k)
+			{
+				const double ukj = colJ[k];
+				if(ukj == 0.0) continue;
+				const double* colK = &F[k*m];
+				for(size_t i = k+1; i < iEnd; ++i)
+					colJ[i] -= colK[i] * ukj;
+			}
+		}
+	}
+
+//	copy U12
+	sn.vU.resize(p*r);
+	for(size_t j = 0; j < r; ++j)
+		for(size_t k = 0; k < p; ++k)
+			sn.vU[k + j*p] = F[k + (p+j)*m];
+
+//	contribution block: F22 - L21 * U12, with the columns of L21 processed in
+//	panels, such that a panel stays in cache for all columns of the block
+	sn.vCB.resize(r*r);
+	for(size_t j = 0; j < r; ++j)
+		for(size_t i = 0; i < r; ++i)
+			sn.vCB[i + j*r] = F[p + i + (p+j)*m];
+
+	for(size_t k0 = 0; k0 < p; k0 += MFLU_PANEL_SIZE)
+	{
+		const size_t k1 = std::min(k0 + MFLU_PANEL_SIZE, p);
+#ifdef UG_OPENMP
+		#pragma omp parallel for schedule(static) if(r >= 256)
+#endif
+		for(size_t j = 0; j < r; ++j)
+		{
+			double* cb = &sn.vCB[j*r];
+			const double* u = &sn.vU[j*p];
+			size_t k = k0;
+
+		//	four columns at once, to reduce the loads and stores of cb
+			for(; k + 4 <= k1; k += 4)
+			{
+				const double u0 = u[k], u1 = u[k+1], u2 = u[k+2], u3 = u[k+3];
+				const double* l0 = &F[p + k*m];
+				const double* l1 = l0 + m;
+				const double* l2 = l1 + m;
+				const double* l3 = l2 + m;
+				for(size_t i = 0; i < r; ++i)
+					cb[i] -= l0[i]*u0 + l1[i]*u1 + l2[i]*u2 + l3[i]*u3;
+			}
+			for(; k < k1; ++k)
+			{
+				const double ukj = u[k];
+				const double* l21 = &F[p + k*m];
+				for(size_t i = 0; i < r; ++i)
+					cb[i] -= l21[i] * ukj;
+			}
+		}
+	}
+
+//	keep only the first p columns of the front
+	std::vector<double>(F.begin(), F.begin() + m*p).swap(F);
+	return true;
+}
+
+void MultifrontalLU::factorize(const std::vector<double>& vValue)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(vValue.size() != m_vColInd.size(),
+	              "MultifrontalLU: number of values does not match analyzed pattern.");
+
+	bool bZeroPivot = false;
+	for(size_t lev = 0; lev < m_vvLevel.size(); ++lev)
+	{
+		const std::vector<size_t>& vLevel = m_vvLevel[lev];
+#ifdef UG_OPENMP
+		#pragma omp parallel for schedule(dynamic) if(vLevel.size() > 1)
+#endif
+		for(size_t i = 0; i < vLevel.size(); ++i)
+		{
+			if(!factorize_supernode(m_vSN[vLevel[i]], vValue))
+			{
+#ifdef UG_OPENMP
+				#pragma omp critical
+#endif
+				bZeroPivot = true;
+			}
+		}
+		UG_COND_THROW(bZeroPivot, "MultifrontalLU: zero pivot. The matrix is "
+		              "singular or needs pivoting.");
+	}
+}
+
+void MultifrontalLU::solve(double* x, const double* b) const
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	if(m_n == 0) return;
+
+	std::vector<double> y(m_n);
+	for(size_t i = 0; i < m_n; ++i) y[m_vNewIndex[i]] = b[i];
+
+//	forward substitution with L (unit diagonal)
+	for(size_t s = 0; s < m_vSN.size(); ++s)
+	{
+		const Supernode& sn = m_vSN[s];
+		const size_t p = sn.num, r = sn.vRow.size(), m = p + r;
+		for(size_t k = 0; k < p; ++k)
+		{
+			const double yk = y[sn.first + k];
+			if(yk == 0.0) continue;
+			const double* colK = &sn.vL[k*m];
+			for(size_t i = k+1; i < p; ++i) y[sn.first + i] -= colK[i] * yk;
+			for(size_t i = 0; i < r; ++i) y[sn.vRow[i]] -= colK[p+i] * yk;
+		}
+	}
+
+//	backward substitution with U
+	for(size_t s = m_vSN.size(); s-- > 0; )
+	{
+		const Supernode& sn = m_vSN[s];
+		const size_t p = sn.num, r = sn.vRow.size(), m = p + r;
+		for(size_t k = p; k-- > 0; )
+		{
+			double sum = y[sn.first + k];
+			for(size_t j = k+1; j < p; ++j) sum -= sn.vL[k + j*m] * y[sn.first + j];
+			for(size_t j = 0; j < r; ++j) sum -= sn.vU[k + j*p] * y[sn.vRow[j]];
+			y[sn.first + k] = sum / sn.vL[k + k*m];
+		}
+	}
+
+	for(size_t i = 0; i < m_n; ++i) x[i] = y[m_vNewIndex[i]];
+}
+
+size_t MultifrontalLU::num_factor_entries() const
+{
+	size_t num = 0;
+	for(size_t s = 0; s < m_vSN.size(); ++s)
+		num += m_vSN[s].vL.size() + m_vSN[s].vU.size();
+	return num;
+}
+
+} // end namespace ug
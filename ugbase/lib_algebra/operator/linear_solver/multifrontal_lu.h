@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__MULTIFRONTAL_LU__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__MULTIFRONTAL_LU__
+
+#include <vector>
+#include "common/common.h"
+#include "common/error.h"
+#include "lib_algebra/small_algebra/small_algebra.h"
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	sparse direct LU factorization by the multifrontal method
+/**
+ * This class computes the LU factorization of a sparse (scalar) matrix in
+ * three phases:
+ *
+ * - ordering: The indices are reordered by nested dissection
+ *   (ComputeNestedDissectionOrder) on the symmetrized pattern A + A^T and the
+ *   resulting elimination tree is postordered.
+ * - symbolic factorization: The nonzero structure of the factors is computed
+ *   and the columns with identical structure are grouped to supernodes. For
+ *   every supernode the index set of its frontal matrix and the positions of
+ *   the matrix entries and of the contribution blocks of its children in the
+ *   front are precomputed.
+ * - numeric factorization: For every supernode the dense frontal matrix is
+ *   assembled from the matrix entries and the contribution blocks of the
+ *   children, the pivots of the supernode are eliminated and the remaining
+ *   Schur complement is passed as contribution block to the parent.
+ *   Supernodes of the same height in the elimination tree are independent
+ *   and are factorized thread-parallel (UG_OPENMP).
+ *
+ * The first two phases only depend on the sparsity pattern and are skipped
+ * in init() if the pattern did not change since the last call.
+ *
+ * No pivoting is performed, i.e. the factorization works for matrices whose
+ * LU factorization exists in the chosen ordering (e.g. symmetric positive
+ * definite or diagonally dominant matrices). A zero pivot leads to an
+ * exception.
+ */
+class MultifrontalLU
+{
+	public:
+		MultifrontalLU() : m_n(0), m_minNDSize(64), m_bInfo(false) {}
+
+	///	sets the size of subgraphs not further split by nested dissection
+		void set_min_dissection_size(size_t minSize) {m_minNDSize = minSize;}
+
+	///	enables output of statistics
+		void set_info(bool bInfo) {m_bInfo = bInfo;}
+
+	///	factorizes a sparse matrix with static block entries
+	/**
+	 * The block entries are expanded to a scalar matrix. The ordering and
+	 * the symbolic factorization are reused if the pattern did not change.
+	 */
+		template <typename TMatrix>
+		void init(const TMatrix& A)
+		{
+			typedef typename TMatrix::value_type block_type;
+			const size_t nb = block_traits<block_type>::static_num_rows;
+			UG_COND_THROW(nb != block_traits<block_type>::static_num_cols,
+			              "MultifrontalLU: only square blocks supported.");
+
+			const size_t n = A.num_rows() * nb;
+			std::vector<size_t> vRowStart(n+1), vColInd;
+			std::vector<double> vValue;
+			vColInd.reserve(A.total_num_connections() * nb * nb);
+			vValue.reserve(A.total_num_connections() * nb * nb);
+
+			vRowStart[0] = 0;
+			for(size_t r = 0; r < A.num_rows(); ++r)
+				for(size_t r2 = 0; r2 < nb; ++r2)
+				{
+					for(typename TMatrix::const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it)
+						for(size_t c2 = 0; c2 < nb; ++c2)
+						{
+							vColInd.push_back(it.index() * nb + c2);
+							vValue.push_back(BlockRef(it.value(), r2, c2));
+						}
+					vRowStart[r*nb + r2 + 1] = vColInd.size();
+				}
+
+			if(!same_pattern(vRowStart, vColInd))
+				analyze(n, vRowStart, vColInd);
+			factorize(vValue);
+		}
+
+	///	computes ordering and symbolic factorization for a pattern in CSR format
+		void analyze(size_t n, const std::vector<size_t>& vRowStart,
+		             const std::vector<size_t>& vColInd);
+
+	///	returns if the pattern equals the one of the last analyze()
+		bool same_pattern(const std::vector<size_t>& vRowStart,
+		                  const std::vector<size_t>& vColInd) const;
+
+	///	computes the numeric factorization for the values of the analyzed pattern
+		void factorize(const std::vector<double>& vValue);
+
+	///	solves A*x = b (x and b of size num_rows(), may be the same)
+		void solve(double* x, const double* b) const;
+
+	///	number of rows of the factorized matrix
+		size_t num_rows() const {return m_n;}
+
+	///	number of supernodes
+		size_t num_supernodes() const {return m_vSN.size();}
+
+	///	number of entries stored for the factors L and U
+		size_t num_factor_entries() const;
+
+	protected:
+	///	supernode: columns [first, first+num) with identical structure
+		struct Supernode
+		{
+		///	first column (in new indices) and number of columns
+			size_t first, num;
+
+		///	row indices below the pivot block (in new indices, sorted)
+			std::vector<size_t> vRow;
+
+		///	parent supernode (or -1) and children
+			int parent;
+			std::vector<size_t> vChild;
+
+		///	positions of vRow in the front of the parent
+			std::vector<size_t> vRelIdx;
+
+		///	matrix entries assembled into the front: value index and position
+			std::vector<size_t> vAssembleVal;
+			std::vector<size_t> vAssemblePos;
+
+		///	front size
+			size_t front_size() const {return num + vRow.size();}
+
+		///	factor: first num columns of the front (L11\U11 and L21), column-major
+			std::vector<double> vL;
+
+		///	factor: U12 (num x vRow.size()), column-major
+			std::vector<double> vU;
+
+		///	contribution block (vRow.size() x vRow.size()), column-major
+			std::vector<double> vCB;
+		};
+
+	///	factorizes one supernode, returns false on zero pivot
+		bool factorize_supernode(Supernode& sn, const std::vector<double>& vValue);
+
+	protected:
+	///	number of rows
+		size_t m_n;
+
+	///	new index for each old index
+		std::vector<size_t> m_vNewIndex;
+
+	///	pattern of the last analysis
+		std::vector<size_t> m_vRowStart, m_vColInd;
+
+	///	supernodes in postorder and supernodes grouped by height in the tree
+		std::vector<Supernode> m_vSN;
+		std::vector<std::vector<size_t> > m_vvLevel;
+
+	///	options
+		size_t m_minNDSize;
+		bool m_bInfo;
+};
+
+// end group lib_algebra
+///	@}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__MULTIFRONTAL_LU__ */
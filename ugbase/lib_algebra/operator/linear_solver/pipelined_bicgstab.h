@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__
+
+#include <iostream>
+#include <string>
+#include <sstream>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/linear_solver_profiling.h"
+#include "lib_algebra/algebra_common/fused_reduction.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined BiCGStab method as a solver for linear operators
+/**
+ * This class implements the pipelined BiCGStab - method with right
+ * preconditioning for the solution of linear operator problems like A*x = b.
+ *
+ * Mathematically, the method is equivalent to the right preconditioned
+ * BiCGStab method. The recurrences are rearranged, such that each iteration
+ * needs only two global reductions (instead of four in BiCGStab), each
+ * summing up all needed scalar products at once. The reductions are
+ * non-blocking and overlapped with an application of the preconditioner and
+ * a matrix-vector product. The convergence check uses the defect norm
+ * computed within the second reduction. This comes at the cost of ten
+ * additional vectors and additional vector updates.
+ *
+ * Since the defect is only updated recursively, it may deviate from the true
+ * defect b - A*x, in particular if the defect norm grows strongly during the
+ * iteration. With set_restart(n), the defect is recomputed from the current
+ * iterate every n iterations and the method is restarted, which bounds this
+ * deviation (at the cost of one additional matrix-vector product and one
+ * additional reduction per restart). By default, the method is restarted
+ * every 50 iterations.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Cools, Vanroose, "The communication-hiding pipelined BiCGStab method for
+ *   the parallel solution of large unsymmetric linear systems", Parallel
+ *   Computing 65 (2017), p.1-20, Alg. 4
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipelinedBiCGStab
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+
+	public:
+	///	constructors
+		PipelinedBiCGStab() : base_type(), m_numRestarts(50) {}
+
+		PipelinedBiCGStab(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond ), m_numRestarts(50)  {}
+
+		PipelinedBiCGStab(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck), m_numRestarts(50)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipelinedBiCGStab";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	// 	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			LS_PROFILE_BEGIN(LS_ApplyReturnDefect);
+
+		//	check correct storage type in parallel
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedBiCGStab: Inadequate storage format of Vectors.");
+			#endif
+
+		//	remember right-hand side for restarts with the true defect
+			SmartPtr<vector_type> spB;
+			if(m_numRestarts > 0) spB = b.clone();
+
+		// 	build defect:  r := b - A*x
+			linear_operator()->apply_sub(b, x);
+			vector_type& r = b;
+
+		// 	create vectors. The vectors with suffix 'h' are preconditioned
+		//	(consistent), i.e. rh = M^-1 r, the others are images of A (additive).
+			SmartPtr<vector_type> spRt = r.clone_without_values(); vector_type& rt = *spRt;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spT = r.clone_without_values(); vector_type& t = *spT;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+			SmartPtr<vector_type> spV = r.clone_without_values(); vector_type& v = *spV;
+			SmartPtr<vector_type> spQ = r.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spY = r.clone_without_values(); vector_type& y = *spY;
+			SmartPtr<vector_type> spRh = x.clone_without_values(); vector_type& rh = *spRh;
+			SmartPtr<vector_type> spWh = x.clone_without_values(); vector_type& wh = *spWh;
+			SmartPtr<vector_type> spPh = x.clone_without_values(); vector_type& ph = *spPh;
+			SmartPtr<vector_type> spSh = x.clone_without_values(); vector_type& sh = *spSh;
+			SmartPtr<vector_type> spZh = x.clone_without_values(); vector_type& zh = *spZh;
+			SmartPtr<vector_type> spQh = x.clone_without_values(); vector_type& qh = *spQh;
+
+		//	make r unique for the norm and use it as consistent shadow defect
+			#ifdef UG_PARALLEL
+			if(!r.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipelinedBiCGStab: Cannot convert r to unique vector.");
+			#endif
+			rt = r;
+			#ifdef UG_PARALLEL
+			if(!rt.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedBiCGStab: Cannot convert rt to consistent vector.");
+			#endif
+
+		//	prepare convergence check
+			prepare_conv_check();
+
+		//	needed variables
+			FusedReduction<vector_type> red;
+			size_t iNorm = 0, iRho = 0, iRW = 0;
+			number rho = 1, alpha = 1, beta = 0, omega = 1;
+
+		//	the fused defect norm can only be used if the convergence check
+		//	does not need more than the norm
+			const bool bNormOnly = convergence_check()->uses_two_norm_only();
+
+		//	restart flag (set to true at first run)
+			bool bRestart = true;
+
+		// 	Iteration loop
+			for(size_t iter = 0; ; ++iter)
+			{
+			//	check for restart based on fixed step number restart
+				if(m_numRestarts > 0 && iter > 0 && iter % (size_t)m_numRestarts == 0)
+				{
+					std::stringstream ss; ss <<
+					"Restarting: at every "<<m_numRestarts<<" Iterations";
+					convergence_check()->print_line(ss.str());
+
+				//	replace the recursively updated defect by the true defect
+					r = *spB;
+					linear_operator()->apply_sub(r, x);
+					#ifdef UG_PARALLEL
+					if(!r.change_storage_type(PST_UNIQUE))
+						UG_THROW("PipelinedBiCGStab: Cannot convert r to unique vector.");
+					#endif
+					bRestart = true;
+				}
+
+			//	compute start values
+				if(bRestart)
+				{
+				//	rh := M^-1 r, w := A*rh
+					if(!precondition(rh, r)) return false;
+					linear_operator()->apply(w, rh);
+
+				//	start reduction of ||r||, (rt,r) and (rt,w)
+					red.clear();
+					iNorm = red.add_norm_squared(r);
+					iRho = red.add_dotprod(rt, r);
+					iRW = red.add_dotprod(rt, w);
+					red.start();
+
+				//	wh := M^-1 w, t := A*wh (overlapped with the reduction)
+					if(!precondition(wh, w)) return false;
+					linear_operator()->apply(t, wh);
+
+					red.finish();
+
+				//	compute start defect norm
+					if(iter == 0)
+					{
+						if(bNormOnly) convergence_check()->start_defect(red.norm(iNorm));
+						else convergence_check()->start(r);
+						if(convergence_check()->iteration_ended()) break;
+					}
+
+				//	alpha = (rt,r) / (rt,w)
+					rho = red.value(iRho);
+					if(red.value(iRW) == 0.0)
+					{
+						UG_LOG("PipelinedBiCGStab: Method breakdown with (rt,w) = 0. "
+								"Aborting iteration.\n");
+						return false;
+					}
+					alpha = rho / red.value(iRW);
+
+				//	start search directions
+					ph = rh; s = w; sh = wh; z = t;
+
+				//	remove restart flag
+					bRestart = false;
+				}
+				else
+				{
+				//	ph := rh + beta * (ph - omega * sh)
+					VecScaleAdd(ph, 1.0, rh, beta, ph, -beta*omega, sh);
+				//	s := w + beta * (s - omega * z)
+					VecScaleAdd(s, 1.0, w, beta, s, -beta*omega, z);
+				//	sh := wh + beta * (sh - omega * zh)
+					VecScaleAdd(sh, 1.0, wh, beta, sh, -beta*omega, zh);
+				//	z := t + beta * (z - omega * v)
+					VecScaleAdd(z, 1.0, t, beta, z, -beta*omega, v);
+				}
+
+			//	q := r - alpha * s, qh := rh - alpha * sh, y := w - alpha * z
+				VecScaleAdd(q, 1.0, r, -alpha, s);
+				VecScaleAdd(qh, 1.0, rh, -alpha, sh);
+				VecScaleAdd(y, 1.0, w, -alpha, z);
+
+			//	make q and y unique (only neighbor communication)
+				#ifdef UG_PARALLEL
+				if(!q.change_storage_type(PST_UNIQUE) || !y.change_storage_type(PST_UNIQUE))
+					UG_THROW("PipelinedBiCGStab: Cannot convert q, y to unique vector.");
+				#endif
+
+			//	start reduction of (q,y) and (y,y)
+				red.clear();
+				const size_t iQY = red.add_dotprod(q, y);
+				const size_t iYY = red.add_norm_squared(y);
+				red.start();
+
+			//	zh := M^-1 z, v := A*zh (overlapped with the reduction)
+				if(!precondition(zh, z)) return false;
+				linear_operator()->apply(v, zh);
+
+				red.finish();
+
+			//	omega = (q,y)/(y,y)
+				if(red.value(iYY) == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown with (y,y) = 0. "
+							"Aborting iteration.\n");
+					return false;
+				}
+				omega = red.value(iQY) / red.value(iYY);
+
+			//	x := x + alpha * ph + omega * qh
+				VecScaleAdd(x, 1.0, x, alpha, ph, omega, qh);
+
+			//	r := q - omega * y
+				VecScaleAdd(r, 1.0, q, -omega, y);
+
+			//	rh := qh - omega * (wh - alpha * zh)
+				VecScaleAdd(rh, 1.0, qh, -omega, wh, omega*alpha, zh);
+
+			//	w := y - omega * (t - alpha * v)
+				VecScaleAdd(w, 1.0, y, -omega, t, omega*alpha, v);
+
+			//	start reduction of ||r||, (rt,r), (rt,w), (rt,s) and (rt,z)
+				red.clear();
+				iNorm = red.add_norm_squared(r);
+				iRho = red.add_dotprod(rt, r);
+				iRW = red.add_dotprod(rt, w);
+				const size_t iRS = red.add_dotprod(rt, s);
+				const size_t iRZ = red.add_dotprod(rt, z);
+				red.start();
+
+			//	wh := M^-1 w, t := A*wh (overlapped with the reduction)
+				if(!precondition(wh, w)) return false;
+				linear_operator()->apply(t, wh);
+
+				red.finish();
+
+			//	check convergence
+				if(bNormOnly) convergence_check()->update_defect(red.norm(iNorm));
+				else convergence_check()->update(r);
+				if(convergence_check()->iteration_ended()) break;
+
+			//	check for breakdown
+				if(rho == 0.0 || omega == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown with rho = "<<rho<<
+						   ", omega = "<<omega<<". Aborting iteration.\n");
+					return false;
+				}
+
+			//	beta = (alpha/omega) * (rt,r_new)/(rt,r_old)
+				const number rhoNew = red.value(iRho);
+				beta = (alpha/omega) * (rhoNew/rho);
+				rho = rhoNew;
+
+			//	alpha = (rt,r) / ((rt,w) + beta * (rt,s) - beta * omega * (rt,z))
+				const number denom = red.value(iRW) + beta * red.value(iRS)
+										- beta * omega * red.value(iRZ);
+				if(denom == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown with (rt,A*ph) = 0. "
+							"Aborting iteration.\n");
+					return false;
+				}
+				alpha = rho / denom;
+			}
+
+		//	print ending output
+			return convergence_check()->post();
+		}
+
+	///	sets the number of iterations after which the method is restarted with the true defect (0 = never)
+		void set_restart(int numRestarts) {m_numRestarts = numRestarts;}
+
+	protected:
+	///	computes c := M^-1 d (or c := d without preconditioner) and makes c consistent
+		bool precondition(vector_type& c, const vector_type& d)
+		{
+			if(preconditioner().valid())
+			{
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("PipelinedBiCGStab: Cannot apply preconditioner. Aborting.\n");
+					return false;
+				}
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedBiCGStab: Cannot convert vector to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	prepares the output of the convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	protected:
+	///	restarts the method every n iterations (0 = never, default 50)
+		int m_numRestarts;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__ */
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__
+
+#include <iostream>
+#include <string>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/algebra_common/fused_reduction.h"
+#include "common/profiler/profiler.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined CG method as a solver for linear operators
+/**
+ * This class implements the pipelined preconditioned CG - method for the
+ * solution of linear operator problems like A*x = b.
+ *
+ * Mathematically, the method is equivalent to the CG method. The recurrences
+ * are rearranged, such that all scalar products (and the defect norm for the
+ * convergence check) of one iteration are summed up in a single non-blocking
+ * global reduction, which is overlapped with the application of the
+ * preconditioner and the matrix-vector product. This hides the latency of
+ * the reduction on large process counts at the cost of four additional
+ * vectors and additional vector updates. Due to the different recurrences,
+ * rounding errors propagate differently and the attainable accuracy may be
+ * slightly worse than the one of the standard CG method.
+ *
+ * If the convergence check only needs the defect norm, the norm is part of
+ * the fused reduction as well. Its result is then only known after the
+ * preconditioner and the matrix-vector product of the iteration have been
+ * applied, so the last iteration does this work without using it. For
+ * other convergence checks, the check is done at the beginning of each
+ * iteration with an own global reduction and no work is wasted.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Ghysels, Vanroose, "Hiding global synchronization latency in the
+ *   preconditioned Conjugate Gradient algorithm", Parallel Computing 40 (2014),
+ *   p.224-238, Alg. 4
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipelinedCG
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+
+	public:
+	///	constructors
+		PipelinedCG() : base_type() {}
+
+		PipelinedCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond )  {}
+
+		PipelinedCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipelinedCG";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	///	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(PipelinedCG_apply_return_defect, "CG algebra");
+		//	check parallel storage types
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedCG::apply_return_defect:"
+								"Inadequate storage format of Vectors.");
+			#endif
+
+		// 	rename r as b (for convenience)
+			vector_type& r = b;
+
+		// 	Build defect:  r := b - J(u)*x
+			linear_operator()->apply_sub(r, x);
+
+		// 	create help vectors (consistent: u, m, p, q; additive: w, n, s, z)
+			SmartPtr<vector_type> spU = x.clone_without_values(); vector_type& u = *spU;
+			SmartPtr<vector_type> spM = x.clone_without_values(); vector_type& m = *spM;
+			SmartPtr<vector_type> spP = x.clone_without_values(); vector_type& p = *spP;
+			SmartPtr<vector_type> spQ = x.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spN = r.clone_without_values(); vector_type& n = *spN;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+
+		// 	u := M^-1 r, w := A*u
+			if(!precondition(u, r)) return false;
+			linear_operator()->apply(w, u);
+
+		//	prepare output of convergence check
+			prepare_conv_check();
+
+			FusedReduction<vector_type> red;
+			number gammaOld = 0.0, alphaOld = 0.0;
+
+		//	the fused defect norm can only be used if the convergence check
+		//	does not need more than the norm
+			const bool bNormOnly = convergence_check()->uses_two_norm_only();
+
+		// 	Iteration loop
+			for(size_t iter = 0; ; ++iter)
+			{
+			//	make r unique, needed for the norm (only neighbor communication)
+				#ifdef UG_PARALLEL
+				if(!r.change_storage_type(PST_UNIQUE))
+					UG_THROW("PipelinedCG::apply_return_defect: "
+									"Cannot convert r to unique vector.");
+				#endif
+
+			//	without the fused norm, the convergence check reduces on its own
+			//	and is done before the work of the iteration
+				if(!bNormOnly)
+				{
+					if(iter == 0) convergence_check()->start(r);
+					else convergence_check()->update(r);
+					if(convergence_check()->iteration_ended()) break;
+				}
+
+			//	start reduction of ||r||, gamma = (r,u) and delta = (w,u)
+				red.clear();
+				const size_t iNorm = bNormOnly ? red.add_norm_squared(r) : 0;
+				const size_t iGamma = red.add_dotprod(r, u);
+				const size_t iDelta = red.add_dotprod(w, u);
+				red.start();
+
+			// 	m := M^-1 w, n := A*m (overlapped with the reduction)
+				if(!precondition(m, w)) return false;
+				linear_operator()->apply(n, m);
+
+			//	wait for reduction
+				red.finish();
+
+			// 	check convergence with the fused norm
+				if(bNormOnly)
+				{
+					if(iter == 0) convergence_check()->start_defect(red.norm(iNorm));
+					else convergence_check()->update_defect(red.norm(iNorm));
+					if(convergence_check()->iteration_ended()) break;
+				}
+
+			//	compute alpha and beta
+				const number gamma = red.value(iGamma);
+				const number delta = red.value(iDelta);
+				const number beta = (iter == 0) ? 0.0 : gamma / gammaOld;
+				const number lambda = (iter == 0) ? delta : delta - beta * gamma / alphaOld;
+
+			//	check lambda
+				if(lambda == 0.0)
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': lambda=" <<
+					       lambda<< " is not admitted. Aborting solver.\n");
+					return false;
+				}
+
+			//	alpha = gamma / (delta - beta * gamma / alphaOld)
+				const number alpha = gamma / lambda;
+
+			// 	update directions
+				if(iter == 0)
+				{
+					z = n; q = m; s = w; p = u;
+				}
+				else
+				{
+					VecScaleAdd(z, 1.0, n, beta, z);
+					VecScaleAdd(q, 1.0, m, beta, q);
+					VecScaleAdd(s, 1.0, w, beta, s);
+					VecScaleAdd(p, 1.0, u, beta, p);
+				}
+
+			// 	update solution, defect and auxiliary vectors
+				VecScaleAdd(x, 1.0, x, alpha, p);
+				VecScaleAdd(r, 1.0, r, -alpha, s);
+				VecScaleAdd(u, 1.0, u, -alpha, q);
+				VecScaleAdd(w, 1.0, w, -alpha, z);
+
+			// 	remember old values
+				gammaOld = gamma;
+				alphaOld = alpha;
+			}
+
+		//	post output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	computes c := M^-1 d (or c := d without preconditioner) and makes c consistent
+		bool precondition(vector_type& c, const vector_type& d)
+		{
+			if(preconditioner().valid())
+			{
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': "
+							"Cannot apply preconditioner. Aborting.\n");
+					return false;
+				}
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedCG::apply_return_defect: "
+								"Cannot convert vector to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	adjust output of convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__ */
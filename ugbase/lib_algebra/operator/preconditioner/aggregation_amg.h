@@ -0,0 +1,739 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__AGGREGATION_AMG__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__AGGREGATION_AMG__
+
+#include <vector>
+#include <cmath>
+
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/interface/linear_operator_inverse.h"
+#include "lib_algebra/algebra_common/sparsematrix_util.h"
+#include "lib_algebra/cpu_algebra/sparse_triple_product.h"
+#include "lib_algebra/operator/linear_solver/lu.h"
+#include "jacobi.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	Smoothed aggregation algebraic multigrid
+/**
+ * This class implements a smoothed aggregation AMG preconditioner, that only
+ * needs the assembled matrix of the fine level:
+ *
+ * - strong connections: j is strongly connected to i if
+ *   \f$ |a_{ij}| \geq \theta \sqrt{|a_{ii}| |a_{jj}|} \f$ (block norms).
+ * - aggregation: the three phases of Vanek, Mandel, Brezina. Nodes without
+ *   strong connections (e.g. Dirichlet rows) are not aggregated and left to
+ *   the smoother.
+ * - prolongation: the tentative, piecewise constant prolongation \f$ P_0 \f$
+ *   (identity blocks) is smoothed by one damped Jacobi step on the filtered
+ *   matrix, \f$ P = (I - \omega D^{-1} A^F) P_0 \f$, where weak connections
+ *   of \f$ A \f$ are lumped to the diagonal and \f$ \omega = 4/3 / \rho \f$
+ *   with a Gershgorin bound \f$ \rho \f$ for the spectral radius of
+ *   \f$ D^{-1} A \f$. D is the point diagonal of the matrix.
+ * - restriction \f$ R = P^T \f$, coarse operator \f$ A_c = R A P \f$
+ *   (SparseTripleProduct).
+ *
+ * The hierarchy is traversed by a V-cycle using clones of the smoother on all
+ * but the coarsest level, on which the base solver (default: LU) is applied.
+ *
+ * If the hierarchy is reused (set_reuse_hierarchy), a further preprocess for
+ * a matrix with the same sparsity pattern (e.g. in the next Newton step) only
+ * recomputes the prolongations, the numeric Galerkin products and the
+ * initialization of smoothers and base solver, while the aggregates and the
+ * patterns of the coarse operators are kept.
+ *
+ * In parallel, the AMG is applied to the process-local matrix, where the
+ * slave rows have been added to the master rows and replaced by Dirichlet
+ * rows (as done by ILUTScalar). Thus, coarsening is decoupled at process
+ * boundaries and no coarse level layouts are created.
+ *
+ * References:
+ * <ul>
+ * <li> P. Vanek, J. Mandel, M. Brezina. Algebraic multigrid by smoothed
+ * 		aggregation for second and fourth order elliptic problems.
+ * 		Computing 56 (1996), p.179-196
+ * </ul>
+ *
+ * \tparam 	TAlgebra	algebra type
+ */
+template <typename TAlgebra>
+class AggregationAMG : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix Operator type
+		typedef typename IPreconditioner<TAlgebra>::matrix_operator_type matrix_operator_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	protected:
+		typedef typename matrix_type::value_type block_type;
+		typedef typename matrix_type::connection connection;
+		typedef typename matrix_type::const_row_iterator const_row_iterator;
+
+	public:
+	///	default constructor
+		AggregationAMG()
+			: m_theta(0.08), m_omegaFactor(4.0/3.0), m_bSmoothP(true),
+			  m_maxLevels(20), m_maxBase(200), m_nu1(2), m_nu2(2),
+			  m_bReuse(false), m_bInfo(false), m_bDefaultBaseSolver(true)
+		{
+			m_spSmoother = make_sp(new Jacobi<TAlgebra>(0.66));
+			m_spBaseSolver = make_sp(new LU<TAlgebra>());
+		}
+
+	/// clone constructor
+	/**	The base solver stores the factorization of the coarsest level and is
+	 * therefore not shared with the parent: the default LU is created anew,
+	 * a solver set by set_base_solver is cloned if it supports cloning.*/
+		AggregationAMG(const AggregationAMG<TAlgebra> &parent)
+			: base_type(parent),
+			  m_theta(parent.m_theta), m_omegaFactor(parent.m_omegaFactor),
+			  m_bSmoothP(parent.m_bSmoothP),
+			  m_maxLevels(parent.m_maxLevels), m_maxBase(parent.m_maxBase),
+			  m_nu1(parent.m_nu1), m_nu2(parent.m_nu2),
+			  m_bReuse(parent.m_bReuse), m_bInfo(parent.m_bInfo),
+			  m_spSmoother(parent.m_spSmoother),
+			  m_bDefaultBaseSolver(parent.m_bDefaultBaseSolver)
+		{
+			if(m_bDefaultBaseSolver)
+				m_spBaseSolver = make_sp(new LU<TAlgebra>());
+			else
+				m_spBaseSolver = clone_base_solver(parent.m_spBaseSolver);
+		}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new AggregationAMG<algebra_type>(*this));
+		}
+
+	///	Destructor
+		virtual ~AggregationAMG() {}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	sets the smoother (cloned for each level, default: Jacobi(0.66))
+		void set_smoother(SmartPtr<ILinearIterator<vector_type> > smoother)
+		{
+			UG_COND_THROW(smoother.invalid(), "AggregationAMG: invalid smoother.");
+			m_spSmoother = smoother;
+		}
+
+	///	sets the solver on the coarsest level (default: LU)
+	/**	Clones of this preconditioner use a clone of the base solver. If the
+	 * solver does not support cloning, it is shared with the clones.*/
+		void set_base_solver(SmartPtr<ILinearOperatorInverse<vector_type> > baseSolver)
+		{
+			UG_COND_THROW(baseSolver.invalid(), "AggregationAMG: invalid base solver.");
+			m_spBaseSolver = baseSolver;
+			m_bDefaultBaseSolver = false;
+		}
+
+	///	sets the threshold theta for strong connections (default: 0.08)
+		void set_strong_connection_threshold(number theta) {m_theta = theta;}
+
+	///	sets the damping factor for the prolongation smoothing, omega = factor / rho (default: 4/3)
+		void set_prolongation_damping(number factor) {m_omegaFactor = factor;}
+
+	///	if false, the tentative (piecewise constant) prolongation is used (default: true)
+		void set_smooth_prolongation(bool b) {m_bSmoothP = b;}
+
+	///	sets the maximal number of levels (default: 20)
+		void set_max_levels(size_t maxLevels)
+		{
+			UG_COND_THROW(maxLevels == 0, "AggregationAMG: at least one level needed.");
+			m_maxLevels = maxLevels;
+		}
+
+	///	sets the size up to which a level is solved by the base solver (default: 200)
+		void set_max_base_size(size_t maxBase) {m_maxBase = maxBase;}
+
+	///	sets the number of pre-smoothing steps (default: 2)
+		void set_num_presmooth(size_t nu1) {m_nu1 = nu1;}
+
+	///	sets the number of post-smoothing steps (default: 2)
+		void set_num_postsmooth(size_t nu2) {m_nu2 = nu2;}
+
+	///	if true, the aggregates are reused for matrices of the same pattern (default: false)
+		void set_reuse_hierarchy(bool b) {m_bReuse = b;}
+
+	///	if true, the hierarchy is printed after setup (default: false)
+		void set_info(bool b) {m_bInfo = b;}
+
+	///	returns the number of levels of the current hierarchy
+		size_t num_levels() const {return m_vLevel.size();}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "AggregationAMG";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(AggregationAMG_preprocess, "algebra AggregationAMG");
+
+		//	get the matrix of the finest level
+			SmartPtr<MatrixOperator<matrix_type, vector_type> > spA0;
+			#ifdef UG_PARALLEL
+				SmartPtr<AlgebraLayouts> spLocalLayouts = CreateLocalAlgebraLayouts();
+				spA0 = make_sp(new MatrixOperator<matrix_type, vector_type>());
+				matrix_type& A0 = spA0->get_matrix();
+				A0 = *pOp;
+
+				MatAddSlaveRowsToMasterRowOverlap0(A0);
+
+			//	set Dirichlet rows on slaves
+				std::vector<IndexLayout::Element> vIndex;
+				CollectUniqueElements(vIndex, pOp->layouts()->slave());
+				SetDirichletRow(A0, vIndex);
+
+				A0.set_layouts(spLocalLayouts);
+				A0.set_storage_type(PST_ADDITIVE);
+			#else
+				spA0 = pOp;
+			#endif
+
+		//	check if the aggregates can be reused
+			const bool bReuse = m_bReuse && !m_vLevel.empty()
+								&& same_pattern(spA0->get_matrix());
+			if(!bReuse)
+			{
+				m_vLevel.clear();
+				m_vLevel.push_back(make_sp(new Level()));
+				store_pattern(spA0->get_matrix());
+			}
+			m_vLevel[0]->spA = spA0;
+
+		//	build the hierarchy
+			for(size_t lev = 0; ; ++lev)
+			{
+				Level& L = *m_vLevel[lev];
+				const matrix_type& A = L.spA->get_matrix();
+
+				if(!bReuse)
+				{
+					if(A.num_rows() <= m_maxBase || lev + 1 >= m_maxLevels) break;
+
+					L.numAgg = compute_aggregates(L.vAgg, A);
+					if(L.numAgg == 0 || L.numAgg >= A.num_rows()) break;
+
+					m_vLevel.push_back(make_sp(new Level()));
+				}
+				else if(lev + 1 == m_vLevel.size()) break;
+
+			//	prolongation, restriction and coarse operator
+				create_prolongation(L.P, A, L.vAgg, L.numAgg);
+				L.R.set_as_transpose_of(L.P);
+
+				Level& Lc = *m_vLevel[lev+1];
+				if(Lc.spA.invalid())
+					Lc.spA = make_sp(new MatrixOperator<matrix_type, vector_type>());
+				matrix_type& Ac = Lc.spA->get_matrix();
+				if(Ac.num_rows() == L.numAgg) Ac.set(0.0);
+				else Ac.resize_and_clear(L.numAgg, L.numAgg);
+				L.RAP.add_multiply_of(Ac, L.R, A, L.P);
+				#ifdef UG_PARALLEL
+					Ac.set_layouts(spLocalLayouts);
+					Ac.set_storage_type(PST_ADDITIVE);
+				#endif
+			}
+
+		//	init smoothers, base solver and level vectors
+			for(size_t lev = 0; lev < m_vLevel.size(); ++lev)
+			{
+				Level& L = *m_vLevel[lev];
+				const size_t n = L.spA->num_rows();
+				L.c.resize(n); L.d.resize(n); L.t.resize(n);
+				#ifdef UG_PARALLEL
+					L.c.set_layouts(spLocalLayouts);
+					L.d.set_layouts(spLocalLayouts);
+					L.t.set_layouts(spLocalLayouts);
+				#endif
+
+				if(lev + 1 == m_vLevel.size())
+				{
+					L.spSmoother = SPNULL;
+					if(!m_spBaseSolver->init(L.spA))
+					{
+						UG_LOG("ERROR in 'AggregationAMG::preprocess': "
+								"Cannot init base solver on level "<<lev<<".\n");
+						return false;
+					}
+				}
+				else
+				{
+					if(L.spSmoother.invalid())
+						L.spSmoother = m_spSmoother->clone();
+					if(!L.spSmoother->init(L.spA))
+					{
+						UG_LOG("ERROR in 'AggregationAMG::preprocess': "
+								"Cannot init smoother on level "<<lev<<".\n");
+						return false;
+					}
+				}
+			}
+
+			if(m_bInfo) print_hierarchy();
+			return true;
+		}
+
+	///	Stepping routine
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(AggregationAMG_step, "algebra AggregationAMG");
+
+		//	the local matrix needs a unique defect
+			#ifdef UG_PARALLEL
+				SmartPtr<vector_type> spDtmp = d.clone();
+				spDtmp->change_storage_type(PST_UNIQUE);
+				const vector_type& dIn = *spDtmp;
+			#else
+				const vector_type& dIn = d;
+			#endif
+
+			Level& L0 = *m_vLevel[0];
+			for(size_t i = 0; i < dIn.size(); ++i) L0.d[i] = dIn[i];
+			#ifdef UG_PARALLEL
+				L0.d.set_storage_type(PST_ADDITIVE);
+			#endif
+
+			if(!cycle(0)) return false;
+
+			for(size_t i = 0; i < c.size(); ++i) c[i] = L0.c[i];
+
+		//	the local corrections are additive
+			#ifdef UG_PARALLEL
+				c.set_storage_type(PST_ADDITIVE);
+				c.change_storage_type(PST_CONSISTENT);
+			#endif
+
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	data of one level of the hierarchy
+		struct Level
+		{
+			Level() : numAgg(0) {}
+
+		///	matrix of the level
+			SmartPtr<MatrixOperator<matrix_type, vector_type> > spA;
+
+		///	prolongation from and restriction to the next coarser level
+			matrix_type P, R;
+
+		///	Galerkin product R*A*P, the pattern is kept if the hierarchy is reused
+			SparseTripleProduct<matrix_type> RAP;
+
+		///	aggregate of each node (-1 if not aggregated) and number of aggregates
+			std::vector<int> vAgg;
+			size_t numAgg;
+
+		///	smoother of the level (invalid on the coarsest level)
+			SmartPtr<ILinearIterator<vector_type> > spSmoother;
+
+		///	correction, defect and help vector
+			vector_type c, d, t;
+		};
+
+	///	applies a V-cycle on level lev to L.d, result in L.c, L.d is updated
+		bool cycle(size_t lev)
+		{
+			Level& L = *m_vLevel[lev];
+			vector_type& c = L.c;
+			vector_type& d = L.d;
+
+		//	coarsest level
+			if(lev + 1 == m_vLevel.size())
+			{
+				c.set(0.0);
+				if(!m_spBaseSolver->apply(c, d))
+				{
+					UG_LOG("ERROR in 'AggregationAMG::step': "
+							"Base solver failed on level "<<lev<<".\n");
+					return false;
+				}
+				return true;
+			}
+
+			const matrix_type& A = L.spA->get_matrix();
+			Level& Lc = *m_vLevel[lev+1];
+
+			c.set(0.0);
+
+		//	presmooth
+			if(!smooth(L, m_nu1)) return false;
+
+		//	restrict defect
+			L.R.axpy(Lc.d, 0.0, Lc.d, 1.0, d);
+			#ifdef UG_PARALLEL
+				Lc.d.set_storage_type(PST_ADDITIVE);
+			#endif
+
+			if(!cycle(lev + 1)) return false;
+
+		//	prolongate correction and update defect
+			L.P.axpy(L.t, 0.0, L.t, 1.0, Lc.c);
+			#ifdef UG_PARALLEL
+				L.t.set_storage_type(PST_CONSISTENT);
+			#endif
+			c += L.t;
+			A.matmul_minus(d, L.t);
+
+		//	postsmooth
+			return smooth(L, m_nu2);
+		}
+
+	///	applies nu smoothing steps on level L, updating L.c and L.d
+		bool smooth(Level& L, size_t nu)
+		{
+			const matrix_type& A = L.spA->get_matrix();
+			for(size_t i = 0; i < nu; ++i)
+			{
+				if(!L.spSmoother->apply(L.t, L.d))
+				{
+					UG_LOG("ERROR in 'AggregationAMG::step': Smoother failed.\n");
+					return false;
+				}
+				L.c += L.t;
+				A.matmul_minus(L.d, L.t);
+			}
+			return true;
+		}
+
+	///	returns if the connection a_ij is strong (block norms of a_ij, a_ii, a_jj)
+		bool is_strong(number aij, number aii, number ajj) const
+		{
+			return aij != 0.0 && aij >= m_theta * sqrt(aii * ajj);
+		}
+
+	///	computes the aggregates of A, returns the number of aggregates
+		size_t compute_aggregates(std::vector<int>& vAgg, const matrix_type& A) const
+		{
+			PROFILE_BEGIN_GROUP(AggregationAMG_compute_aggregates, "algebra AggregationAMG");
+			const size_t n = A.num_rows();
+
+			std::vector<number> vDiag(n);
+			for(size_t i = 0; i < n; ++i) vDiag[i] = BlockNorm(A(i,i));
+
+		//	strong connections (CSR) and their strength
+			std::vector<size_t> vStart(n+1, 0), vStrong;
+			std::vector<number> vStrength;
+			for(size_t i = 0; i < n; ++i)
+			{
+				for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+				{
+					const size_t j = it.index();
+					if(j == i) continue;
+					const number aij = BlockNorm(it.value());
+					if(!is_strong(aij, vDiag[i], vDiag[j])) continue;
+					vStrong.push_back(j);
+					vStrength.push_back(aij);
+				}
+				vStart[i+1] = vStrong.size();
+			}
+
+			vAgg.assign(n, -1);
+			int numAgg = 0;
+
+		//	phase 1: nodes whose strong neighbors are all free form an aggregate
+			for(size_t i = 0; i < n; ++i)
+			{
+				if(vAgg[i] != -1 || vStart[i] == vStart[i+1]) continue;
+
+				bool bFree = true;
+				for(size_t k = vStart[i]; k < vStart[i+1]; ++k)
+					if(vAgg[vStrong[k]] != -1) {bFree = false; break;}
+				if(!bFree) continue;
+
+				vAgg[i] = numAgg;
+				for(size_t k = vStart[i]; k < vStart[i+1]; ++k)
+					if(vStart[vStrong[k]] != vStart[vStrong[k]+1])
+						vAgg[vStrong[k]] = numAgg;
+				++numAgg;
+			}
+
+		//	phase 2: remaining nodes join the aggregate of the strongest neighbor
+			const std::vector<int> vAgg1(vAgg);
+			for(size_t i = 0; i < n; ++i)
+			{
+				if(vAgg[i] != -1) continue;
+
+				number maxStrength = 0.0;
+				for(size_t k = vStart[i]; k < vStart[i+1]; ++k)
+				{
+					const int a = vAgg1[vStrong[k]];
+					if(a != -1 && vStrength[k] > maxStrength)
+					{
+						maxStrength = vStrength[k];
+						vAgg[i] = a;
+					}
+				}
+			}
+
+		//	phase 3: remaining nodes and their free strong neighbors form an aggregate
+			for(size_t i = 0; i < n; ++i)
+			{
+				if(vAgg[i] != -1 || vStart[i] == vStart[i+1]) continue;
+
+				vAgg[i] = numAgg;
+				for(size_t k = vStart[i]; k < vStart[i+1]; ++k)
+					if(vAgg[vStrong[k]] == -1 && vStart[vStrong[k]] != vStart[vStrong[k]+1])
+						vAgg[vStrong[k]] = numAgg;
+				++numAgg;
+			}
+
+			return numAgg;
+		}
+
+	///	computes the (smoothed) prolongation P for the aggregates vAgg of A
+		void create_prolongation(matrix_type& P, const matrix_type& A,
+		                         const std::vector<int>& vAgg, size_t numAgg) const
+		{
+			PROFILE_BEGIN_GROUP(AggregationAMG_create_prolongation, "algebra AggregationAMG");
+			const size_t n = A.num_rows();
+			P.resize_and_clear(n, numAgg);
+
+		//	identity blocks of the tentative prolongation
+			if(!m_bSmoothP)
+			{
+				for(size_t i = 0; i < n; ++i)
+				{
+					if(vAgg[i] == -1) continue;
+					block_type& p = P(i, vAgg[i]);
+					SetSize(p, GetRows(A(i,i)), GetRows(A(i,i)));
+					p = 1.0;
+				}
+				P.defragment();
+				return;
+			}
+
+		//	inverse point diagonal as blocks and Gershgorin bound of rho(D^{-1} A)
+			std::vector<block_type> vDiagInv(n);
+			std::vector<number> vDiag(n);
+			number rho = 0.0;
+			for(size_t i = 0; i < n; ++i)
+			{
+				const block_type& aii = A(i,i);
+				const size_t nr = GetRows(aii);
+				block_type& dInv = vDiagInv[i];
+				SetSize(dInv, nr, nr);
+				dInv = 0.0;
+				for(size_t k = 0; k < nr; ++k)
+				{
+					const number d = BlockRef(aii, k, k);
+					UG_COND_THROW(d == 0.0, "AggregationAMG: zero on diagonal in row "<<i<<".");
+					BlockRef(dInv, k, k) = 1.0 / d;
+				}
+				vDiag[i] = BlockNorm(aii);
+
+				std::vector<number> vRowSum(nr, 0.0);
+				for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+				{
+					const block_type& aij = it.value();
+					for(size_t k = 0; k < nr; ++k)
+						for(size_t l = 0; l < GetCols(aij); ++l)
+							vRowSum[k] += fabs(BlockRef(aij, k, l));
+				}
+				for(size_t k = 0; k < nr; ++k)
+				{
+					const number r = vRowSum[k] * fabs(BlockRef(dInv, k, k));
+					if(r > rho) rho = r;
+				}
+			}
+			const number omega = (rho > 0.0) ? m_omegaFactor / rho : 0.0;
+
+		//	P = (I - omega D^{-1} A^F) P_0, weak connections are lumped to the diagonal
+			std::vector<int> vPos(numAgg, -1);
+			std::vector<connection> vCon;
+			block_type tmp;
+			for(size_t i = 0; i < n; ++i)
+			{
+				vCon.clear();
+				for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+				{
+					const size_t j = it.index();
+					int a = vAgg[j];
+					if(j != i && !is_strong(BlockNorm(it.value()), vDiag[i], vDiag[j]))
+						a = vAgg[i];
+					if(a == -1) continue;
+
+					AssignMult(tmp, vDiagInv[i], it.value());
+					tmp *= -omega;
+					if(vPos[a] == -1)
+					{
+						vPos[a] = vCon.size();
+						vCon.push_back(connection(a, tmp));
+					}
+					else vCon[vPos[a]].dValue += tmp;
+				}
+
+				if(vAgg[i] != -1)
+				{
+					if(vPos[vAgg[i]] == -1)
+					{
+						tmp = vDiagInv[i];
+						tmp = 0.0;
+						vPos[vAgg[i]] = vCon.size();
+						vCon.push_back(connection(vAgg[i], tmp));
+					}
+					vCon[vPos[vAgg[i]]].dValue += 1.0;
+				}
+
+				for(size_t k = 0; k < vCon.size(); ++k) vPos[vCon[k].iIndex] = -1;
+				if(!vCon.empty()) P.set_matrix_row(i, &vCon[0], vCon.size());
+			}
+			P.defragment();
+		}
+
+	///	remembers the sparsity pattern of the finest matrix
+		void store_pattern(const matrix_type& A)
+		{
+			m_vRowStart.resize(A.num_rows()+1);
+			m_vColInd.clear();
+			m_vRowStart[0] = 0;
+			for(size_t i = 0; i < A.num_rows(); ++i)
+			{
+				for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+					m_vColInd.push_back(it.index());
+				m_vRowStart[i+1] = m_vColInd.size();
+			}
+		}
+
+	///	returns if the pattern of A equals the stored one
+		bool same_pattern(const matrix_type& A) const
+		{
+			if(A.num_rows() + 1 != m_vRowStart.size()) return false;
+			size_t k = 0;
+			for(size_t i = 0; i < A.num_rows(); ++i)
+			{
+				for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it, ++k)
+					if(k >= m_vRowStart[i+1] || m_vColInd[k] != it.index()) return false;
+				if(k != m_vRowStart[i+1]) return false;
+			}
+			return true;
+		}
+
+	///	prints the sizes of the levels and the operator complexity
+		void print_hierarchy() const
+		{
+			size_t nnzSum = 0;
+			const size_t nnz0 = m_vLevel[0]->spA->total_num_connections();
+			UG_LOG("AggregationAMG hierarchy:\n");
+			for(size_t lev = 0; lev < m_vLevel.size(); ++lev)
+			{
+				const matrix_type& A = *m_vLevel[lev]->spA;
+				nnzSum += A.total_num_connections();
+				UG_LOG("  level " << lev << ": " << A.num_rows() << " rows, "
+				       << A.total_num_connections() << " nonzeros\n");
+			}
+			UG_LOG("  operator complexity: " << (nnz0 > 0 ? (double)nnzSum / nnz0 : 0.0) << "\n");
+		}
+
+	protected:
+	///	returns a clone of the given base solver, or the solver itself if it can not be cloned
+		static SmartPtr<ILinearOperatorInverse<vector_type> >
+		clone_base_solver(SmartPtr<ILinearOperatorInverse<vector_type> > spSolver)
+		{
+			SmartPtr<ILinearIterator<vector_type> > spClone;
+			try{
+				spClone = spSolver->clone();
+			}
+			catch(UGError&){
+				return spSolver;
+			}
+
+			SmartPtr<ILinearOperatorInverse<vector_type> > spInv =
+				spClone.template cast_dynamic<ILinearOperatorInverse<vector_type> >();
+			if(spInv.invalid())
+				return spSolver;
+			return spInv;
+		}
+
+	///	threshold for strong connections
+		number m_theta;
+
+	///	damping factor of the prolongation smoothing
+		number m_omegaFactor;
+
+	///	flag if prolongation is smoothed
+		bool m_bSmoothP;
+
+	///	maximal number of levels and maximal size of the base level
+		size_t m_maxLevels, m_maxBase;
+
+	///	number of pre- and postsmoothing steps
+		size_t m_nu1, m_nu2;
+
+	///	flag if the aggregates are reused for matrices of the same pattern
+		bool m_bReuse;
+
+	///	flag if the hierarchy is printed
+		bool m_bInfo;
+
+	///	smoother (prototype) and base solver
+		SmartPtr<ILinearIterator<vector_type> > m_spSmoother;
+		SmartPtr<ILinearOperatorInverse<vector_type> > m_spBaseSolver;
+
+	///	flag if the base solver is the default LU
+		bool m_bDefaultBaseSolver;
+
+	///	the levels of the hierarchy
+		std::vector<SmartPtr<Level> > m_vLevel;
+
+	///	sparsity pattern of the finest matrix, used to check for reuse
+		std::vector<size_t> m_vRowStart, m_vColInd;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__AGGREGATION_AMG__ */
@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+
+#include <vector>
+#include <cmath>
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/cpu_algebra/vector.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	Chebyshev smoother
+/**
+ * Polynomial smoother based on the Chebyshev iteration for the Jacobi
+ * preconditioned matrix \f$ D^{-1} A \f$. With zero initial guess, the
+ * correction is
+ *
+ * 		\f$ c = p(D^{-1} A) D^{-1} d \f$,
+ *
+ * where \f$ p \f$ is the polynomial of degree 'degree-1' (scaled and shifted
+ * Chebyshev polynomial), that minimizes the error on the interval
+ * \f$ [\lambda_{min}, \lambda_{max}] \f$ of the spectrum of \f$ D^{-1} A \f$.
+ * For smoothing, \f$ \lambda_{min} = \lambda_{max} / ratio \f$ is chosen,
+ * such that the upper part of the spectrum is damped.
+ *
+ * One application needs 'degree-1' matrix-vector products and 'degree'
+ * (block-)diagonal scalings. No triangular solves are involved, thus the
+ * smoother is thread-parallel and the only interface communication is the one
+ * of the diagonal scaling (additive to consistent), as for the Jacobi.
+ *
+ * \f$ \lambda_{max} \f$ is estimated in preprocess by a few steps of the
+ * Jacobi-preconditioned CG method with random start vector: the CG
+ * coefficients build the Lanczos tridiagonal matrix, whose largest eigenvalue
+ * is computed by bisection and multiplied by a safety factor. The estimation
+ * requires \f$ D^{-1} A \f$ to be similar to a symmetric positive definite
+ * matrix. Alternatively, the bounds can be set by the user.
+ *
+ * References:
+ * <ul>
+ * <li> M. Adams, M. Brezina, J. Hu, R. Tuminaro. Parallel multigrid smoothing:
+ *      polynomial versus Gauss-Seidel. J. Comput. Phys. 188 (2003)
+ * <li> Y. Saad. Iterative Methods for Sparse Linear Systems, Alg. 12.1
+ * </ul>
+ */
+template <typename TAlgebra>
+class Chebyshev : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix Operator type
+		typedef typename IPreconditioner<TAlgebra>::matrix_operator_type matrix_operator_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	protected:
+		using base_type::set_debug;
+		using base_type::debug_writer;
+		using base_type::write_debug;
+
+	public:
+	///	default constructor
+		Chebyshev()
+			: m_degree(3), m_eigRatio(30.0), m_numEstimationSteps(10),
+			  m_safety(1.1), m_bUserBounds(false), m_lmin(0.0), m_lmax(0.0)
+		{}
+
+	///	constructor setting the degree
+		Chebyshev(int degree)
+			: m_degree(degree), m_eigRatio(30.0), m_numEstimationSteps(10),
+			  m_safety(1.1), m_bUserBounds(false), m_lmin(0.0), m_lmax(0.0)
+		{
+			set_degree(degree);
+		}
+
+	/// clone constructor
+		Chebyshev(const Chebyshev<TAlgebra> &parent)
+			: base_type(parent),
+			  m_degree(parent.m_degree), m_eigRatio(parent.m_eigRatio),
+			  m_numEstimationSteps(parent.m_numEstimationSteps),
+			  m_safety(parent.m_safety), m_bUserBounds(parent.m_bUserBounds),
+			  m_lmin(parent.m_lmin), m_lmax(parent.m_lmax)
+		{}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new Chebyshev<algebra_type>(*this));
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	Destructor
+		virtual ~Chebyshev() {}
+
+	///	sets the number of diagonal scalings per application (default: 3)
+		void set_degree(int degree)
+		{
+			UG_COND_THROW(degree < 1, "Chebyshev: degree must be at least 1.");
+			m_degree = degree;
+		}
+
+	///	sets lambda_max / lambda_min of the smoothed interval (default: 30)
+		void set_eigenvalue_ratio(number ratio)
+		{
+			UG_COND_THROW(ratio <= 1.0, "Chebyshev: eigenvalue ratio must be larger than 1.");
+			m_eigRatio = ratio;
+		}
+
+	///	sets the number of CG-Lanczos steps used to estimate lambda_max (default: 10)
+		void set_num_estimation_steps(int steps)
+		{
+			UG_COND_THROW(steps < 1, "Chebyshev: at least one estimation step needed.");
+			m_numEstimationSteps = steps;
+		}
+
+	///	sets the factor the estimated lambda_max is multiplied with (default: 1.1)
+		void set_safety_factor(number safety) {m_safety = safety;}
+
+	///	sets the bounds of the spectrum of D^{-1}A explicitly (no estimation)
+		void set_eigenvalue_bounds(number lmin, number lmax)
+		{
+			UG_COND_THROW(!(0.0 < lmin && lmin < lmax),
+			              "Chebyshev: need 0 < lambda_min < lambda_max.");
+			m_lmin = lmin;
+			m_lmax = lmax;
+			m_bUserBounds = true;
+		}
+
+	///	lower bound of the smoothed interval (available after init)
+		number min_eigenvalue() const {return m_lmin;}
+
+	///	upper bound of the smoothed interval (available after init)
+		number max_eigenvalue() const {return m_lmax;}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "Chebyshev";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_preprocess, "algebra Chebyshev");
+
+			matrix_type &mat = *pOp;
+			const size_t size = mat.num_rows();
+			if(size != mat.num_cols())
+			{
+				UG_LOG("Square Matrix needed for Chebyshev Iteration.\n");
+				return false;
+			}
+
+		//	invert the (block-)diagonal, in parallel the diagonal is made
+		//	consistent first (as for the Jacobi)
+			m_diagInv.resize(size);
+#ifdef UG_PARALLEL
+			ParallelVector<Vector< typename matrix_type::value_type > > diag;
+			diag.resize(size);
+			diag.set_layouts(mat.layouts());
+			for(size_t i = 0; i < size; ++i)
+				diag[i] = mat(i, i);
+			diag.set_storage_type(PST_ADDITIVE);
+			diag.change_storage_type(PST_CONSISTENT);
+			if(size > 0 && !CheckVectorInvertible(diag))
+				return false;
+#endif
+			for(size_t i = 0; i < size; ++i)
+			{
+#ifdef UG_PARALLEL
+				if(!GetInverse(m_diagInv[i], diag[i]))
+#else
+				if(!GetInverse(m_diagInv[i], mat(i, i)))
+#endif
+					UG_THROW("Chebyshev: diagonal block " << i << " is not invertible.");
+			}
+
+			m_spR = SPNULL;
+
+			if(!m_bUserBounds)
+			{
+				m_lmax = m_safety * estimate_max_eigenvalue(pOp);
+				m_lmin = m_lmax / m_eigRatio;
+			}
+			return true;
+		}
+
+	///	z = D^{-1} r, with r additive and z consistent
+		void scale_diag(vector_type& z, const vector_type& r) const
+		{
+			const size_t numDiag = m_diagInv.size();
+#ifdef UG_OPENMP
+			#pragma omp parallel for schedule(static) if(numDiag >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+			for(size_t i = 0; i < numDiag; ++i)
+				MatMult(z[i], 1.0, m_diagInv[i], r[i]);
+
+#ifdef UG_PARALLEL
+			z.set_storage_type(PST_ADDITIVE);
+			if(!z.change_storage_type(PST_CONSISTENT))
+				UG_THROW("Chebyshev: Cannot change parallel storage type to consistent.");
+#endif
+		}
+
+	///	estimates the largest eigenvalue of D^{-1}A by CG-Lanczos
+		number estimate_max_eigenvalue(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_estimate, "algebra Chebyshev");
+			matrix_type &mat = *pOp;
+			const size_t size = mat.num_rows();
+
+			vector_type r(size), z(size), p(size), q(size);
+#ifdef UG_PARALLEL
+			r.set_layouts(mat.layouts()); z.set_layouts(mat.layouts());
+			p.set_layouts(mat.layouts()); q.set_layouts(mat.layouts());
+			r.set_random(-1.0, 1.0, PST_ADDITIVE);
+#else
+			r.set_random(-1.0, 1.0);
+#endif
+
+		//	diagonal and off-diagonal of the Lanczos matrix
+			std::vector<number> vDiag, vOffDiag;
+			number alphaOld = 1.0, betaOld = 0.0;
+
+			scale_diag(z, r);
+			p = z;
+			number rho = VecProd(z, r);
+			for(int j = 0; j < m_numEstimationSteps && rho > 0.0; ++j)
+			{
+				mat.apply(q, p);
+				const number pq = VecProd(p, q);
+				if(!(pq > 0.0))
+					UG_THROW("Chebyshev: D^{-1}A is not positive definite, "
+							"cannot estimate eigenvalues. Use set_eigenvalue_bounds.");
+				const number alpha = rho / pq;
+
+				vDiag.push_back(1.0/alpha + (j == 0 ? 0.0 : betaOld/alphaOld));
+				if(j > 0) vOffDiag.push_back(std::sqrt(betaOld)/alphaOld);
+
+				VecScaleAdd(r, 1.0, r, -alpha, q);
+				scale_diag(z, r);
+				const number rhoNew = VecProd(z, r);
+				const number beta = rhoNew / rho;
+				VecScaleAdd(p, 1.0, z, beta, p);
+
+				rho = rhoNew;
+				alphaOld = alpha;
+				betaOld = beta;
+			}
+
+			if(vDiag.empty())
+				UG_THROW("Chebyshev: Cannot estimate eigenvalues of a zero matrix.");
+
+			return max_tridiagonal_eigenvalue(vDiag, vOffDiag);
+		}
+
+	///	largest eigenvalue of a symmetric tridiagonal matrix by Sturm bisection
+		static number max_tridiagonal_eigenvalue(const std::vector<number>& vDiag,
+		                                         const std::vector<number>& vOffDiag)
+		{
+			const size_t n = vDiag.size();
+
+		//	Gershgorin bounds
+			number lo = vDiag[0], hi = vDiag[0];
+			for(size_t i = 0; i < n; ++i)
+			{
+				number rad = 0.0;
+				if(i > 0) rad += std::fabs(vOffDiag[i-1]);
+				if(i+1 < n) rad += std::fabs(vOffDiag[i]);
+				lo = std::min(lo, vDiag[i] - rad);
+				hi = std::max(hi, vDiag[i] + rad);
+			}
+
+		//	lambda_max is the smallest x with n eigenvalues smaller than x
+			for(int it = 0; it < 100 && hi - lo > 1e-12 * std::fabs(hi); ++it)
+			{
+				const number x = 0.5 * (lo + hi);
+				size_t numSmaller = 0;
+				number d = 1.0;
+				for(size_t i = 0; i < n; ++i)
+				{
+					const number e2 = (i > 0) ? vOffDiag[i-1]*vOffDiag[i-1] : 0.0;
+					d = vDiag[i] - x - ((i > 0) ? e2 / d : 0.0);
+					if(d == 0.0) d = -1e-300;
+					if(d < 0.0) ++numSmaller;
+				}
+				if(numSmaller == n) hi = x;
+				else lo = x;
+			}
+			return hi;
+		}
+
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_step, "algebra Chebyshev");
+
+			if(m_spR.invalid() || m_spR->size() != d.size())
+			{
+				m_spR = d.clone_without_values();
+				m_spZ = d.clone_without_values();
+				m_spP = d.clone_without_values();
+			}
+			vector_type& r = *m_spR;
+			vector_type& z = *m_spZ;
+			vector_type& p = *m_spP;
+
+			const number theta = 0.5 * (m_lmax + m_lmin);
+			const number delta = 0.5 * (m_lmax - m_lmin);
+			const number sigma = theta / delta;
+			number rho = 1.0 / sigma;
+
+		//	c = p = 1/theta D^{-1} d
+			scale_diag(z, d);
+			VecScaleAssign(p, 1.0/theta, z);
+			c = p;
+			if(m_degree == 1) return true;
+
+			r = d;
+			for(int k = 1; k < m_degree; ++k)
+			{
+			//	r := r - A*p, z = D^{-1} r
+				pOp->apply_sub(r, p);
+				scale_diag(z, r);
+
+			//	p := rho_new*rho * p + 2*rho_new/delta * z
+				const number rhoNew = 1.0 / (2.0*sigma - rho);
+				VecScaleAdd(p, rhoNew*rho, p, 2.0*rhoNew/delta, z);
+				VecScaleAdd(c, 1.0, c, 1.0, p);
+				rho = rhoNew;
+			}
+
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	block type
+		typedef typename matrix_type::value_type value_type;
+
+	///	type of block-inverse
+		typedef typename block_traits<value_type>::inverse_type inverse_type;
+
+	///	inverse (block-)diagonal
+		std::vector<inverse_type> m_diagInv;
+
+	///	parameters
+		int m_degree;
+		number m_eigRatio;
+		int m_numEstimationSteps;
+		number m_safety;
+
+	///	bounds of the smoothed interval
+		bool m_bUserBounds;
+		number m_lmin, m_lmax;
+
+	///	help vectors
+		SmartPtr<vector_type> m_spR, m_spZ, m_spP;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__ */
@@ -69,11 +69,12 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 	public:
 	//	Constructor
-		GaussSeidelBase() : m_relax(1.0), m_bConsistentInterfaces(false) {}
+		GaussSeidelBase() : m_relax(1.0), m_bConsistentInterfaces(false), m_bLevelScheduling(false) {}
 
 	/// clone constructor
 		GaussSeidelBase( const GaussSeidelBase<TAlgebra> &parent )
-			: base_type(parent), m_bConsistentInterfaces(parent.m_bConsistentInterfaces)
+			: base_type(parent), m_bConsistentInterfaces(parent.m_bConsistentInterfaces),
+			  m_bLevelScheduling(parent.m_bLevelScheduling)
 		{
 			set_sor_relax(parent.m_relax);
 		}
@@ -84,6 +85,11 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 	///	activates the new parallelization approach (disabled by default)
 		void enable_consistent_interfaces(bool enable) {m_bConsistentInterfaces = enable;}
 
+	///	processes the rows in independent levels (thread-parallel with OpenMP, disabled by default)
+	/**	The levels are computed from the sparsity pattern during preprocess. The
+	 * correction is identical to the one of the sequential sweep.*/
+		void set_level_scheduling(bool enable) {m_bLevelScheduling = enable;}
+
 		virtual const char* name() const = 0;
 	protected:
 
@@ -121,6 +127,18 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 			THROW_IF_NOT_EQUAL(pA->num_rows(), pA->num_cols());
 //			UG_ASSERT(CheckDiagonalInvertible(A), "GS: A has noninvertible diagonal");
 			UG_COND_THROW(CheckDiagonalInvertible(*pA) == false, name() << ": A has noninvertible diagonal");
+
+		//	compute the levels of the triangular parts
+			if(m_bLevelScheduling)
+			{
+				m_lowerSched.init_lower(*pA);
+				m_upperSched.init_upper(*pA);
+			}
+			else
+			{
+				m_lowerSched.clear();
+				m_upperSched.clear();
+			}
 			return true;
 		}
 
@@ -183,6 +201,17 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 		number m_relax;
 
 		bool m_bConsistentInterfaces;
+
+	///	level schedules of the lower and upper part of the matrix
+		bool m_bLevelScheduling;
+		LevelSchedule m_lowerSched;
+		LevelSchedule m_upperSched;
+
+	///	returns if the level schedules have been computed for the matrix A
+		bool use_level_scheduling(const matrix_type& A) const
+		{
+			return m_bLevelScheduling && m_lowerSched.num_rows() == A.num_rows();
+		}
 };
 
 /// Gauss-Seidel preconditioner for the 'forward' ordering of the dofs
@@ -226,7 +255,10 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_LL(A, c, d, relax);
+			if(base_type::use_level_scheduling(A))
+				gs_step_LL(A, c, d, relax, base_type::m_lowerSched);
+			else
+				gs_step_LL(A, c, d, relax);
 		}
 };
 
@@ -271,7 +303,10 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_UR(A, c, d, relax);
+			if(base_type::use_level_scheduling(A))
+				gs_step_UR(A, c, d, relax, base_type::m_upperSched);
+			else
+				gs_step_UR(A, c, d, relax);
 		}
 };
 
@@ -305,7 +340,10 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			sgs_step(A, c, d, relax);
+			if(base_type::use_level_scheduling(A))
+				sgs_step(A, c, d, relax, base_type::m_lowerSched, base_type::m_upperSched);
+			else
+				sgs_step(A, c, d, relax);
 		}
 };
 
@@ -46,6 +46,8 @@
 	#include "lib_algebra/parallelization/overlap_writer.h"
 #endif
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "lib_algebra/algebra_common/level_schedule.h"
+#include "lib_algebra/cpu_algebra/float_sparse_matrix.h"
 
 namespace ug{
 
@@ -244,6 +246,52 @@ bool invert_L(const Matrix_type &A, Vector_type &x, const Vector_type &b)
 	return true;
 }
 
+// solve the last row of x = U^-1 * b
+/*	the last row diagonal U entry might be close to zero with corresponding close
+ *	to zero rhs when solving Navier Stokes system, therefore it is handled separately.
+ *	returns true, if the entry has been treated as near-zero.*/
+template<typename Block_type, typename Vector_type>
+bool invert_U_last_row_diag(const Block_type &Aii, Vector_type &x, const Vector_type &b,
+                            const number eps)
+{
+	size_t i=x.size()-1;
+	typename Vector_type::value_type s = b[i];
+
+	// check if diag part is significantly smaller than rhs
+	// This may happen when matrix is indefinite with one eigenvalue
+	// zero. In that case, the factorization on the last row is
+	// nearly zero due to round-off errors. In order to allow ill-
+	// scaled matrices (i.e. small matrix entries row-wise) this
+	// is compared to the rhs, that is small in this case as well.
+	if (BlockNorm(Aii) <= eps * BlockNorm(s))
+	{
+		UG_LOG("ILU Warning: Near-zero diagonal entry "
+			"with norm "<<BlockNorm(Aii)<<" in last row of U "
+			" with corresponding non-near-zero rhs with norm "
+			<< BlockNorm(s) << ". Setting rhs to zero.\n");
+		UG_LOG("NOTE: Call this method with a smaller 'eps' parameter "
+			   "to avoid this warning. (current eps: " << eps <<
+			   "). If this method is called from the "
+			   "ILU preconditioner class, you may want to call "
+			   "ILU::set_inversion_eps(...) with a smaller threshold.\n")
+		// set correction to zero
+		x[i] = 0;
+		return true;
+	}
+
+	// c[i] = s/uii;
+	InverseMatMult(x[i], 1.0, Aii, s);
+	return false;
+}
+
+template<typename Matrix_type, typename Vector_type>
+bool invert_U_last_row(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+                       const number eps)
+{
+	size_t i=x.size()-1;
+	return invert_U_last_row_diag(A(i,i), x, b, eps);
+}
+
 // solve x = U^-1 * b
 template<typename Matrix_type, typename Vector_type>
 bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
@@ -253,42 +301,10 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 	typedef typename Matrix_type::const_row_iterator const_row_iterator;
 
 	typename Vector_type::value_type s;
-	
-	size_t numNearZero=0;
 
-	// last row diagonal U entry might be close to zero with corresponding close to zero rhs
-	// when solving Navier Stokes system, therefore handle separately
+	// last row is handled separately
 	if(x.size() > 0)
-	{
-		size_t i=x.size()-1;
-		s = b[i];
-
-		// check if diag part is significantly smaller than rhs
-		// This may happen when matrix is indefinite with one eigenvalue
-		// zero. In that case, the factorization on the last row is
-		// nearly zero due to round-off errors. In order to allow ill-
-		// scaled matrices (i.e. small matrix entries row-wise) this
-		// is compared to the rhs, that is small in this case as well.
-		if (BlockNorm(A(i,i)) <= eps * BlockNorm(s))
-		{
-			if(numNearZero++<5)
-			{	UG_LOG("ILU Warning: Near-zero diagonal entry "
-					"with norm "<<BlockNorm(A(i,i))<<" in last row of U "
-					" with corresponding non-near-zero rhs with norm "
-					<< BlockNorm(s) << ". Setting rhs to zero.\n");
-				UG_LOG("NOTE: Call this method with a smaller 'eps' parameter "
-					   "to avoid this warning. (current eps: " << eps <<
-					   "). If this method is called from the "
-					   "ILU preconditioner class, you may want to call "
-					   "ILU::set_inversion_eps(...) with a smaller threshold.\n")
-			}
-			// set correction to zero
-			x[i] = 0;
-		} else {
-			// c[i] = s/uii;
-			InverseMatMult(x[i], 1.0, A(i,i), s);
-		}
-	}
+		invert_U_last_row(A, x, b, eps);
 	if(x.size() <= 1) return true;
 
 	// handle all other rows
@@ -307,12 +323,217 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 		if(i == 0) break;
 	}
 
-	if(numNearZero>=5)
-	{	UG_LOG("...\nILU Warning: " << numNearZero << " ( out of " << x.size() << ") near-zero diagonal entries in last row of U.\n");	}
+	return true;
+}
+
+// solve x = L^-1 b, processing the rows level by level (see LevelSchedule)
+template<typename Matrix_type, typename Vector_type>
+bool invert_L(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+			  const LevelSchedule& sched)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+	UG_ASSERT(sched.num_rows() == x.size(), "level schedule does not match vector size");
+
+	const size_t numLevels = sched.num_levels();
+#ifdef UG_OPENMP
+	#pragma omp parallel if(sched.parallel_worthwhile())
+#endif
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		const int begin = (int)sched.level_begin(lev), end = (int)sched.level_end(lev);
+#ifdef UG_OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for(int k = begin; k < end; ++k)
+		{
+			const size_t i = sched.row(k);
+			typename Vector_type::value_type s = b[i];
+			for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			{
+				if(it.index() >= i) continue;
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+			}
+			x[i] = s;
+		}
+	}
+
+	return true;
+}
+
+// solve x = U^-1 * b, processing the rows level by level (see LevelSchedule)
+template<typename Matrix_type, typename Vector_type>
+bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+			  const number eps, const LevelSchedule& sched)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+	UG_ASSERT(sched.num_rows() == x.size(), "level schedule does not match vector size");
+
+	// last row is handled separately. It has no upper entries and is
+	// therefore part of the first level, where it is skipped
+	if(x.size() == 0) return true;
+	const size_t last = x.size()-1;
+	invert_U_last_row(A, x, b, eps);
+
+	const size_t numLevels = sched.num_levels();
+#ifdef UG_OPENMP
+	#pragma omp parallel if(sched.parallel_worthwhile())
+#endif
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		const int begin = (int)sched.level_begin(lev), end = (int)sched.level_end(lev);
+#ifdef UG_OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for(int k = begin; k < end; ++k)
+		{
+			const size_t i = sched.row(k);
+			if(i == last) continue;
+
+			typename Vector_type::value_type s = b[i];
+			for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			{
+				if(it.index() <= i) continue;
+				// s -= it.value() * x[it.index()];
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+			}
+			// x[i] = s/A(i,i);
+			InverseMatMult(x[i], 1.0, A(i,i), s);
+		}
+	}
+
+	return true;
+}
+
+
+// solve x = L^-1 b with the factors stored in single precision
+template<typename TValue, typename Vector_type>
+bool invert_L(const FloatSparseMatrix<TValue> &A, Vector_type &x, const Vector_type &b)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typename Vector_type::value_type s;
+	for(size_t i=0; i < x.size(); i++)
+	{
+		s = b[i];
+		A.sub_mult(s, A.row_begin(i), A.lower_end(i), x);
+		x[i] = s;
+	}
 
 	return true;
 }
 
+// solve the last row of x = U^-1 * b with the factors stored in single precision
+template<typename TValue, typename Vector_type>
+bool invert_U_last_row(const FloatSparseMatrix<TValue> &A, Vector_type &x, const Vector_type &b,
+                       const number eps)
+{
+	size_t i=x.size()-1;
+	UG_ASSERT(A.has_diag(i), "no diagonal entry in row " << i);
+	TValue Aii;
+	A.get_block(Aii, A.lower_end(i));
+	return invert_U_last_row_diag(Aii, x, b, eps);
+}
+
+// solve x = U^-1 * b with the factors stored in single precision
+template<typename TValue, typename Vector_type>
+bool invert_U(const FloatSparseMatrix<TValue> &A, Vector_type &x, const Vector_type &b,
+			  const number eps = 1e-8)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typename Vector_type::value_type s;
+	TValue Aii;
+
+	// last row is handled separately
+	if(x.size() > 0)
+		invert_U_last_row(A, x, b, eps);
+	if(x.size() <= 1) return true;
+
+	// handle all other rows
+	for(size_t i = x.size()-2; ; --i)
+	{
+		s = b[i];
+		A.sub_mult(s, A.upper_begin(i), A.row_end(i), x);
+
+		// x[i] = s/A(i,i), the diagonal block is inverted in double precision
+		UG_ASSERT(A.has_diag(i), "no diagonal entry in row " << i);
+		A.get_block(Aii, A.lower_end(i));
+		InverseMatMult(x[i], 1.0, Aii, s);
+		if(i == 0) break;
+	}
+
+	return true;
+}
+
+// solve x = L^-1 b with the factors stored in single precision, level by level
+template<typename TValue, typename Vector_type>
+bool invert_L(const FloatSparseMatrix<TValue> &A, Vector_type &x, const Vector_type &b,
+			  const LevelSchedule& sched)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	UG_ASSERT(sched.num_rows() == x.size(), "level schedule does not match vector size");
+
+	const size_t numLevels = sched.num_levels();
+#ifdef UG_OPENMP
+	#pragma omp parallel if(sched.parallel_worthwhile())
+#endif
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		const int begin = (int)sched.level_begin(lev), end = (int)sched.level_end(lev);
+#ifdef UG_OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for(int k = begin; k < end; ++k)
+		{
+			const size_t i = sched.row(k);
+			typename Vector_type::value_type s = b[i];
+			A.sub_mult(s, A.row_begin(i), A.lower_end(i), x);
+			x[i] = s;
+		}
+	}
+
+	return true;
+}
+
+// solve x = U^-1 * b with the factors stored in single precision, level by level
+template<typename TValue, typename Vector_type>
+bool invert_U(const FloatSparseMatrix<TValue> &A, Vector_type &x, const Vector_type &b,
+			  const number eps, const LevelSchedule& sched)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	UG_ASSERT(sched.num_rows() == x.size(), "level schedule does not match vector size");
+
+	if(x.size() == 0) return true;
+	const size_t last = x.size()-1;
+	invert_U_last_row(A, x, b, eps);
+
+	const size_t numLevels = sched.num_levels();
+#ifdef UG_OPENMP
+	#pragma omp parallel if(sched.parallel_worthwhile())
+#endif
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		const int begin = (int)sched.level_begin(lev), end = (int)sched.level_end(lev);
+#ifdef UG_OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for(int k = begin; k < end; ++k)
+		{
+			const size_t i = sched.row(k);
+			if(i == last) continue;
+
+			typename Vector_type::value_type s = b[i];
+			A.sub_mult(s, A.upper_begin(i), A.row_end(i), x);
+
+			UG_ASSERT(A.has_diag(i), "no diagonal entry in row " << i);
+			TValue Aii;
+			A.get_block(Aii, A.lower_end(i));
+			InverseMatMult(x[i], 1.0, Aii, s);
+		}
+	}
+
+	return true;
+}
 
 #ifdef UG_PARALLEL
 inline void
@@ -369,6 +590,9 @@ class ILU : public IPreconditioner<TAlgebra>
 	///	Base type
 		typedef IPreconditioner<TAlgebra> base_type;
 
+	///	type of the factors in single precision
+		typedef FloatSparseMatrix<typename matrix_type::value_type> float_matrix_type;
+
 	protected:
 		using base_type::set_debug;
 		using base_type::debug_writer;
@@ -383,7 +607,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_bSort(false),
 			m_bDisablePreprocessing(false),
 			m_useConsistentInterfaces(false),
-			m_useOverlap(false) {};
+			m_useOverlap(false),
+			m_bLevelScheduling(false),
+			m_bFloatStorage(false) {};
 
 	/// clone constructor
 		ILU( const ILU<TAlgebra> &parent )
@@ -394,7 +620,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			  m_bSort(parent.m_bSort),
 			  m_bDisablePreprocessing(parent.m_bDisablePreprocessing),
 			  m_useConsistentInterfaces(parent.m_useConsistentInterfaces),
-			  m_useOverlap(parent.m_useOverlap)
+			  m_useOverlap(parent.m_useOverlap),
+			  m_bLevelScheduling(parent.m_bLevelScheduling),
+			  m_bFloatStorage(parent.m_bFloatStorage)
 		{	}
 
 	///	Clone
@@ -434,6 +662,29 @@ class ILU : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable)				{m_useOverlap = enable;}
 
+	///	processes the rows of the triangular solves in independent levels
+	/**	The levels are computed after the factorization. All rows of a level
+	 * are solved thread-parallel if OpenMP is enabled, the result is identical
+	 * to the sequential solve. Disabled by default.*/
+		void set_level_scheduling(bool enable)			{m_bLevelScheduling = enable;}
+
+	///	stores the factors in single precision
+	/**	The factorization is computed in double precision, afterwards the
+	 * factors are stored as float. The triangular solves read the float
+	 * factors, but accumulate in double precision, which almost halves the
+	 * memory traffic of an application. Only available for blocks of static
+	 * size. Disabled by default.
+	 * Changing the setting requires a new init.*/
+		void set_float_storage(bool enable)
+		{
+			UG_COND_THROW(enable && !float_matrix_type::supported(),
+			              "ILU: float storage is only available for blocks of static size.");
+		//	the storage of the current preprocess does not match anymore
+			if(enable != m_bFloatStorage)
+				this->m_bInit = false;
+			m_bFloatStorage = enable;
+		}
+
 	protected:
 	//	Name of preconditioner
 		virtual const char* name() const {return "ILU";}
@@ -532,6 +783,22 @@ class ILU : public IPreconditioner<TAlgebra>
 			else FactorizeILU(m_ILU);
 			m_ILU.defragment();
 
+		//	copy the factors to single precision
+			if(m_bFloatStorage) m_floatILU.build(m_ILU);
+			else m_floatILU.clear();
+
+		//	compute the independent levels of L and U
+			if(m_bLevelScheduling)
+			{
+				m_lowerSched.init_lower(m_ILU);
+				m_upperSched.init_upper(m_ILU);
+			}
+			else
+			{
+				m_lowerSched.clear();
+				m_upperSched.clear();
+			}
+
 		//	Debug output of matrices
 			write_debug(m_ILU, "ILU_prep_04_A_AfterFactorize");
 
@@ -541,19 +808,41 @@ class ILU : public IPreconditioner<TAlgebra>
 
 
 		void applyLU(vector_type &c, const vector_type &d, vector_type &tmp)
-		{	
-			if(!m_bSort || m_bSortIsIdentity)
+		{
+			if(m_bFloatStorage) applyLU(m_floatILU, c, d, tmp);
+			else applyLU(m_ILU, c, d, tmp);
+		}
+
+		template <typename TFactor>
+		void applyLU(const TFactor &LU, vector_type &c, const vector_type &d, vector_type &tmp)
+		{
+			if(m_bLevelScheduling && m_lowerSched.num_rows() == LU.num_rows())
+			{
+				if(!m_bSort || m_bSortIsIdentity)
+				{
+					invert_L(LU, tmp, d, m_lowerSched); // h := L^-1 d
+					invert_U(LU, c, tmp, m_invEps, m_upperSched); // c := U^-1 h = (LU)^-1 d
+				}
+				else
+				{
+					SetVectorAsPermutation(tmp, d, m_newIndex);
+					invert_L(LU, c, tmp, m_lowerSched); // c = L^{-1} d
+					invert_U(LU, tmp, c, m_invEps, m_upperSched); // tmp = (LU)^{-1} d
+					SetVectorAsPermutation(c, tmp, m_oldIndex);
+				}
+			}
+			else if(!m_bSort || m_bSortIsIdentity)
 			{
 				// 	apply iterator: c = LU^{-1}*d
-				invert_L(m_ILU, tmp, d); // h := L^-1 d
-				invert_U(m_ILU, c, tmp, m_invEps); // c := U^-1 h = (LU)^-1 d
+				invert_L(LU, tmp, d); // h := L^-1 d
+				invert_U(LU, c, tmp, m_invEps); // c := U^-1 h = (LU)^-1 d
 			}
 			else
 			{
 				// we save one vector here by renaming
 				SetVectorAsPermutation(tmp, d, m_newIndex);
-				invert_L(m_ILU, c, tmp); // c = L^{-1} d
-				invert_U(m_ILU, tmp, c, m_invEps); // tmp = (LU)^{-1} d
+				invert_L(LU, c, tmp); // c = L^{-1} d
+				invert_U(LU, tmp, c, m_invEps); // tmp = (LU)^{-1} d
 				SetVectorAsPermutation(c, tmp, m_oldIndex);
 			}
 		}
@@ -642,6 +931,9 @@ class ILU : public IPreconditioner<TAlgebra>
 	///	storage for factorization
 		matrix_type m_ILU;
 
+	///	factorization in single precision (if enabled)
+		float_matrix_type m_floatILU;
+
 	///	help vector
 		vector_type m_h;
 
@@ -671,6 +963,14 @@ class ILU : public IPreconditioner<TAlgebra>
 
 		bool m_useConsistentInterfaces;
 		bool m_useOverlap;
+
+	///	level schedules of L and U for the triangular solves
+		bool m_bLevelScheduling;
+		LevelSchedule m_lowerSched;
+		LevelSchedule m_upperSched;
+
+	///	flag if the factors are stored in single precision
+		bool m_bFloatStorage;
 };
 
 } // end namespace ug
@@ -13,6 +13,7 @@
 
 #include "lib_algebra/algebra_common/vector_util.h"
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "lib_algebra/cpu_algebra/float_sparse_matrix.h"
 
 namespace ug{
 
@@ -40,6 +41,7 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 
 	protected:
 		typedef typename matrix_type::value_type block_type;
+		typedef FloatSparseMatrix<block_type> float_matrix_type;
 
 		using IPreconditioner<TAlgebra>::debug_writer;
 		using IPreconditioner<TAlgebra>::write_debug;
@@ -50,7 +52,8 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 	public:
 	///	Constructor
 		ILUTPreconditioner(double eps=1e-6)
-			: m_eps(eps), m_info(false), m_bSort(true), m_bSortIsIdentity(false)
+			: m_eps(eps), m_info(false), m_bSort(true), m_bSortIsIdentity(false),
+			  m_bFloatStorage(false)
 		{};
 
 	/// clone constructor
@@ -61,6 +64,7 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			set_info(parent.m_info);
 			set_sort(parent.m_bSort);
 			m_bSortIsIdentity = parent.m_bSortIsIdentity;
+			m_bFloatStorage = parent.m_bFloatStorage;
 		}
 
 	///	Clone
@@ -102,6 +106,21 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			m_bSort = b;
 		}
 
+	///	stores the factors in single precision
+	/**	L and U are computed in double precision and then stored as float, the
+	 * triangular solves accumulate in double precision. Only available for
+	 * blocks of static size. Disabled by default.
+	 * Changing the setting requires a new init.*/
+		void set_float_storage(bool enable)
+		{
+			UG_COND_THROW(enable && !float_matrix_type::supported(),
+			              "ILUT: float storage is only available for blocks of static size.");
+		//	the storage of the current preprocess does not match anymore
+			if(enable != m_bFloatStorage)
+				this->m_bInit = false;
+			m_bFloatStorage = enable;
+		}
+
 
 	protected:
 	//	Name of preconditioner
@@ -314,6 +333,18 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 				m_U.defragment();
 			}
 
+		//	copy the factors to single precision
+			if(m_bFloatStorage)
+			{
+				m_floatL.build(m_L);
+				m_floatU.build(m_U);
+			}
+			else
+			{
+				m_floatL.clear();
+				m_floatU.clear();
+			}
+
 			if (m_info==true)
 			{
 				m_L.print("L");
@@ -377,6 +408,8 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 
 		virtual bool applyLU(vector_type& c, const vector_type& d)
 		{
+			if(m_bFloatStorage) return applyLU_float(c, d);
+
 			PROFILE_BEGIN_GROUP(ILUT_step, "ilut algebra");
 			// apply iterator: c = LU^{-1}*d (damp is not used)
 			// L
@@ -444,8 +477,43 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			return true;
 		}
 
+	///	applies the factors stored in single precision
+		bool applyLU_float(vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(ILUT_step_float, "ilut algebra");
+			// L (unit diagonal, only the strictly lower part is stored)
+			for(size_t i=0; i < m_floatL.num_rows(); i++)
+			{
+				vector_value s = d[i];
+				m_floatL.sub_mult(s, m_floatL.row_begin(i), m_floatL.row_end(i), c);
+				c[i] = s;
+			}
+
+			// U (diagonal is the first entry of each row)
+			block_type uii;
+			for(size_t i=m_floatU.num_rows(); i > 0; )
+			{
+				--i;
+				UG_ASSERT(m_floatU.has_diag(i), i);
+				vector_value s = c[i];
+				m_floatU.sub_mult(s, m_floatU.upper_begin(i), m_floatU.row_end(i), c);
+
+				// c[i] = s/uii;
+				m_floatU.get_block(uii, m_floatU.lower_end(i));
+				InverseMatMult(c[i], 1.0, uii, s);
+			}
+			return true;
+		}
+
 		virtual bool multi_apply(std::vector<vector_type> &vc, const std::vector<vector_type> &vd)
 		{
+			if(m_bFloatStorage)
+			{
+				for(size_t e=0; e<vc.size(); e++)
+					if(!applyLU_float(vc[e], vd[e])) return false;
+				return true;
+			}
+
 			PROFILE_BEGIN_GROUP(ILUT_step, "ilut algebra");
 			// apply iterator: c = LU^{-1}*d (damp is not used)
 			// L
@@ -541,6 +609,10 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 		bool m_bSort;
 
 		bool m_bSortIsIdentity;
+
+		bool m_bFloatStorage;
+		float_matrix_type m_floatL;
+		float_matrix_type m_floatU;
 };
 
 // define constant
@@ -114,16 +114,17 @@ class Jacobi : public IPreconditioner<TAlgebra>
 
 	public:
 	///	default constructor
-		Jacobi() {this->set_damp(1.0);};
+		Jacobi() : m_bFloatStorage(false) {this->set_damp(1.0);};
 
 	///	constructor setting the damping parameter
-		Jacobi(number damp) {this->set_damp(damp);};
+		Jacobi(number damp) : m_bFloatStorage(false) {this->set_damp(damp);};
 
 	/// clone constructor
 		Jacobi( const Jacobi<TAlgebra> &parent )
 			: base_type(parent)
 		{
 			set_block(parent.m_bBlock);
+			m_bFloatStorage = parent.m_bFloatStorage;
 		}
 
 	///	Clone
@@ -146,6 +147,21 @@ class Jacobi : public IPreconditioner<TAlgebra>
 			m_bBlock = b;
 		}
 
+	///	stores the inverse diagonal in single precision
+	/**	The inverse is computed in double precision and then stored as float,
+	 * the correction is accumulated in double precision. Only available for
+	 * blocks of static size. Disabled by default.
+	 * Changing the setting requires a new init.*/
+		void set_float_storage(bool enable)
+		{
+			UG_COND_THROW(enable && !block_traits<value_type>::is_static,
+			              "Jacobi: float storage is only available for blocks of static size.");
+		//	the storage of the current preprocess does not match anymore
+			if(enable != m_bFloatStorage)
+				this->m_bInit = false;
+			m_bFloatStorage = enable;
+		}
+
 	protected:
 	///	Name of preconditioner
 		virtual const char* name() const {return "Jacobi";}
@@ -166,7 +182,16 @@ class Jacobi : public IPreconditioner<TAlgebra>
 			}
 
 			//	resize
-			m_diagInv.resize(size);
+			if(m_bFloatStorage)
+			{
+				m_diagInv.clear();
+				m_vFloatDiagInv.resize(size * blockRows * blockRows);
+			}
+			else
+			{
+				m_diagInv.resize(size);
+				m_vFloatDiagInv.clear();
+			}
 #ifdef UG_PARALLEL
 					//	temporary vector for the diagonal
 			ParallelVector<Vector< typename matrix_type::value_type > > diag;
@@ -211,7 +236,17 @@ class Jacobi : public IPreconditioner<TAlgebra>
 				else
 					m = d;
 				m *= 1./damp;
-				GetInverse(m_diagInv[i], m);
+				if(m_bFloatStorage)
+				{
+					if(!Invert(m))
+						UG_THROW("Jacobi: diagonal block " << i << " is not invertible.");
+					float* inv = &m_vFloatDiagInv[i * blockRows * blockRows];
+					for(size_t r = 0; r < (size_t)blockRows; ++r)
+						for(size_t c = 0; c < (size_t)blockRows; ++c)
+							inv[r * blockRows + c] = (float) BlockRef(m, r, c);
+				}
+				else
+					GetInverse(m_diagInv[i], m);
 			}
 
 		//	done
@@ -224,10 +259,19 @@ class Jacobi : public IPreconditioner<TAlgebra>
 
 		// 	multiply defect with diagonal, c = damp * D^{-1} * d
 		//	note, that the damping is already included in the inverse diagonal
-			for(size_t i = 0; i < m_diagInv.size(); ++i)
+			if(m_bFloatStorage)
+				step_float(c, d);
+			else
 			{
-			// 	c[i] = m_diagInv[i] * d[i];
-				MatMult(c[i], 1.0, m_diagInv[i], d[i]);
+				const size_t numDiag = m_diagInv.size();
+#ifdef UG_OPENMP
+				#pragma omp parallel for schedule(static) if(numDiag >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+				for(size_t i = 0; i < numDiag; ++i)
+				{
+				// 	c[i] = m_diagInv[i] * d[i];
+					MatMult(c[i], 1.0, m_diagInv[i], d[i]);
+				}
 			}
 
 #ifdef UG_PARALLEL
@@ -247,6 +291,28 @@ class Jacobi : public IPreconditioner<TAlgebra>
 			return true;
 		}
 
+	///	computes c = damp * D^{-1} * d with the inverse diagonal in single precision
+		void step_float(vector_type& c, const vector_type& d) const
+		{
+			const size_t numDiag = c.size();
+#ifdef UG_OPENMP
+			#pragma omp parallel for schedule(static) if(numDiag >= UG_CPU_ALGEBRA_OMP_MIN_SIZE)
+#endif
+			for(size_t i = 0; i < numDiag; ++i)
+			{
+				const float* inv = &m_vFloatDiagInv[i * blockRows * blockRows];
+				const typename vector_type::value_type& di = d[i];
+				typename vector_type::value_type& ci = c[i];
+				for(size_t r = 0; r < (size_t)blockRows; ++r)
+				{
+					double sum = 0.0;
+					for(size_t k = 0; k < (size_t)blockRows; ++k)
+						sum += inv[r * blockRows + k] * BlockRef(di, k);
+					BlockRef(ci, r) = sum;
+				}
+			}
+		}
+
 	///	Postprocess routine
 		virtual bool postprocess() {return true;}
 
@@ -299,13 +365,23 @@ class Jacobi : public IPreconditioner<TAlgebra>
 		}
 
 	protected:
+	///	block type
+		typedef typename matrix_type::value_type value_type;
+
 	///	type of block-inverse
-		typedef typename block_traits<typename matrix_type::value_type>::inverse_type inverse_type;
+		typedef typename block_traits<value_type>::inverse_type inverse_type;
+
+	///	number of rows of a block (if static)
+		enum { blockRows = block_traits<value_type>::static_num_rows };
 
 	///	storage of the inverse diagonal in parallel
 		std::vector<inverse_type> m_diagInv;
 		bool m_bBlock;
 
+	///	inverse diagonal in single precision (row-wise blocks, if enabled)
+		bool m_bFloatStorage;
+		std::vector<float> m_vFloatDiagInv;
+
 
 };
 
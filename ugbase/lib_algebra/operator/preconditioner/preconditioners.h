@@ -34,6 +34,7 @@
 #define __UG__PRECONDITIONERS_H__
 
 #include "lib_algebra/operator/preconditioner/jacobi.h"
+#include "lib_algebra/operator/preconditioner/chebyshev.h"
 #include "lib_algebra/operator/preconditioner/gauss_seidel.h"
 #include "lib_algebra/operator/preconditioner/ilu.h"
 #include "lib_algebra/operator/preconditioner/ilut.h"
@@ -41,4 +42,5 @@
 #include "lib_algebra/operator/preconditioner/vanka.h"
 #include "lib_algebra/operator/preconditioner/schur/schur_precond.h"
 #include "lib_algebra/operator/preconditioner/transforming.h"
+#include "lib_algebra/operator/preconditioner/aggregation_amg.h"
 #endif /* __UG__PRECONDITIONERS_H__ */
@@ -251,6 +251,14 @@ public:
 // 	Apply Operator, i.e. f = f - L*u;
 	virtual void apply_sub(Y& f, const X& u) {m_op->apply_sub(f,u);}
 
+#ifdef UG_PARALLEL
+// 	Make u consistent and apply f = L*u (uses the Schur complement apply)
+	virtual void apply_and_make_consistent(Y& f, X& u)
+	{
+		ILinearOperator<X,Y>::apply_and_make_consistent(f,u);
+	}
+#endif
+
 // 	Access to matrix
 	virtual M& get_matrix() {return *this;};
 };
@@ -136,6 +136,17 @@ class ParallelMatrix : public TMatrix
 		template<typename TPVector>
 		bool matmul_minus(TPVector &res, const TPVector &x) const;
 
+	/// changes x to consistent and calculates res = A x
+	/**
+	 * If the matrix is additive and x is additive or unique, the interface
+	 * communication of x is started non-blocking, and the rows of A that are
+	 * not coupled to interface indices are computed while it runs. The
+	 * remaining rows are computed when the communication has finished.
+	 * Otherwise, this is the same as change_storage_type and apply.
+	 */
+		template<typename TPVector>
+		bool apply_and_make_consistent(TPVector &res, TPVector &x) const;
+
 	///	assignment
 		this_type &operator =(const this_type &M);
 
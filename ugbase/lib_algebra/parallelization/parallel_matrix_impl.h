@@ -197,6 +197,69 @@ matmul_minus(TPVector &res, const TPVector &x) const
 }
 
 
+// make x consistent and calculate res = A x
+template <typename TMatrix>
+template<typename TPVector>
+bool
+ParallelMatrix<TMatrix>::
+apply_and_make_consistent(TPVector &res, TPVector &x) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+
+//	only additive matrices with additive (or unique) x are overlapped, the
+//	overlap-copy of CopyValues is not split up
+	if(x.has_storage_type(PST_CONSISTENT) || !x.has_storage_type(PST_ADDITIVE)
+		|| !has_storage_type(PST_ADDITIVE) || x.layouts().invalid()
+		|| x.layouts()->overlap_enabled())
+	{
+		if(!x.change_storage_type(PST_CONSISTENT))
+			UG_THROW("ParallelMatrix::apply_and_make_consistent: "
+					"Cannot change parallel storage type of x to consistent.");
+		return apply(res, x);
+	}
+
+	const IndexLayout& masterLayout = x.layouts()->master();
+	const IndexLayout& slaveLayout = x.layouts()->slave();
+	pcl::InterfaceCommunicator<IndexLayout>& com = x.layouts()->comm();
+
+//	mark the entries of x changed by the communication (local, such that
+//	concurrent calls on the same matrix are possible)
+	const size_t numRows = this->num_rows();
+	std::vector<char> vInterfaceMark(x.size(), 0);
+	std::vector<char> vCoupledRow(numRows);
+	SetLayoutValues(&vInterfaceMark, masterLayout, 1);
+	SetLayoutValues(&vInterfaceMark, slaveLayout, 1);
+
+//	additive: step 1 (add slave values to master), overlapped with the
+//	first half of the rows
+	const size_t half = x.has_storage_type(PST_UNIQUE) ? 0 : numRows / 2;
+	ComPol_VecAdd<TPVector> cpVecAdd(&x);
+	if(half > 0)
+	{
+		com.send_data(slaveLayout, cpVecAdd);
+		com.receive_data(masterLayout, cpVecAdd);
+		com.communicate_and_resume();
+		TMatrix::apply_unmarked_rows(res, x, vInterfaceMark, vCoupledRow, 0, half);
+		com.wait();
+	}
+
+//	step 2: copy master values to slaves, overlapped with the remaining rows
+	ComPol_VecCopy<TPVector> cpVecCopy(&x);
+	com.send_data(masterLayout, cpVecCopy);
+	com.receive_data(slaveLayout, cpVecCopy);
+	com.communicate_and_resume();
+	TMatrix::apply_unmarked_rows(res, x, vInterfaceMark, vCoupledRow, half, numRows);
+	com.wait();
+	x.set_storage_type(PST_CONSISTENT);
+
+//	rows coupled to the interface
+	TMatrix::apply_skipped_rows(res, x, vCoupledRow);
+
+	res.set_storage_type(PST_ADDITIVE);
+	return true;
+}
+
+
 template<typename matrix_type, typename vector_type>
 ug::ParallelStorageType GetMultType(const ParallelMatrix<matrix_type> &A1, const ParallelVector<vector_type> &x)
 {
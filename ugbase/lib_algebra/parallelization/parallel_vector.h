@@ -148,6 +148,22 @@ class ParallelVector : public TVector
 	 */
 		inline number dotprod(const this_type& v);
 
+	///	process-local part of the dot product
+	/**
+	 * Changes the storage types as dotprod() does and returns the dot product
+	 * of the process-local entries, i.e. the value that dotprod() sums over
+	 * all processes. This allows to sum several products in one reduction.
+	 */
+		inline number local_dotprod(const this_type& v);
+
+	///	process-local part of the squared two norm
+	/**
+	 * Changes the storage type to unique and returns the squared two norm of
+	 * the process-local entries, i.e. the value that norm() sums over all
+	 * processes before taking the square root.
+	 */
+		number local_norm_squared() const;
+
 	/// assign number to whole Vector
 		number operator = (number d);
 
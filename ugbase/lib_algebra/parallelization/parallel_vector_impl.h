@@ -268,17 +268,25 @@ set_random(number from, number to, ParallelStorageType type)
 
 template <typename TVector>
 inline
-number ParallelVector<TVector>::norm() const
+number ParallelVector<TVector>::local_norm_squared() const
 {
-	PROFILE_FUNC_GROUP("algebra parallelization");
 	// 	step 1: make vector d additive unique
 	if(!const_cast<ParallelVector<TVector>*>(this)->change_storage_type(PST_UNIQUE))
-		UG_THROW("ParallelVector::norm(): Cannot change"
+		UG_THROW("ParallelVector::local_norm_squared(): Cannot change"
 				" ParallelStorageType to unique.");
 
 	// 	step 2: compute process-local defect norm, square them
 	double tNormLocal = (double)TVector::norm();
-	tNormLocal *= tNormLocal;
+	return tNormLocal * tNormLocal;
+}
+
+template <typename TVector>
+inline
+number ParallelVector<TVector>::norm() const
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	// 	step 1, 2: compute squared local norm of unique vector
+	double tNormLocal = local_norm_squared();
 
 	// 	step 3: sum squared local norms
 	PARVEC_PROFILE_BEGIN(ParVec_norm_allreduce);
@@ -295,15 +303,14 @@ number ParallelVector<TVector>::norm() const
 
 template <typename TVector>
 inline
-number ParallelVector<TVector>::dotprod(const this_type& v)
+number ParallelVector<TVector>::local_dotprod(const this_type& v)
 {
-	PROFILE_FUNC_GROUP("algebra parallelization");
 	// 	step 0: check that storage type is given
 	if(this->has_storage_type(PST_UNDEFINED) || v.has_storage_type(PST_UNDEFINED))
 	{
-		UG_LOG("ERROR in 'ParallelVector::dotprod': "
+		UG_LOG("ERROR in 'ParallelVector::local_dotprod': "
 				"Parallel storage type of vector not given.\n");
-		UG_THROW("ERROR in ParallelVector::dotprod(): No parallel "
+		UG_THROW("ERROR in ParallelVector::local_dotprod(): No parallel "
 				"Storage type given.");
 	}
 
@@ -337,7 +344,16 @@ number ParallelVector<TVector>::dotprod(const this_type& v)
 	}
 
 	// 	step 3: compute local dot product
-	double tSumLocal = (double)TVector::dotprod(v);
+	return TVector::dotprod(v);
+}
+
+template <typename TVector>
+inline
+number ParallelVector<TVector>::dotprod(const this_type& v)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	// 	step 0 - 3: compute local dot product with suitable storage types
+	double tSumLocal = (double)local_dotprod(v);
 	double tSumGlobal;
 
 	// 	step 4: sum global contributions
@@ -483,6 +499,20 @@ inline double VecProd(const ParallelVector<T> &a, const ParallelVector<T> &b)
 	return const_cast<ParallelVector<T>* >(&a)->dotprod(b);
 }
 
+// returns the process-local part of scal<a, b>
+template<typename T>
+inline double VecProdLocal(const ParallelVector<T> &a, const ParallelVector<T> &b)
+{
+	return const_cast<ParallelVector<T>* >(&a)->local_dotprod(b);
+}
+
+// returns the process-local part of norm_2^2(a)
+template<typename T>
+inline double VecNormSquaredLocal(const ParallelVector<T> &a)
+{
+	return a.local_norm_squared();
+}
+
 // Elementwise (Hadamard) product of two vectors
 template<typename T>
 inline void VecHadamardProd(ParallelVector<T> &dest, const ParallelVector<T> &v1, const ParallelVector<T> &v2)
@@ -50,6 +50,7 @@
 #endif
 
 #include "small_matrix/densematrix_inverse.h"
+#include "small_matrix/densematrix_fixed_kernels.h"
 
 
 #endif /* __H__UG__SMALL_ALGEBRA__ */
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__SMALL_ALGEBRA__DENSEMATRIX_FIXED_KERNELS_H__
+#define __H__UG__SMALL_ALGEBRA__DENSEMATRIX_FIXED_KERNELS_H__
+
+#include <algorithm>
+#include <boost/core/enable_if.hpp>
+#include "densematrix.h"
+#include "densevector.h"
+#include "../storage/fixed_array_simd.h"
+
+namespace ug{
+
+/// \addtogroup small_algebra
+/// \{
+
+/**
+ * Kernels for the blocks of CPUBlockAlgebra<N>, i.e.
+ * DenseMatrix<FixedArray2<double, N, N> > (column-major) and
+ * DenseVector<FixedArray1<double, N> > for N = 2, ..., 6.
+ *
+ * The overloads below are more specialized than the generic templates in
+ * densematrix_operations.h, block_dense.h, densematrix_inverse.h and
+ * operations_vec.h and are therefore picked at compile time. All products
+ * are computed column by column with FixedSimdColumn<N>, so that one block
+ * column is one SIMD register (or a few), see fixed_array_simd.h.
+ * For N = 1 and N > 6 (and row-major storage), the generic versions are used.
+ */
+template<size_t N>
+struct fixed_block_kernel_traits
+{
+	enum {enabled = (N >= 2 && N <= 6)};
+
+//	for N <= 3 the closed form inverses in densematrix_inverse.h are cheaper
+	enum {lu_enabled = (N >= 4 && N <= 6)};
+};
+
+//! dest[0..N-1] = alpha*v + beta*A*w (dest may alias v or w)
+template<size_t N>
+inline void FixedBlockMatMultAdd(double *dest, double alpha, const double *v,
+		double beta, const double *A, const double *w)
+{
+	FixedSimdColumn<N> s;
+	s.load(v);
+	s.scale(alpha);
+	for(size_t c = 0; c < N; ++c)
+		s.add_scaled(beta*w[c], A+c*N);
+	s.store(dest);
+}
+
+//! dest[0..N-1] = beta*A*w (dest may alias w)
+template<size_t N>
+inline void FixedBlockMatMult(double *dest, double beta, const double *A, const double *w)
+{
+	FixedSimdColumn<N> s;
+	s.set_zero();
+	for(size_t c = 0; c < N; ++c)
+		s.add_scaled(beta*w[c], A+c*N);
+	s.store(dest);
+}
+
+//! D = sign*A*B (bAdd = false) or D += sign*A*B (bAdd = true). D must not alias A or B.
+template<size_t N>
+inline void FixedBlockMatMatMult(double *D, bool bAdd, double sign, const double *A, const double *B)
+{
+	for(size_t j = 0; j < N; ++j)
+	{
+		FixedSimdColumn<N> d;
+		if(bAdd) d.load(D+j*N);
+		else d.set_zero();
+		for(size_t k = 0; k < N; ++k)
+			d.add_scaled(sign*B[k+j*N], A+k*N);
+		d.store(D+j*N);
+	}
+}
+
+/**
+ * in-place LU decomposition with partial pivoting of the column-major
+ * N x N matrix a, such that P*A = L*U. The unit lower triangular L is stored
+ * below the diagonal, piv[k] is the row swapped with row k in step k.
+ * The update of the trailing columns is done with full SIMD columns.
+ * \return false if the matrix is singular
+ */
+template<size_t N>
+inline bool FixedBlockLUDecomp(double *a, size_t *piv)
+{
+	for(size_t k = 0; k < N; ++k)
+	{
+		double *ak = a + k*N;
+
+	//	find pivot
+		size_t p = k;
+		double m = dabs(ak[k]);
+		for(size_t r = k+1; r < N; ++r)
+			if(dabs(ak[r]) > m) { m = dabs(ak[r]); p = r; }
+		if(m == 0.0) return false;
+
+		piv[k] = p;
+		if(p != k)
+			for(size_t c = 0; c < N; ++c)
+				std::swap(a[k+c*N], a[p+c*N]);
+
+	//	multipliers l = a(k+1:N, k) / a(k,k)
+		const double inv = 1.0/ak[k];
+		FixedSimdColumn<N> l;
+		l.load(ak);
+		l.zero_until(k);
+		l.scale(inv);
+
+	//	a(k+1:N, j) -= l * a(k, j)
+		for(size_t j = k+1; j < N; ++j)
+		{
+			FixedSimdColumn<N> c;
+			c.load(a+j*N);
+			c.add_scaled(-a[k+j*N], l);
+			c.store(a+j*N);
+		}
+
+		for(size_t r = k+1; r < N; ++r)
+			ak[r] *= inv;
+	}
+	return true;
+}
+
+//! solves L*U x = P*b in-place (x = b on entry) with the factors of FixedBlockLUDecomp
+template<size_t N>
+inline void FixedBlockLUSolve(const double *a, const size_t *piv, double *x)
+{
+	for(size_t k = 0; k < N; ++k)
+		if(piv[k] != k) std::swap(x[k], x[piv[k]]);
+
+	for(size_t k = 0; k < N; ++k)
+	{
+		const double xk = x[k];
+		for(size_t r = k+1; r < N; ++r)
+			x[r] -= a[r+k*N]*xk;
+	}
+
+	for(size_t k = N; k-- > 0; )
+	{
+		x[k] /= a[k+k*N];
+		const double xk = x[k];
+		for(size_t r = 0; r < k; ++r)
+			x[r] -= a[r+k*N]*xk;
+	}
+}
+
+
+//////////////////////////////////////////////////////
+// matrix-vector
+
+//! calculates dest = beta1 * A1 * w1;
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+MatMult(DenseVector<FixedArray1<double, N> > &dest,
+		const number &beta1, const DenseMatrix<FixedArray2<double, N, N> > &A1,
+		const DenseVector<FixedArray1<double, N> > &w1)
+{
+	FixedBlockMatMult<N>(&dest[0], beta1, &A1(0,0), &w1[0]);
+}
+
+//! calculates dest = alpha1*v1 + beta1 * A1 *w1;
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+MatMultAdd(DenseVector<FixedArray1<double, N> > &dest,
+		const number &alpha1, const DenseVector<FixedArray1<double, N> > &v1,
+		const number &beta1, const DenseMatrix<FixedArray2<double, N, N> > &A1,
+		const DenseVector<FixedArray1<double, N> > &w1)
+{
+	FixedBlockMatMultAdd<N>(&dest[0], alpha1, &v1[0], beta1, &A1(0,0), &w1[0]);
+}
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+AssignMult(DenseVector<FixedArray1<double, N> > &dest,
+		const DenseMatrix<FixedArray2<double, N, N> > &mat,
+		const DenseVector<FixedArray1<double, N> > &vec)
+{
+	FixedBlockMatMult<N>(&dest[0], 1.0, &mat(0,0), &vec[0]);
+}
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+AddMult(DenseVector<FixedArray1<double, N> > &dest,
+		const DenseMatrix<FixedArray2<double, N, N> > &mat,
+		const DenseVector<FixedArray1<double, N> > &vec)
+{
+	FixedBlockMatMultAdd<N>(&dest[0], 1.0, &dest[0], 1.0, &mat(0,0), &vec[0]);
+}
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+SubMult(DenseVector<FixedArray1<double, N> > &dest,
+		const DenseMatrix<FixedArray2<double, N, N> > &mat,
+		const DenseVector<FixedArray1<double, N> > &vec)
+{
+	FixedBlockMatMultAdd<N>(&dest[0], 1.0, &dest[0], -1.0, &mat(0,0), &vec[0]);
+}
+
+
+//////////////////////////////////////////////////////
+// matrix-matrix
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+AssignMult(DenseMatrix<FixedArray2<double, N, N> > &dest,
+		const DenseMatrix<FixedArray2<double, N, N> > &mA,
+		const DenseMatrix<FixedArray2<double, N, N> > &mB)
+{
+	if(&dest == &mA || &dest == &mB)
+	{
+		DenseMatrix<FixedArray2<double, N, N> > tmp;
+		FixedBlockMatMatMult<N>(&tmp(0,0), false, 1.0, &mA(0,0), &mB(0,0));
+		dest = tmp;
+	}
+	else
+		FixedBlockMatMatMult<N>(&dest(0,0), false, 1.0, &mA(0,0), &mB(0,0));
+}
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+AddMult(DenseMatrix<FixedArray2<double, N, N> > &dest,
+		const DenseMatrix<FixedArray2<double, N, N> > &mA,
+		const DenseMatrix<FixedArray2<double, N, N> > &mB)
+{
+	if(&dest == &mA || &dest == &mB)
+	{
+		DenseMatrix<FixedArray2<double, N, N> > tmp;
+		FixedBlockMatMatMult<N>(&tmp(0,0), false, 1.0, &mA(0,0), &mB(0,0));
+		dest += tmp;
+	}
+	else
+		FixedBlockMatMatMult<N>(&dest(0,0), true, 1.0, &mA(0,0), &mB(0,0));
+}
+
+
+//////////////////////////////////////////////////////
+// inverse
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::lu_enabled, bool>::type
+Invert(DenseMatrix<FixedArray2<double, N, N> > &mat)
+{
+	double a[N*N];
+	size_t piv[N];
+	std::copy(&mat(0,0), &mat(0,0)+N*N, a);
+	if(!FixedBlockLUDecomp<N>(a, piv)) return false;
+
+	double *inv = &mat(0,0);
+	for(size_t j = 0; j < N; ++j)
+	{
+		double *x = inv + j*N;
+		for(size_t r = 0; r < N; ++r) x[r] = 0.0;
+		x[j] = 1.0;
+		FixedBlockLUSolve<N>(a, piv, x);
+	}
+	return true;
+}
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::lu_enabled, bool>::type
+InverseMatMult(DenseVector<FixedArray1<double, N> > &dest, double beta,
+		const DenseMatrix<FixedArray2<double, N, N> > &mat,
+		const DenseVector<FixedArray1<double, N> > &vec)
+{
+	double a[N*N];
+	size_t piv[N];
+	std::copy(&mat(0,0), &mat(0,0)+N*N, a);
+	if(!FixedBlockLUDecomp<N>(a, piv)) return false;
+
+	double x[N];
+	for(size_t r = 0; r < N; ++r) x[r] = vec[r];
+	FixedBlockLUSolve<N>(a, piv, x);
+	for(size_t r = 0; r < N; ++r) dest[r] = beta*x[r];
+	return true;
+}
+
+
+//////////////////////////////////////////////////////
+// vector
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+VecScaleAssign(DenseVector<FixedArray1<double, N> > &dest, double alpha1,
+		const DenseVector<FixedArray1<double, N> > &v1)
+{
+	FixedSimdColumn<N> s;
+	s.load(&v1[0]);
+	s.scale(alpha1);
+	s.store(&dest[0]);
+}
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+VecScaleAdd(DenseVector<FixedArray1<double, N> > &dest,
+		double alpha1, const DenseVector<FixedArray1<double, N> > &v1,
+		double alpha2, const DenseVector<FixedArray1<double, N> > &v2)
+{
+	FixedSimdColumn<N> s;
+	s.load(&v1[0]);
+	s.scale(alpha1);
+	s.add_scaled(alpha2, &v2[0]);
+	s.store(&dest[0]);
+}
+
+template<size_t N>
+inline typename boost::enable_if_c<fixed_block_kernel_traits<N>::enabled, void>::type
+VecScaleAdd(DenseVector<FixedArray1<double, N> > &dest,
+		double alpha1, const DenseVector<FixedArray1<double, N> > &v1,
+		double alpha2, const DenseVector<FixedArray1<double, N> > &v2,
+		double alpha3, const DenseVector<FixedArray1<double, N> > &v3)
+{
+	FixedSimdColumn<N> s;
+	s.load(&v1[0]);
+	s.scale(alpha1);
+	s.add_scaled(alpha2, &v2[0]);
+	s.add_scaled(alpha3, &v3[0]);
+	s.store(&dest[0]);
+}
+
+// end group small_algebra
+/// \}
+
+}
+
+#endif // __H__UG__SMALL_ALGEBRA__DENSEMATRIX_FIXED_KERNELS_H__
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__SMALL_ALGEBRA__FIXED_ARRAY_SIMD_H__
+#define __H__UG__SMALL_ALGEBRA__FIXED_ARRAY_SIMD_H__
+
+#include <cstddef>
+
+#if defined(__SSE2__) && !defined(UG_NO_SIMD)
+	#include <immintrin.h>
+	#define UG_SIMD_SSE2
+	#if defined(__AVX__)
+		#define UG_SIMD_AVX
+	#endif
+#endif
+
+namespace ug{
+
+/// \addtogroup small_algebra
+/// \{
+
+/**
+ * FixedSimdColumn<N> holds one column of a column-major
+ * FixedArray2<double, N, N> (or one FixedArray1<double, N>) in SIMD registers.
+ * It only provides the operations needed by the fixed size block kernels in
+ * densematrix_fixed_kernels.h, all of them working on full columns.
+ *
+ * The instruction set is selected at compile time by the compiler flags
+ * (e.g. -mavx2 -mfma, -mavx512f or -march=native):
+ * - AVX: N = 4 uses one 256 bit register, N = 3, 5, 6 are composed of
+ *   smaller columns (e.g. 6 = 4 + 2). AVX-512 builds use the same path:
+ *   masked 512 bit columns for N = 3, 5, 6 turned out to be slower in SpMV
+ *   and in the block LU than the composed columns.
+ * - SSE2: N = 2 uses one 128 bit register, larger N are composed
+ * - otherwise (or if UG_NO_SIMD is defined), the generic template is used,
+ *   which is a plain loop over the N entries.
+ *
+ * Loads and stores are unaligned, since the blocks are stored in std::vectors.
+ */
+template<size_t N>
+struct FixedSimdColumn
+{
+	double v[N];
+
+	inline void load(const double *p)
+	{ for(size_t i=0; i<N; i++) v[i] = p[i]; }
+
+	inline void store(double *p) const
+	{ for(size_t i=0; i<N; i++) p[i] = v[i]; }
+
+	inline void set_zero()
+	{ for(size_t i=0; i<N; i++) v[i] = 0.0; }
+
+	//! this *= a
+	inline void scale(double a)
+	{ for(size_t i=0; i<N; i++) v[i] *= a; }
+
+	//! this += a*p[0..N-1]
+	inline void add_scaled(double a, const double *p)
+	{ for(size_t i=0; i<N; i++) v[i] += a*p[i]; }
+
+	//! this += a*x
+	inline void add_scaled(double a, const FixedSimdColumn<N> &x)
+	{ for(size_t i=0; i<N; i++) v[i] += a*x.v[i]; }
+
+	//! sets all entries with index <= k to zero
+	inline void zero_until(int k)
+	{ for(int i=0; i<(int)N && i<=k; i++) v[i] = 0.0; }
+};
+
+//! a column composed of two smaller columns of size N1 and N2
+template<size_t N1, size_t N2>
+struct FixedSimdColumnPair
+{
+	FixedSimdColumn<N1> a;
+	FixedSimdColumn<N2> b;
+
+	inline void load(const double *p) { a.load(p); b.load(p+N1); }
+	inline void store(double *p) const { a.store(p); b.store(p+N1); }
+	inline void set_zero() { a.set_zero(); b.set_zero(); }
+	inline void scale(double s) { a.scale(s); b.scale(s); }
+	inline void add_scaled(double s, const double *p)
+	{ a.add_scaled(s, p); b.add_scaled(s, p+N1); }
+	inline void add_scaled(double s, const FixedSimdColumnPair<N1, N2> &x)
+	{ a.add_scaled(s, x.a); b.add_scaled(s, x.b); }
+	inline void zero_until(int k) { a.zero_until(k); b.zero_until(k-(int)N1); }
+};
+
+#ifdef UG_SIMD_SSE2
+template<>
+struct FixedSimdColumn<2>
+{
+	__m128d v;
+
+	inline void load(const double *p) { v = _mm_loadu_pd(p); }
+	inline void store(double *p) const { _mm_storeu_pd(p, v); }
+	inline void set_zero() { v = _mm_setzero_pd(); }
+	inline void scale(double a) { v = _mm_mul_pd(v, _mm_set1_pd(a)); }
+	inline void add_scaled(double a, const double *p)
+	{ add(_mm_set1_pd(a), _mm_loadu_pd(p)); }
+	inline void add_scaled(double a, const FixedSimdColumn<2> &x)
+	{ add(_mm_set1_pd(a), x.v); }
+	inline void zero_until(int k)
+	{ v = _mm_and_pd(v, _mm_cmpgt_pd(_mm_set_pd(1.0, 0.0), _mm_set1_pd(k))); }
+
+private:
+	inline void add(__m128d a, __m128d x)
+	{
+#ifdef __FMA__
+		v = _mm_fmadd_pd(a, x, v);
+#else
+		v = _mm_add_pd(v, _mm_mul_pd(a, x));
+#endif
+	}
+};
+#endif
+
+#ifdef UG_SIMD_AVX
+template<>
+struct FixedSimdColumn<4>
+{
+	__m256d v;
+
+	inline void load(const double *p) { v = _mm256_loadu_pd(p); }
+	inline void store(double *p) const { _mm256_storeu_pd(p, v); }
+	inline void set_zero() { v = _mm256_setzero_pd(); }
+	inline void scale(double a) { v = _mm256_mul_pd(v, _mm256_set1_pd(a)); }
+	inline void add_scaled(double a, const double *p)
+	{ add(_mm256_set1_pd(a), _mm256_loadu_pd(p)); }
+	inline void add_scaled(double a, const FixedSimdColumn<4> &x)
+	{ add(_mm256_set1_pd(a), x.v); }
+	inline void zero_until(int k)
+	{
+		v = _mm256_and_pd(v, _mm256_cmp_pd(_mm256_set_pd(3.0, 2.0, 1.0, 0.0),
+				_mm256_set1_pd(k), _CMP_GT_OQ));
+	}
+
+private:
+	inline void add(__m256d a, __m256d x)
+	{
+#ifdef __FMA__
+		v = _mm256_fmadd_pd(a, x, v);
+#else
+		v = _mm256_add_pd(v, _mm256_mul_pd(a, x));
+#endif
+	}
+};
+#elif defined(UG_SIMD_SSE2)
+template<> struct FixedSimdColumn<4> : public FixedSimdColumnPair<2, 2> {};
+#endif
+
+#ifdef UG_SIMD_SSE2
+template<> struct FixedSimdColumn<3> : public FixedSimdColumnPair<2, 1> {};
+template<> struct FixedSimdColumn<5> : public FixedSimdColumnPair<4, 1> {};
+template<> struct FixedSimdColumn<6> : public FixedSimdColumnPair<4, 2> {};
+#endif
+
+// end group small_algebra
+/// \}
+
+}
+
+#endif // __H__UG__SMALL_ALGEBRA__FIXED_ARRAY_SIMD_H__
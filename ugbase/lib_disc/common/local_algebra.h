@@ -195,19 +195,25 @@ class LocalVector
 
 	public:
 	///	default Constructor
-		LocalVector() : m_pIndex(NULL) {m_vvValue.clear();}
+		LocalVector() : m_pIndex(NULL), m_pFuncMap(NULL), m_vOffset(1, 0) {}
 
 	///	Constructor
-		LocalVector(const LocalIndices& ind) {resize(ind);}
+		LocalVector(const LocalIndices& ind) : m_pFuncMap(NULL) {resize(ind);}
 
 	///	resize for current local indices
+	/**
+	 * All entries are stored in one contiguous array, ordered by function and
+	 * dof. The array keeps its capacity, thus resizing for another element of
+	 * the same type does not allocate memory.
+	 */
 		void resize(const LocalIndices& ind)
 		{
 			m_pIndex = &ind;
-			m_vvValue.resize(ind.num_fct());
-			m_vvValueAcc.resize(m_vvValue.size());
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				m_vvValue[fct].resize(ind.num_dof(fct));
+			m_vOffset.resize(ind.num_fct() + 1);
+			m_vOffset[0] = 0;
+			for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+				m_vOffset[fct+1] = m_vOffset[fct] + ind.num_dof(fct);
+			m_vValue.resize(m_vOffset.back());
 			access_all();
 		}
 
@@ -221,9 +227,8 @@ class LocalVector
 	/// set all components of the vector
 		this_type& operator=(number val)
 		{
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] = val;
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] = val;
 			return *this;
 		}
 
@@ -236,9 +241,8 @@ class LocalVector
 	/// multiply all components of the vector
 		this_type& operator*=(number val)
 		{
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] *= val;
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] *= val;
 			return *this;
 		}
 
@@ -246,9 +250,8 @@ class LocalVector
 		this_type& operator+=(const this_type& rhs)
 		{
 			UG_LOCALALGEBRA_ASSERT(m_pIndex==rhs.m_pIndex, "Not same indices.");
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] += rhs.m_vvValue[fct][dof];
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] += rhs.m_vValue[i];
 			return *this;
 		}
 
@@ -256,9 +259,8 @@ class LocalVector
 		this_type& operator-=(const this_type& rhs)
 		{
 			UG_LOCALALGEBRA_ASSERT(m_pIndex==rhs.m_pIndex, "Not same indices.");
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] -= rhs.m_vvValue[fct][dof];
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] -= rhs.m_vValue[i];
 			return *this;
 		}
 
@@ -266,9 +268,8 @@ class LocalVector
 		this_type& scale_append(number s, const this_type& rhs)
 		{
 			UG_LOCALALGEBRA_ASSERT(m_pIndex==rhs.m_pIndex, "Not same indices.");
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] += s * rhs.m_vvValue[fct][dof];
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] += s * rhs.m_vValue[i];
 			return *this;
 		}
 
@@ -281,10 +282,7 @@ class LocalVector
 		{
 			m_pFuncMap = &funcMap;
 			for(size_t i = 0; i < funcMap.num_fct(); ++i)
-			{
-				const size_t mapFct = funcMap[i];
-				m_vvValueAcc[i] = &(m_vvValue[mapFct][0]);
-			}
+				m_vOffsetAcc[i] = m_vOffset[funcMap[i]];
 		}
 
 	///	access all functions
@@ -292,16 +290,17 @@ class LocalVector
 		{
 			m_pFuncMap = NULL;
 
-			if(m_pIndex==NULL) {m_vvValueAcc.clear(); return;}
+			if(m_pIndex==NULL) {m_vOffsetAcc.clear(); return;}
 
-			for(size_t i = 0; i < m_pIndex->num_fct(); ++i)
-				m_vvValueAcc[i] = &(m_vvValue[i][0]);
+			m_vOffsetAcc.resize(m_pIndex->num_fct());
+			for(size_t i = 0; i < m_vOffsetAcc.size(); ++i)
+				m_vOffsetAcc[i] = m_vOffset[i];
 		}
 
 	///	returns the number of currently accessible functions
 		size_t num_fct() const
 		{
-			if(m_pFuncMap == NULL) return m_vvValue.size();
+			if(m_pFuncMap == NULL) return num_all_fct();
 			return m_pFuncMap->num_fct();
 		}
 
@@ -318,22 +317,22 @@ class LocalVector
 		size_t num_dof(size_t fct) const
 		{
 			check_fct(fct);
-			if(m_pFuncMap == NULL) return m_vvValue[fct].size();
-			else return m_vvValue[ (*m_pFuncMap)[fct] ].size();
+			if(m_pFuncMap == NULL) return num_all_dof(fct);
+			else return num_all_dof((*m_pFuncMap)[fct]);
 		}
 
 	/// access to dof of currently accessible function fct
 		number& operator()(size_t fct, size_t dof)
 		{
 			check_dof(fct,dof);
-			return m_vvValueAcc[fct][dof];
+			return m_vValue[m_vOffsetAcc[fct] + dof];
 		}
 
 	/// const access to dof of currently accessible function fct
 		number operator()(size_t fct, size_t dof) const
 		{
 			check_dof(fct,dof);
-			return m_vvValueAcc[fct][dof];
+			return m_vValue[m_vOffsetAcc[fct] + dof];
 		}
 
 		///////////////////////////
@@ -341,16 +340,37 @@ class LocalVector
 		///////////////////////////
 
 	///	returns the number of all functions
-		size_t num_all_fct() const {return m_vvValue.size();}
+		size_t num_all_fct() const {return m_vOffset.size() - 1;}
 
 	///	returns the number of dofs for a function (unrestricted functions)
-		size_t num_all_dof(size_t fct) const {check_all_fct(fct); return m_vvValue[fct].size();}
+		size_t num_all_dof(size_t fct) const
+		{
+			check_all_fct(fct);
+			return m_vOffset[fct+1] - m_vOffset[fct];
+		}
 
 	/// access to dof of a fct (unrestricted functions)
-		number& value(size_t fct, size_t dof){check_all_dof(fct,dof);return m_vvValue[fct][dof];}
+		number& value(size_t fct, size_t dof)
+		{
+			check_all_dof(fct,dof);
+			return m_vValue[m_vOffset[fct] + dof];
+		}
 
 	/// const access to dof of a fct (unrestricted functions)
-		const number& value(size_t fct, size_t dof) const{check_all_dof(fct,dof);return m_vvValue[fct][dof];}
+		const number& value(size_t fct, size_t dof) const
+		{
+			check_all_dof(fct,dof);
+			return m_vValue[m_vOffset[fct] + dof];
+		}
+
+	///	returns the number of all dofs (all functions)
+		size_t size() const {return m_vValue.size();}
+
+	///	returns the contiguous array of all entries, ordered by (fct, dof)
+		value_type* data() {return m_vValue.empty() ? NULL : &m_vValue[0];}
+
+	///	returns the contiguous array of all entries, ordered by (fct, dof)
+		const value_type* data() const {return m_vValue.empty() ? NULL : &m_vValue[0];}
 
 	protected:
 	///	checks correct fct index in debug mode
@@ -385,11 +405,14 @@ class LocalVector
 	/// Access Mapping
 		const FunctionIndexMapping* m_pFuncMap;
 
-	/// Entries (fct, dof)
-		std::vector<value_type*> m_vvValueAcc;
+	///	Offset of first dof of each function in the value array (size: num_fct + 1)
+		std::vector<size_t> m_vOffset;
 
-	/// Entries (fct, dof)
-		std::vector<std::vector<value_type> > m_vvValue;
+	///	Offset of first dof of each currently accessible function
+		std::vector<size_t> m_vOffsetAcc;
+
+	/// Entries (fct, dof), stored contiguously
+		std::vector<value_type> m_vValue;
 };
 
 class LocalMatrix
@@ -405,7 +428,8 @@ class LocalMatrix
 	///	Constructor
 		LocalMatrix() :
 			m_pRowIndex(NULL), m_pColIndex(NULL) ,
-			m_pRowFuncMap(NULL), m_pColFuncMap(NULL)
+			m_pRowFuncMap(NULL), m_pColFuncMap(NULL),
+			m_vRowOffset(1, 0), m_vColOffset(1, 0)
 		{}
 
 	///	Constructor
@@ -419,20 +443,28 @@ class LocalMatrix
 		void resize(const LocalIndices& ind) {resize(ind, ind);}
 
 	///	resize for current local indices
+	/**
+	 * All couplings are stored in one contiguous, row-major array of size
+	 * (all row dofs) x (all col dofs), where the dofs are ordered by function.
+	 * The array keeps its capacity, thus resizing for another element of the
+	 * same type does not allocate memory.
+	 */
 		void resize(const LocalIndices& rowInd, const LocalIndices& colInd)
 		{
 			m_pRowIndex = &rowInd;
 			m_pColIndex = &colInd;
 
-			m_CplMat.resize(rowInd.num_fct(), colInd.num_fct());
-			m_CplMatAcc.resize(rowInd.num_fct(), colInd.num_fct());
+			m_vRowOffset.resize(rowInd.num_fct() + 1);
+			m_vRowOffset[0] = 0;
+			for(size_t fct = 0; fct < rowInd.num_fct(); ++fct)
+				m_vRowOffset[fct+1] = m_vRowOffset[fct] + rowInd.num_dof(fct);
 
-			for(size_t fct1 = 0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2 = 0; fct2 < m_CplMat.num_cols(); ++fct2)
-				{
-					m_CplMat(fct1, fct2).resize(colInd.num_dof(fct1),
-												rowInd.num_dof(fct2));
-				}
+			m_vColOffset.resize(colInd.num_fct() + 1);
+			m_vColOffset[0] = 0;
+			for(size_t fct = 0; fct < colInd.num_fct(); ++fct)
+				m_vColOffset[fct+1] = m_vColOffset[fct] + colInd.num_dof(fct);
+
+			m_vValue.resize(m_vRowOffset.back() * m_vColOffset.back());
 
 			access_all();
 		}
@@ -450,9 +482,8 @@ class LocalMatrix
 	/// set all entries
 		this_type& operator=(number val)
 		{
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					m_CplMat(fct1,fct2) = val;
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] = val;
 			return *this;
 		}
 
@@ -465,9 +496,8 @@ class LocalMatrix
 	/// multiply matrix
 		this_type& operator*=(number val)
 		{
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					m_CplMat(fct1,fct2) *= val;
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] *= val;
 			return *this;
 		}
 
@@ -476,9 +506,8 @@ class LocalMatrix
 		{
 			UG_LOCALALGEBRA_ASSERT(m_pRowIndex==rhs.m_pRowIndex &&
 			          m_pColIndex==rhs.m_pColIndex, "Not same indices.");
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					m_CplMat(fct1,fct2) += rhs.m_CplMat(fct1,fct2);
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] += rhs.m_vValue[i];
 			return *this;
 		}
 
@@ -487,9 +516,8 @@ class LocalMatrix
 		{
 			UG_LOCALALGEBRA_ASSERT(m_pRowIndex==rhs.m_pRowIndex &&
 			          m_pColIndex==rhs.m_pColIndex, "Not same indices.");
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					m_CplMat(fct1,fct2) -= rhs.m_CplMat(fct1,fct2);
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] -= rhs.m_vValue[i];
 			return *this;
 		}
 
@@ -498,9 +526,8 @@ class LocalMatrix
 		{
 			UG_LOCALALGEBRA_ASSERT(m_pRowIndex==rhs.m_pRowIndex &&
 					  m_pColIndex==rhs.m_pColIndex, "Not same indices.");
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					MatScaleAppend(m_CplMat(fct1,fct2), s, rhs.m_CplMat(fct1,fct2));
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] += s * rhs.m_vValue[i];
 			return *this;
 		}
 
@@ -522,13 +549,9 @@ class LocalMatrix
 			m_pColFuncMap = &colFuncMap;
 
 			for(size_t i = 0; i < m_pRowFuncMap->num_fct(); ++i)
-				for(size_t j = 0; j < m_pColFuncMap->num_fct(); ++j)
-				{
-					const size_t rowMapFct = rowFuncMap[i];
-					const size_t colMapFct = colFuncMap[j];
-
-					m_CplMatAcc(i,j) = &(m_CplMat(rowMapFct, colMapFct));
-				}
+				m_vRowOffsetAcc[i] = m_vRowOffset[rowFuncMap[i]];
+			for(size_t j = 0; j < m_pColFuncMap->num_fct(); ++j)
+				m_vColOffsetAcc[j] = m_vColOffset[colFuncMap[j]];
 		}
 
 	///	access all functions
@@ -537,41 +560,46 @@ class LocalMatrix
 			m_pRowFuncMap = NULL;
 			m_pColFuncMap = NULL;
 
-			if(m_pRowIndex==NULL) {m_CplMatAcc.resize(0,0); return;}
+			if(m_pRowIndex==NULL)
+			{
+				m_vRowOffsetAcc.clear(); m_vColOffsetAcc.clear(); return;
+			}
+
+			m_vRowOffsetAcc.resize(m_pRowIndex->num_fct());
+			for(size_t i = 0; i < m_vRowOffsetAcc.size(); ++i)
+				m_vRowOffsetAcc[i] = m_vRowOffset[i];
 
-			for(size_t i = 0; i < m_pRowIndex->num_fct(); ++i)
-				for(size_t j = 0; j < m_pColIndex->num_fct(); ++j)
-					m_CplMatAcc(i,j) = &(m_CplMat(i,j));
+			m_vColOffsetAcc.resize(m_pColIndex->num_fct());
+			for(size_t j = 0; j < m_vColOffsetAcc.size(); ++j)
+				m_vColOffsetAcc[j] = m_vColOffset[j];
 		}
 
 	///	returns the number of currently accessible (restricted) functions
 		size_t num_row_fct() const
 		{
 			if(m_pRowFuncMap != NULL) return m_pRowFuncMap->num_fct();
-			return m_CplMatAcc.num_rows();
+			return m_vRowOffsetAcc.size();
 		}
 
 	///	returns the number of currently accessible (restricted) functions
 		size_t num_col_fct() const
 		{
 			if(m_pColFuncMap != NULL) return m_pColFuncMap->num_fct();
-			return m_CplMatAcc.num_cols();
+			return m_vColOffsetAcc.size();
 		}
 
 	///	returns the number of dofs for the currently accessible (restricted) function
 		size_t num_row_dof(size_t fct) const
 		{
-			if(m_CplMat.num_rows()==0) return 0;
-			if(m_pRowFuncMap == NULL) return m_CplMat(fct, 0).num_rows();
-			else return m_CplMat( (*m_pRowFuncMap)[fct], 0).num_rows();
+			if(m_pRowFuncMap == NULL) return num_all_row_dof(fct);
+			else return num_all_row_dof((*m_pRowFuncMap)[fct]);
 		}
 
 	///	returns the number of dofs for the currently accessible (restricted) function
 		size_t num_col_dof(size_t fct) const
 		{
-			if(m_CplMat.num_cols()==0) return 0;
-			if(m_pRowFuncMap == NULL) return m_CplMat(0, fct).num_cols();
-			else return m_CplMat( 0, (*m_pColFuncMap)[fct]).num_cols();
+			if(m_pColFuncMap == NULL) return num_all_col_dof(fct);
+			else return num_all_col_dof((*m_pColFuncMap)[fct]);
 		}
 
 	/// access to (restricted) coupling (rowFct, rowDoF) x (colFct, colDoF)
@@ -579,7 +607,8 @@ class LocalMatrix
 		                   size_t colFct, size_t colDoF)
 		{
 			check_dof(rowFct, rowDoF, colFct, colDoF);
-			return (*m_CplMatAcc(rowFct,colFct))(rowDoF, colDoF);
+			return m_vValue[(m_vRowOffsetAcc[rowFct] + rowDoF) * num_all_cols()
+			                + m_vColOffsetAcc[colFct] + colDoF];
 		}
 
 	/// const access to (restricted) coupling (rowFct, rowDoF) x (colFct, colDoF)
@@ -587,7 +616,8 @@ class LocalMatrix
 		                        size_t colFct, size_t colDoF) const
 		{
 			check_dof(rowFct, rowDoF, colFct, colDoF);
-			return (*m_CplMatAcc(rowFct,colFct))(rowDoF, colDoF);
+			return m_vValue[(m_vRowOffsetAcc[rowFct] + rowDoF) * num_all_cols()
+			                + m_vColOffsetAcc[colFct] + colDoF];
 		}
 
 		///////////////////////////
@@ -595,23 +625,32 @@ class LocalMatrix
 		///////////////////////////
 
 	///	returns the number of all functions
-		size_t num_all_row_fct() const{	return m_CplMat.num_rows();}
+		size_t num_all_row_fct() const{return m_vRowOffset.size() - 1;}
 
 	///	returns the number of all functions
-		size_t num_all_col_fct() const{return m_CplMat.num_cols();}
+		size_t num_all_col_fct() const{return m_vColOffset.size() - 1;}
 
 	///	returns the number of dofs for a function
-		size_t num_all_row_dof(size_t fct) const {return m_CplMat(fct, 0).num_rows();}
+		size_t num_all_row_dof(size_t fct) const
+		{
+			UG_LOCALALGEBRA_ASSERT(fct < num_all_row_fct(), "Wrong index.");
+			return m_vRowOffset[fct+1] - m_vRowOffset[fct];
+		}
 
 	///	returns the number of dofs for a function
-		size_t num_all_col_dof(size_t fct) const {return m_CplMat(0, fct).num_cols();}
+		size_t num_all_col_dof(size_t fct) const
+		{
+			UG_LOCALALGEBRA_ASSERT(fct < num_all_col_fct(), "Wrong index.");
+			return m_vColOffset[fct+1] - m_vColOffset[fct];
+		}
 
 	/// access to coupling (rowFct, rowDoF) x (colFct, colDoF)
 		number& value(size_t rowFct, size_t rowDoF,
 		              size_t colFct, size_t colDoF)
 		{
 			check_all_dof(rowFct, rowDoF, colFct, colDoF);
-			return (m_CplMat(rowFct,colFct))(rowDoF, colDoF);
+			return m_vValue[(m_vRowOffset[rowFct] + rowDoF) * num_all_cols()
+			                + m_vColOffset[colFct] + colDoF];
 		}
 
 	/// const access to coupling (rowFct, rowDoF) x (colFct, colDoF)
@@ -619,9 +658,22 @@ class LocalMatrix
 		                   size_t colFct, size_t colDoF) const
 		{
 			check_all_dof(rowFct, rowDoF, colFct, colDoF);
-			return (m_CplMat(rowFct,colFct))(rowDoF, colDoF);
+			return m_vValue[(m_vRowOffset[rowFct] + rowDoF) * num_all_cols()
+			                + m_vColOffset[colFct] + colDoF];
 		}
 
+	///	returns the number of all row dofs (all functions)
+		size_t num_all_rows() const {return m_vRowOffset.back();}
+
+	///	returns the number of all col dofs (all functions)
+		size_t num_all_cols() const {return m_vColOffset.back();}
+
+	///	returns the contiguous, row-major array of all couplings
+		value_type* data() {return m_vValue.empty() ? NULL : &m_vValue[0];}
+
+	///	returns the contiguous, row-major array of all couplings
+		const value_type* data() const {return m_vValue.empty() ? NULL : &m_vValue[0];}
+
 	protected:
 	///	checks correct (fct1,fct2) index in debug mode
 		inline void check_fct(size_t rowFct, size_t colFct) const
@@ -665,22 +717,20 @@ class LocalMatrix
 	/// Column Access Mapping
 		const FunctionIndexMapping* m_pColFuncMap;
 
-	//	\todo: Think of a better (faster) storage (one plain array?)
-
-	//	type of cpl matrices between two functions
-		typedef DenseMatrix<VariableArray2<value_type> > LocalCplMatrix;
+	///	Offset of first row dof of each function (size: num_row_fct + 1)
+		std::vector<size_t> m_vRowOffset;
 
-	//	type of Func-Coupling matrices
-		typedef DenseMatrix<VariableArray2<LocalCplMatrix> > FctCplMatrix;
+	///	Offset of first col dof of each function (size: num_col_fct + 1)
+		std::vector<size_t> m_vColOffset;
 
-	//	type of Func-Coupling pointer matrices
-		typedef DenseMatrix<VariableArray2<LocalCplMatrix*> > FctCplAccMatrix;
+	///	Offset of first row dof of each currently accessible function
+		std::vector<size_t> m_vRowOffsetAcc;
 
-	// 	Entries (fct1, fct2, dof1, dof2)
-		FctCplMatrix m_CplMat;
+	///	Offset of first col dof of each currently accessible function
+		std::vector<size_t> m_vColOffsetAcc;
 
-	// 	Entries (fct1, fct2, dof1, dof2)
-		FctCplAccMatrix m_CplMatAcc;
+	// 	Entries (fct1, dof1, fct2, dof2), stored contiguously row-major
+		std::vector<value_type> m_vValue;
 };
 
 inline
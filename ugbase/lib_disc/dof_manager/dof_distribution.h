@@ -36,6 +36,7 @@
 #include "lib_grid/tools/surface_view.h"
 #include "lib_disc/domain_traits.h"
 #include "lib_disc/common/local_algebra.h"
+#include "lib_disc/common/revision_counter.h"
 #include "dof_index_storage.h"
 #include "dof_count.h"
 
@@ -199,6 +200,15 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// return the number of dofs distributed on subset si
 		size_t num_indices(int si) const {return m_vNumIndexOnSubset[si];}
 
+		///	returns the revision of the index distribution
+		/**
+		 * The revision is increased whenever the indices are redistributed
+		 * or permuted. Structures depending on the index layout (e.g. the
+		 * sparsity pattern of an assembled matrix) can compare this counter
+		 * to decide whether they must be rebuilt.
+		 */
+		const RevisionCounter& revision() const {return m_RevCnt;}
+
 	public:
 		/// extracts all indices of the element (sorted)
 		/**
@@ -464,6 +474,9 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// number of distributed indices on each subset
 		std::vector<size_t> m_vNumIndexOnSubset;
 
+		///	revision of the index distribution
+		RevisionCounter m_RevCnt;
+
 	public:
 		/// returns the connections
 		void get_connections(std::vector<std::vector<size_t> >& vvConnection) const;
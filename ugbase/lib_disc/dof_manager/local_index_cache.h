@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__DOF_MANAGER__LOCAL_INDEX_CACHE__
+#define __H__UG__LIB_DISC__DOF_MANAGER__LOCAL_INDEX_CACHE__
+
+#include <vector>
+
+#include "lib_disc/common/local_algebra.h"
+#include "lib_disc/common/revision_counter.h"
+#include "dof_distribution.h"
+
+namespace ug{
+
+/// Cache for the LocalIndices of the elements of an element loop
+/**
+ * This class stores the LocalIndices of all elements of one element loop
+ * (i.e. one reference object type in one subset) in flat arrays, such that
+ * the indices need not be recomputed from the DoFDistribution in every
+ * assembling. The elements are addressed by their position in the loop,
+ * the element pointer stored for each position is used to detect a changed
+ * element sequence. Additionally, the storage positions of the local
+ * couplings in a global SparseMatrix can be cached per element. Those are
+ * validated on every access, such that a changed sparsity pattern only
+ * leads to a recomputation.
+ *
+ * The cache is cleared, whenever the revision of the DoFDistribution or the
+ * hanging-node flag has changed.
+ */
+class LocalIndexCache
+{
+	public:
+	///	constructor
+		LocalIndexCache() : m_bHang(false) {}
+
+	///	clears the cache if built for another state of the DoFDistribution
+	/**
+	 * The DoFDistribution is referenced by the cache, thus the revision
+	 * can not be confused with the one of a new DoFDistribution.
+	 */
+		void update(ConstSmartPtr<DoFDistribution> dd, bool bHang)
+		{
+			if(m_spDD == dd && m_revision == dd->revision() && m_bHang == bHang)
+				return;
+			clear();
+			m_spDD = dd;
+			m_revision = dd->revision();
+			m_bHang = bHang;
+		}
+
+	///	clears all cached element data
+		void clear()
+		{
+			m_vElem.clear(); m_vIndexStart.clear(); m_vNumDoFStart.clear();
+			m_vNumDoF.clear(); m_vIndex.clear(); m_vLFEID.clear();
+			m_vPosStart.clear(); m_vPos.clear();
+		}
+
+	///	writes the indices of the i'th element of the loop to ind
+		void indices(size_t i, GridObject* elem, LocalIndices& ind)
+		{
+		//	read from cache
+			if(i < m_vElem.size() && m_vElem[i] == elem)
+			{
+				const size_t numFct = m_vLFEID.size();
+				ind.resize_fct(numFct);
+				std::vector<DoFIndex>::const_iterator pIndex = m_vIndex.begin() + m_vIndexStart[i];
+				std::vector<size_t>::const_iterator pNumDoF = m_vNumDoF.begin() + m_vNumDoFStart[i];
+				for(size_t fct = 0; fct < numFct; ++fct)
+				{
+					ind.set_lfeID(fct, m_vLFEID[fct]);
+					ind.resize_dof(fct, pNumDoF[fct]);
+					for(size_t dof = 0; dof < pNumDoF[fct]; ++dof, ++pIndex)
+					{
+						ind.index(fct, dof) = (*pIndex)[0];
+						ind.comp(fct, dof) = (*pIndex)[1];
+					}
+				}
+				return;
+			}
+
+		//	compute and store
+			m_spDD->indices(elem, ind, m_bHang);
+			store(i, elem, ind);
+		}
+
+	///	returns the cached matrix positions of the i'th element (ndof x ndof)
+	/**
+	 * Positions not yet known are stored as -1. If the element is not
+	 * cached at position i (e.g. since the element sequence has changed),
+	 * NULL is returned.
+	 */
+		int* matrix_positions(size_t i, GridObject* elem)
+		{
+			if(i >= m_vElem.size() || m_vElem[i] != elem || m_vPos.empty())
+				return NULL;
+			return &m_vPos[0] + m_vPosStart[i];
+		}
+
+	///	returns if the i'th element of the loop is cached
+		bool cached(size_t i, GridObject* elem) const
+		{
+			return i < m_vElem.size() && m_vElem[i] == elem;
+		}
+
+	///	computes the matrix positions of all cached elements
+	/**
+	 * All couplings of the cached elements are added to the sparsity pattern
+	 * first, such that the positions stay valid as long as the pattern is not
+	 * changed again. This allows to add the local matrices concurrently (see
+	 * AddLocalMatrixToGlobalAtPositions).
+	 */
+		template <typename TMatrix>
+		void update_matrix_positions(TMatrix& mat)
+		{
+		//	the first sweep may move rows, the second one only corrects positions
+			for(int sweep = 0; sweep < 2; ++sweep)
+				for(size_t i = 0; i < m_vElem.size(); ++i)
+				{
+					const size_t indexEnd = (i+1 < m_vElem.size()) ? m_vIndexStart[i+1] : m_vIndex.size();
+					const size_t numDoF = indexEnd - m_vIndexStart[i];
+					std::vector<DoFIndex>::const_iterator pIndex = m_vIndex.begin() + m_vIndexStart[i];
+					std::vector<int>::iterator pPos = m_vPos.begin() + m_vPosStart[i];
+					for(size_t r = 0; r < numDoF; ++r)
+						for(size_t c = 0; c < numDoF; ++c, ++pPos)
+							if(!mat.is_position_of(*pPos, pIndex[r][0], pIndex[c][0]))
+								*pPos = mat.position(pIndex[r][0], pIndex[c][0]);
+				}
+		}
+
+	protected:
+	///	stores the indices of the i'th element
+		void store(size_t i, GridObject* elem, const LocalIndices& ind)
+		{
+		//	the element sequence differs from the cached one, start over
+			if(i != m_vElem.size())
+			{
+				clear();
+				if(i != 0) return;
+			}
+
+		//	remember lfeids (equal for all elements of the loop). Elements
+		//	with other lfeids are not cached.
+			const size_t numFct = ind.num_fct();
+			if(m_vElem.empty())
+			{
+				m_vLFEID.resize(numFct);
+				for(size_t fct = 0; fct < numFct; ++fct)
+					m_vLFEID[fct] = ind.local_finite_element_id(fct);
+			}
+			else
+			{
+				if(numFct != m_vLFEID.size()) return;
+				for(size_t fct = 0; fct < numFct; ++fct)
+					if(m_vLFEID[fct] != ind.local_finite_element_id(fct)) return;
+			}
+
+			m_vElem.push_back(elem);
+			m_vIndexStart.push_back(m_vIndex.size());
+			m_vNumDoFStart.push_back(m_vNumDoF.size());
+			m_vPosStart.push_back(m_vPos.size());
+
+			size_t numDoF = 0;
+			for(size_t fct = 0; fct < numFct; ++fct)
+			{
+				m_vNumDoF.push_back(ind.num_dof(fct));
+				for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+					m_vIndex.push_back(ind.multi_index(fct, dof));
+				numDoF += ind.num_dof(fct);
+			}
+			m_vPos.resize(m_vPos.size() + numDoF*numDoF, -1);
+		}
+
+	protected:
+	///	DoFDistribution the cache has been built for
+		ConstSmartPtr<DoFDistribution> m_spDD;
+
+	///	revision of the DoFDistribution the cache has been built for
+		RevisionCounter m_revision;
+
+	///	flag if hanging dofs are included
+		bool m_bHang;
+
+	///	elements of the loop
+		std::vector<GridObject*> m_vElem;
+
+	///	start of the element data in the flat arrays
+		std::vector<size_t> m_vIndexStart;
+		std::vector<size_t> m_vNumDoFStart;
+		std::vector<size_t> m_vPosStart;
+
+	///	number of dofs per function (flat)
+		std::vector<size_t> m_vNumDoF;
+
+	///	algebra indices (flat)
+		std::vector<DoFIndex> m_vIndex;
+
+	///	local finite element ids of the functions
+		std::vector<LFEID> m_vLFEID;
+
+	///	positions of the couplings in the global matrix (flat)
+		std::vector<int> m_vPos;
+};
+
+///	adds a local matrix to the global one using the cached matrix positions
+/**	If the element is not cached at position i, the local matrix is added
+ * without the cache.*/
+template <typename TMatrix>
+void AddLocalMatrixToGlobal(TMatrix& mat, const LocalMatrix& lmat,
+                            LocalIndexCache& cache, size_t i, GridObject* elem)
+{
+	int* pPos = cache.matrix_positions(i, elem);
+	if(pPos == NULL)
+	{
+		AddLocalMatrixToGlobal(mat, lmat);
+		return;
+	}
+
+	const LocalIndices& rowInd = lmat.get_row_indices();
+	const LocalIndices& colInd = lmat.get_col_indices();
+
+	for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+		for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+		{
+			const size_t rowIndex = rowInd.index(fct1,dof1);
+			const size_t rowComp = rowInd.comp(fct1,dof1);
+
+			for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+				for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2, ++pPos)
+				{
+					const size_t colIndex = colInd.index(fct2,dof2);
+					const size_t colComp = colInd.comp(fct2,dof2);
+
+					if(!mat.is_position_of(*pPos, rowIndex, colIndex))
+						*pPos = mat.position(rowIndex, colIndex);
+
+					BlockRef(mat.value_at(*pPos), rowComp, colComp)
+								+= lmat.value(fct1,dof1,fct2,dof2);
+				}
+		}
+}
+
+///	adds a local matrix to the global one at precomputed matrix positions
+/**	The positions must be valid for the current sparsity pattern (see
+ * LocalIndexCache::update_matrix_positions). Since the matrix is only written
+ * at those positions, local matrices with disjoint rows may be added by
+ * several threads at once. values_changed() must be called on the matrix
+ * afterwards.*/
+template <typename TMatrix>
+void AddLocalMatrixToGlobalAtPositions(TMatrix& mat, const LocalMatrix& lmat,
+                                       const int* pPos)
+{
+	const LocalIndices& rowInd = lmat.get_row_indices();
+	const LocalIndices& colInd = lmat.get_col_indices();
+
+	for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+		for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+		{
+			const size_t rowComp = rowInd.comp(fct1,dof1);
+
+			for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+				for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2, ++pPos)
+				{
+					const size_t colComp = colInd.comp(fct2,dof2);
+					BlockRef(mat.value_at_concurrent(*pPos), rowComp, colComp)
+								+= lmat.value(fct1,dof1,fct2,dof2);
+				}
+		}
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__DOF_MANAGER__LOCAL_INDEX_CACHE__ */
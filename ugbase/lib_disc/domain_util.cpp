@@ -124,10 +124,17 @@ void LoadDomain(TDomain& domain, const char* filename, int procId)
 
 template <typename TDomain>
 void SaveDomain(TDomain& domain, const char* filename)
+{
+	SaveDomain(domain, filename, false);
+}
+
+template <typename TDomain>
+void SaveDomain(TDomain& domain, const char* filename, bool binaryUGX)
 {
 	PROFILE_FUNC_GROUP("grid");
 	if(GetFilenameExtension(string(filename)) == string("ugx")){
 		GridWriterUGX ugxWriter;
+		ugxWriter.set_binary(binaryUGX);
 		ugxWriter.add_grid(*domain.grid(), "defGrid", domain.position_attachment());
 		ugxWriter.add_subset_handler(*domain.subset_handler(), "defSH", 0);
 
@@ -165,8 +172,11 @@ template void LoadDomain<Domain2d>(Domain2d& domain, const char* filename, int p
 template void LoadDomain<Domain3d>(Domain3d& domain, const char* filename, int procId);
 
 template void SaveDomain<Domain1d>(Domain1d& domain, const char* filename);
+template void SaveDomain<Domain1d>(Domain1d& domain, const char* filename, bool binaryUGX);
 template void SaveDomain<Domain2d>(Domain2d& domain, const char* filename);
+template void SaveDomain<Domain2d>(Domain2d& domain, const char* filename, bool binaryUGX);
 template void SaveDomain<Domain3d>(Domain3d& domain, const char* filename);
+template void SaveDomain<Domain3d>(Domain3d& domain, const char* filename, bool binaryUGX);
 
 template number MaxElementDiameter<Domain1d>(Domain1d& domain, int level);
 template number MaxElementDiameter<Domain2d>(Domain2d& domain, int level);
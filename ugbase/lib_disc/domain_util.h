@@ -55,9 +55,18 @@ void LoadDomain(TDomain& domain, const char* filename, int procId);
 /**	\} */
 
 ///	Saves the domain to a grid-file.
+/**	For ugx-files, vertices, elements and subsets can optionally be written as
+ * binary data (see GridWriterUGX::set_binary), which reduces file size and
+ * loading time of large grids.
+ * \{
+ */
 template <typename TDomain>
 void SaveDomain(TDomain& domain, const char* filename);
 
+template <typename TDomain>
+void SaveDomain(TDomain& domain, const char* filename, bool binaryUGX);
+/**	\} */
+
 
 ////////////////////////////////////////////////////////////////////////
 ///	returns the corner coordinates of a geometric object
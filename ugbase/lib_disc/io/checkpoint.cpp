@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "checkpoint.h"
+#include "common/error.h"
+#include "common/util/combined_file.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/parallel_file.h"
+#endif
+
+namespace ug{
+
+void WriteCheckpointFile(BinaryBuffer& buf, const std::string& filename)
+{
+#ifdef UG_PARALLEL
+	pcl::WriteCombinedParallelFile(buf, filename);
+#else
+	try{
+		WriteCombinedFileSerial(buf, filename);
+	}
+	UG_CATCH_THROW("WriteCheckpointFile: Could not write checkpoint.");
+#endif
+}
+
+void ReadCheckpointFile(BinaryBuffer& buf, const std::string& filename)
+{
+#ifdef UG_PARALLEL
+	pcl::ReadCombinedParallelFile(buf, filename);
+#else
+	try{
+		ReadCombinedFileSerial(buf, filename);
+	}
+	UG_CATCH_THROW("ReadCheckpointFile: Could not read checkpoint.");
+#endif
+}
+
+} // namespace ug
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__CHECKPOINT__
+#define __H__UG__LIB_DISC__IO__CHECKPOINT__
+
+// extern libraries
+#include <string>
+#include <vector>
+
+// other ug modules
+#include "common/util/binary_buffer.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/function_spaces/grid_function.h"
+
+namespace ug{
+
+///	writes the buffers of all processes to one combined file
+/**	In a parallel environment, pcl::WriteCombinedParallelFile is used. In a
+ * serial environment, a file with the same layout is written.*/
+void WriteCheckpointFile(BinaryBuffer& buf, const std::string& filename);
+
+///	reads the buffer of this process from a file written by WriteCheckpointFile
+void ReadCheckpointFile(BinaryBuffer& buf, const std::string& filename);
+
+
+///	binary checkpoint of a distributed domain and grid functions
+/**
+ * A checkpoint stores, for each process, the complete multigrid hierarchy
+ * of the domain, its subset handler and vertex positions, the interfaces of
+ * the DistributedGridManager and the values of all registered grid
+ * functions. All data of all processes is written to one combined file.
+ *
+ * On restart, the grid is restored as it was written, i.e., without
+ * loading the original grid file, without distribution and without
+ * refinement. The checkpoint has to be read on the same number of
+ * processes as it was written on.
+ *
+ * Grid function values are stored together with the grid element they
+ * belong to. They are thus restored correctly, even if the DoFs of the
+ * new approximation space are ordered differently.
+ *
+ * Saving:
+ * \code
+ * cp = Checkpoint(dom)
+ * cp:add(u, "u")
+ * cp:save("run.chk")
+ * \endcode
+ *
+ * Restoring (dom has to be empty):
+ * \code
+ * cp = Checkpoint(dom)
+ * cp:load_domain("run.chk")
+ * -- create and initialize the approximation space and u
+ * cp:add(u, "u")
+ * cp:load_grid_functions()
+ * \endcode
+ *
+ * Refinement projectors and additional subset handlers of the domain
+ * are not part of the checkpoint.
+ */
+template <typename TDomain, typename TAlgebra>
+class Checkpoint
+{
+	public:
+	///	domain type
+		typedef TDomain domain_type;
+
+	///	grid function type
+		typedef GridFunction<TDomain, TAlgebra> grid_function_type;
+
+	///	position type
+		typedef typename TDomain::position_type position_type;
+
+	public:
+	///	constructor
+		Checkpoint(SmartPtr<TDomain> spDomain);
+
+	///	registers a grid function, which is saved and restored under the given name
+		void add(SmartPtr<grid_function_type> spGridFct, const char* name);
+
+	///	writes the domain and all registered grid functions to a file
+		void save(const char* filename);
+
+	///	restores the domain from a file
+	/**	The grid of the domain has to be empty. The grid function data of the
+	 * file is kept until load_grid_functions is called.*/
+		void load_domain(const char* filename);
+
+	///	restores all registered grid functions from the file read in load_domain
+	/**	The grid must not be changed between load_domain and this call.*/
+		void load_grid_functions();
+
+	protected:
+	///	writes storage type and values of a grid function
+		void write_grid_function(BinaryBuffer& out, const grid_function_type& u,
+		                         MultiElementAttachmentAccessor<AInt>& aaInt);
+
+	///	reads storage type and values of a grid function
+		void read_grid_function(BinaryBuffer& in, grid_function_type& u);
+
+	///	writes the values of u on all elements of a base type
+		template <typename TBaseElem>
+		void write_values(BinaryBuffer& out, const grid_function_type& u,
+		                  MultiElementAttachmentAccessor<AInt>& aaInt);
+
+	///	reads the values of u on all elements of a base type
+		template <typename TBaseElem>
+		void read_values(BinaryBuffer& in, grid_function_type& u,
+		                 const std::vector<TBaseElem*>& vElems);
+
+	protected:
+	///	domain
+		SmartPtr<TDomain> m_spDomain;
+
+	///	registered grid functions and their names
+		std::vector<SmartPtr<grid_function_type> > m_vGridFct;
+		std::vector<std::string> m_vName;
+
+	///	buffer read in load_domain and read position of the grid function data
+		BinaryBuffer m_buf;
+		size_t m_gridFctReadPos;
+		bool m_bDomainLoaded;
+
+	///	restored elements in the order they were written
+		std::vector<Vertex*> m_vVrts;
+		std::vector<Edge*> m_vEdges;
+		std::vector<Face*> m_vFaces;
+		std::vector<Volume*> m_vVols;
+};
+
+} // namespace ug
+
+#include "checkpoint_impl.h"
+
+#endif /* __H__UG__LIB_DISC__IO__CHECKPOINT__ */
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__CHECKPOINT_IMPL__
+#define __H__UG__LIB_DISC__IO__CHECKPOINT_IMPL__
+
+#include "checkpoint.h"
+#include "common/serialization.h"
+#include "common/profiler/profiler.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "lib_grid/lib_grid_messages.h"
+
+namespace ug{
+
+//	magic number and version of the checkpoint format
+static const int CHECKPOINT_MAGIC_NUMBER = 7361042;
+static const int CHECKPOINT_VERSION = 1;
+
+template <typename TDomain, typename TAlgebra>
+Checkpoint<TDomain, TAlgebra>::
+Checkpoint(SmartPtr<TDomain> spDomain)
+	: m_spDomain(spDomain), m_gridFctReadPos(0), m_bDomainLoaded(false)
+{
+	UG_COND_THROW(spDomain.invalid(), "Checkpoint: Domain must be valid.");
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+add(SmartPtr<grid_function_type> spGridFct, const char* name)
+{
+	UG_COND_THROW(spGridFct.invalid(), "Checkpoint::add: Grid function must be valid.");
+	UG_COND_THROW(spGridFct->domain().get() != m_spDomain.get(),
+	              "Checkpoint::add: Grid function '" << name << "' is not "
+	              "defined on the domain of the checkpoint.");
+	for(size_t i = 0; i < m_vName.size(); ++i)
+		UG_COND_THROW(m_vName[i] == name, "Checkpoint::add: A grid function "
+		              "named '" << name << "' has already been added.");
+
+	m_vGridFct.push_back(spGridFct);
+	m_vName.push_back(name);
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+save(const char* filename)
+{
+	PROFILE_FUNC_GROUP("checkpoint");
+	MultiGrid& mg = *m_spDomain->grid();
+	typename TDomain::position_accessor_type& aaPos = m_spDomain->position_accessor();
+
+	BinaryBuffer buf;
+	Serialize(buf, CHECKPOINT_MAGIC_NUMBER);
+	Serialize(buf, CHECKPOINT_VERSION);
+	Serialize(buf, (int)TDomain::dim);
+
+//	the grid, numbering the elements in the order they are written
+	AInt aInt;
+	mg.attach_to_all(aInt);
+	MultiElementAttachmentAccessor<AInt> aaInt(mg, aInt);
+
+	if(!SerializeDistributedMultiGrid(mg, *m_spDomain->subset_handler(), aaInt, buf)){
+		mg.detach_from_all(aInt);
+		UG_THROW("Checkpoint::save: Cannot serialize the grid.");
+	}
+
+//	vertex positions in the same order
+	std::vector<position_type> vPos(mg.num<Vertex>());
+	for(VertexIterator iter = mg.begin<Vertex>(); iter != mg.end<Vertex>(); ++iter)
+		vPos[aaInt[*iter]] = aaPos[*iter];
+	Serialize(buf, vPos);
+
+//	grid functions, each one in a separate block such that it can be skipped
+	Serialize(buf, (int)m_vGridFct.size());
+	for(size_t i = 0; i < m_vGridFct.size(); ++i){
+		BinaryBuffer fctBuf;
+		write_grid_function(fctBuf, *m_vGridFct[i], aaInt);
+
+		Serialize(buf, m_vName[i]);
+		Serialize(buf, fctBuf.write_pos());
+		buf.write(fctBuf.buffer(), fctBuf.write_pos());
+	}
+
+	mg.detach_from_all(aInt);
+
+	Serialize(buf, CHECKPOINT_MAGIC_NUMBER);
+	WriteCheckpointFile(buf, filename);
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+load_domain(const char* filename)
+{
+	PROFILE_FUNC_GROUP("checkpoint");
+	MultiGrid& mg = *m_spDomain->grid();
+	typename TDomain::position_accessor_type& aaPos = m_spDomain->position_accessor();
+
+	UG_COND_THROW(mg.num<Vertex>() > 0, "Checkpoint::load_domain: The grid "
+	              "of the domain has to be empty.");
+
+	m_buf.clear();
+	ReadCheckpointFile(m_buf, filename);
+
+	UG_COND_THROW(Deserialize<int>(m_buf) != CHECKPOINT_MAGIC_NUMBER,
+	              "Checkpoint::load_domain: '" << filename << "' is not a checkpoint.");
+	int version = Deserialize<int>(m_buf);
+	UG_COND_THROW(version != CHECKPOINT_VERSION, "Checkpoint::load_domain: "
+	              "Unsupported checkpoint version " << version << ".");
+	int dim = Deserialize<int>(m_buf);
+	UG_COND_THROW(dim != TDomain::dim, "Checkpoint::load_domain: Checkpoint "
+	              "was written for dimension " << dim << ", but domain has "
+	              "dimension " << TDomain::dim << ".");
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STARTS));
+
+//	the creation has to be stopped in any case, since listeners of the
+//	message hub are waiting for it
+	try{
+		if(!DeserializeDistributedMultiGrid(mg, *m_spDomain->subset_handler(), m_buf,
+		                                    &m_vVrts, &m_vEdges, &m_vFaces, &m_vVols))
+			UG_THROW("Checkpoint::load_domain: Cannot deserialize the grid.");
+
+		std::vector<position_type> vPos;
+		Deserialize(m_buf, vPos);
+		UG_COND_THROW(vPos.size() != m_vVrts.size(), "Checkpoint::load_domain: "
+		              "Number of positions does not match the number of vertices.");
+		for(size_t i = 0; i < m_vVrts.size(); ++i)
+			aaPos[m_vVrts[i]] = vPos[i];
+	}
+	catch(...){
+		mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STOPS));
+		throw;
+	}
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STOPS));
+
+	m_gridFctReadPos = m_buf.read_pos();
+	m_bDomainLoaded = true;
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+load_grid_functions()
+{
+	PROFILE_FUNC_GROUP("checkpoint");
+	UG_COND_THROW(!m_bDomainLoaded, "Checkpoint::load_grid_functions: "
+	              "load_domain has to be called first.");
+	MultiGrid& mg = *m_spDomain->grid();
+	UG_COND_THROW(mg.num<Vertex>() != m_vVrts.size(),
+	              "Checkpoint::load_grid_functions: The grid has been changed "
+	              "since load_domain was called.");
+
+	m_buf.set_read_pos(m_gridFctReadPos);
+
+	std::vector<bool> vLoaded(m_vGridFct.size(), false);
+	int numFcts = Deserialize<int>(m_buf);
+	for(int i = 0; i < numFcts; ++i){
+		std::string name = Deserialize<std::string>(m_buf);
+		size_t size = Deserialize<size_t>(m_buf);
+		size_t endPos = m_buf.read_pos() + size;
+
+		for(size_t j = 0; j < m_vName.size(); ++j){
+			if(m_vName[j] != name) continue;
+			read_grid_function(m_buf, *m_vGridFct[j]);
+			UG_COND_THROW(m_buf.read_pos() != endPos, "Checkpoint::load_grid_functions: "
+			              "Corrupt data of grid function '" << name << "'.");
+			vLoaded[j] = true;
+		}
+		m_buf.set_read_pos(endPos);
+	}
+
+	UG_COND_THROW(Deserialize<int>(m_buf) != CHECKPOINT_MAGIC_NUMBER,
+	              "Checkpoint::load_grid_functions: Magic number mismatch.");
+
+	for(size_t j = 0; j < m_vName.size(); ++j)
+		UG_COND_THROW(!vLoaded[j], "Checkpoint::load_grid_functions: No grid "
+		              "function named '" << m_vName[j] << "' in checkpoint.");
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+write_grid_function(BinaryBuffer& out, const grid_function_type& u,
+                    MultiElementAttachmentAccessor<AInt>& aaInt)
+{
+#ifdef UG_PARALLEL
+	Serialize(out, u.get_storage_mask());
+#else
+	Serialize(out, (uint)0);
+#endif
+
+	write_values<Vertex>(out, u, aaInt);
+	write_values<Edge>(out, u, aaInt);
+	write_values<Face>(out, u, aaInt);
+	write_values<Volume>(out, u, aaInt);
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+read_grid_function(BinaryBuffer& in, grid_function_type& u)
+{
+	uint storageMask = Deserialize<uint>(in);
+
+	read_values<Vertex>(in, u, m_vVrts);
+	read_values<Edge>(in, u, m_vEdges);
+	read_values<Face>(in, u, m_vFaces);
+	read_values<Volume>(in, u, m_vVols);
+
+#ifdef UG_PARALLEL
+	u.set_storage_type(storageMask);
+#else
+	(void)storageMask;
+#endif
+}
+
+template <typename TDomain, typename TAlgebra>
+template <typename TBaseElem>
+void Checkpoint<TDomain, TAlgebra>::
+write_values(BinaryBuffer& out, const grid_function_type& u,
+             MultiElementAttachmentAccessor<AInt>& aaInt)
+{
+	typedef typename grid_function_type::template traits<TBaseElem>::const_iterator TIter;
+
+	int numElems = 0;
+	for(TIter iter = u.template begin<TBaseElem>(); iter != u.template end<TBaseElem>(); ++iter)
+		++numElems;
+	Serialize(out, numElems);
+
+	std::vector<size_t> vInd;
+	for(TIter iter = u.template begin<TBaseElem>(); iter != u.template end<TBaseElem>(); ++iter)
+	{
+		TBaseElem* elem = *iter;
+		u.inner_algebra_indices(elem, vInd);
+
+		Serialize(out, aaInt[elem]);
+		Serialize(out, (int)vInd.size());
+		for(size_t i = 0; i < vInd.size(); ++i)
+			Serialize(out, u[vInd[i]]);
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+template <typename TBaseElem>
+void Checkpoint<TDomain, TAlgebra>::
+read_values(BinaryBuffer& in, grid_function_type& u,
+            const std::vector<TBaseElem*>& vElems)
+{
+	typedef typename grid_function_type::template traits<TBaseElem>::const_iterator TIter;
+
+	int numElems = Deserialize<int>(in);
+
+	int numLocalElems = 0;
+	for(TIter iter = u.template begin<TBaseElem>(); iter != u.template end<TBaseElem>(); ++iter)
+		++numLocalElems;
+	UG_COND_THROW(numElems != numLocalElems, "Checkpoint: Grid function is "
+	              "defined on " << numLocalElems << " elements, but checkpoint "
+	              "contains values for " << numElems << " elements.");
+
+	std::vector<size_t> vInd;
+	for(int k = 0; k < numElems; ++k)
+	{
+		int elemInd = Deserialize<int>(in);
+		int numInd = Deserialize<int>(in);
+		UG_COND_THROW(elemInd < 0 || elemInd >= (int)vElems.size(),
+		              "Checkpoint: Bad element index " << elemInd << ".");
+
+		TBaseElem* elem = vElems[elemInd];
+		UG_COND_THROW(!u.is_contained(elem), "Checkpoint: Grid function is "
+		              "not defined on an element of the checkpoint.");
+		u.inner_algebra_indices(elem, vInd);
+		UG_COND_THROW((int)vInd.size() != numInd, "Checkpoint: Number of DoFs "
+		              "on an element does not match (" << vInd.size() << " instead of "
+		              << numInd << "). Are the same functions defined?");
+
+		for(size_t i = 0; i < vInd.size(); ++i)
+			Deserialize(in, u[vInd[i]]);
+	}
+}
+
+} // namespace ug
+
+#endif /* __H__UG__LIB_DISC__IO__CHECKPOINT_IMPL__ */
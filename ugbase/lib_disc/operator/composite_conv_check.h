@@ -191,6 +191,9 @@ class CompositeConvCheck : public IConvergenceCheck<TVector>
 	/// calculates the 2-norm of the entries of the vector vec specified by index
 		number norm(const TVector& vec, const std::vector<DoFIndex>& index);
 
+	/// calculates the 2-norms of all native components at once (one reduction only)
+		void norms(const TVector& vec, std::vector<number>& vNorm);
+
 	protected:
 	///	ApproxSpace
 		SmartPtr<ApproximationSpace<TDomain> > m_spApprox;
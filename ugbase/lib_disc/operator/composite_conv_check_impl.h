@@ -195,6 +195,48 @@ norm(const TVector& vec, const std::vector<DoFIndex>& vMultiIndex)
 }
 
 
+template <class TVector, class TDomain>
+void CompositeConvCheck<TVector, TDomain>::
+norms(const TVector& vec, std::vector<number>& vNorm)
+{
+#ifdef UG_PARALLEL
+
+	// 	make vector d additive unique
+	if (!const_cast<TVector*>(&vec)->change_storage_type(PST_UNIQUE))
+		UG_THROW("CompositeConvCheck::norms(): Cannot change ParallelStorageType to unique.");
+#endif
+
+	// compute squared local norms of all native components
+	std::vector<double> vNormSq(m_vNativCmpInfo.size(), 0.0);
+	for (size_t fct = 0; fct < m_vNativCmpInfo.size(); fct++)
+	{
+		const std::vector<DoFIndex>& vMultiIndex = m_vNativCmpInfo[fct].vMultiIndex;
+		const size_t sz = vMultiIndex.size();
+		for (size_t dof = 0; dof < sz; ++dof)
+		{
+			const number val = DoFRef(vec, vMultiIndex[dof]);
+			vNormSq[fct] += (double) (val*val);
+		}
+	}
+
+#ifdef UG_PARALLEL
+	// sum squared local norms of all components in one reduction
+	// (over all processes, see comment in norm())
+	if (!vNormSq.empty())
+	{
+		std::vector<double> vLocal(vNormSq);
+		pcl::ProcessCommunicator commWorld;
+		commWorld.allreduce(vLocal, vNormSq, PCL_RO_SUM);
+	}
+#endif
+
+	// return global norms
+	vNorm.resize(vNormSq.size());
+	for (size_t fct = 0; fct < vNormSq.size(); fct++)
+		vNorm[fct] = sqrt((number) vNormSq[fct]);
+}
+
+
 template <class TVector, class TDomain>
 SmartPtr<IConvergenceCheck<TVector> > CompositeConvCheck<TVector, TDomain>::clone()
 {
@@ -444,8 +486,10 @@ void CompositeConvCheck<TVector, TDomain>::start(const TVector& vec)
 	if (m_bTimeMeas)	m_stopwatch.start();
 
 	// update native defects
+	std::vector<number> vNorm;
+	norms(vec, vNorm);
 	for (size_t fct = 0; fct < m_vNativCmpInfo.size(); fct++){
-		m_vNativCmpInfo[fct].initDefect = norm(vec, m_vNativCmpInfo[fct].vMultiIndex);
+		m_vNativCmpInfo[fct].initDefect = vNorm[fct];
 		m_vNativCmpInfo[fct].currDefect = m_vNativCmpInfo[fct].initDefect;
 	}
 
@@ -545,9 +589,11 @@ void CompositeConvCheck<TVector, TDomain>::update(const TVector& vec)
 	}
 
 	// update native defects
+	std::vector<number> vNorm;
+	norms(vec, vNorm);
 	for (size_t fct = 0; fct < m_vNativCmpInfo.size(); fct++){
 		m_vNativCmpInfo[fct].lastDefect = m_vNativCmpInfo[fct].currDefect;
-		m_vNativCmpInfo[fct].currDefect = norm(vec, m_vNativCmpInfo[fct].vMultiIndex);
+		m_vNativCmpInfo[fct].currDefect = vNorm[fct];
 	}
 
 	// update grouped defects
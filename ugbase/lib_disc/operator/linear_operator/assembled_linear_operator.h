@@ -107,6 +107,11 @@ class AssembledLinearOperator :
 	///	Compute d := d - J(u)*c
 		virtual void apply_sub(vector_type& d, const vector_type& c);
 
+#ifdef UG_PARALLEL
+	///	make c consistent and compute d = J(u)*c
+		virtual void apply_and_make_consistent(vector_type& d, vector_type& c);
+#endif
+
 	///	Set Dirichlet values
 		void set_dirichlet_values(vector_type& u);
 
@@ -119,6 +119,24 @@ AssembledLinearOperator<TAlgebra>::apply(vector_type& d, const vector_type& c)
 	base_type::apply(d, c);
 }
 
+#ifdef UG_PARALLEL
+// 	Make c consistent and compute d = J(u)*c
+template <typename TAlgebra>
+void
+AssembledLinearOperator<TAlgebra>::apply_and_make_consistent(vector_type& d, vector_type& c)
+{
+//	perform check of sizes
+	if(c.size() != this->num_cols() || d.size() != this->num_rows())
+		UG_THROW("AssembledLinearOperator::apply_and_make_consistent: Size of matrix A ["<<
+		        this->num_rows() << " x " << this->num_cols() << "] must match the "
+		        "sizes of vectors x ["<<c.size()<<"], b ["<<d.size()<<"] for the "
+		        " operation b = A*x. Maybe the operator is not initialized ?");
+
+//	Apply Matrix, communication of c is overlapped with the interior rows
+	base_type::apply_and_make_consistent(d, c);
+}
+#endif
+
 //	Compute d := d - J(u)*c
 template <typename TAlgebra>
 void
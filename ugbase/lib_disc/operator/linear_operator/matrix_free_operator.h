@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR__
+
+#include "lib_algebra/operator/interface/linear_operator.h"
+#include "lib_disc/assemble_interface.h"
+#include "lib_disc/spatial_disc/local_to_global/local_to_global_mapper.h"
+
+namespace ug{
+
+///	LocalToGlobalMapper applying the local jacobians to a vector
+/**
+ * Instead of adding the local matrices to the global matrix, this mapper
+ * multiplies each local matrix with the local values of a vector c and adds
+ * the result to a vector d, i.e. it computes d += J_e * c for every element.
+ *
+ * \tparam	TAlgebra			algebra type
+ */
+template <typename TAlgebra>
+class LocalToGlobalMapperMatrixFree : public ILocalToGlobalMapper<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Type of algebra matrix
+		typedef typename algebra_type::matrix_type matrix_type;
+
+	///	Type of algebra vector
+		typedef typename algebra_type::vector_type vector_type;
+
+	public:
+	///	constructor
+		LocalToGlobalMapperMatrixFree(vector_type& d, const vector_type& c)
+			: m_d(d), m_c(c) {}
+
+	///	adds a local vector to the global one
+		void add_local_vec_to_global(vector_type& vec, const LocalVector& lvec,
+				ConstSmartPtr<DoFDistribution> dd);
+
+	///	adds the product of the local matrix with c to d
+		void add_local_mat_to_global(matrix_type& mat, const LocalMatrix& lmat,
+				ConstSmartPtr<DoFDistribution> dd);
+
+	///	modifies local solution vector for adapted defect computation
+		void modify_LocalSol(LocalVector& vecMod, const LocalVector& lvec, ConstSmartPtr<DoFDistribution> dd) {}
+
+	///	destructor
+		~LocalToGlobalMapperMatrixFree() {};
+
+	private:
+	///	vector the product is added to
+		vector_type& m_d;
+
+	///	vector the local jacobians are applied to
+		const vector_type& m_c;
+};
+
+///	linear operator applying the jacobian of a discretization without assembling it
+/**
+ * This operator implements the ILinearOperator interface for the jacobian
+ * J(u) of an IAssemble object, but never stores J(u) as a matrix. Instead,
+ * for every application d = J(u)*c the element loop of the jacobian is
+ * carried out and each local jacobian is applied to c immediately (see
+ * LocalToGlobalMapperMatrixFree). This trades assembling time for memory and
+ * is thus intended for high order discretizations and large problems, where
+ * the storage of the global matrix dominates.
+ *
+ * Since no matrix is available, the operator can only be used with solvers
+ * and preconditioners that only need the application of the operator (e.g.
+ * CG or GMRES without preconditioner). Of the constraints, only Dirichlet
+ * constraints are supported: their rows are taken from a matrix that only
+ * contains the constrained rows.
+ *
+ * \tparam	TAlgebra			algebra type
+ */
+template <typename TAlgebra>
+class MatrixFreeOperator : public virtual ILinearOperator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Type of Algebra
+		typedef TAlgebra algebra_type;
+
+	///	Type of Vector
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Type of Matrix
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	public:
+	///	Default Constructor
+		MatrixFreeOperator() : m_spAss(NULL), m_bInit(false) {};
+
+	///	Constructor
+		MatrixFreeOperator(SmartPtr<IAssemble<TAlgebra> > ass)
+			: m_spAss(ass), m_bInit(false) {};
+
+	///	Constructor
+		MatrixFreeOperator(SmartPtr<IAssemble<TAlgebra> > ass, const GridLevel& gl)
+			: m_spAss(ass), m_gridLevel(gl), m_bInit(false) {};
+
+	///	sets the discretization to be used
+		void set_discretization(SmartPtr<IAssemble<TAlgebra> > ass) {m_spAss = ass;}
+
+	///	returns the discretization to be used
+		SmartPtr<IAssemble<TAlgebra> > discretization() {return m_spAss;}
+
+	///	sets the level used for assembling
+		void set_level(const GridLevel& gl) {m_gridLevel = gl;}
+
+	///	returns the level
+		const GridLevel& level() const {return m_gridLevel;}
+
+	///	initializes the operator at the linearization point u
+		virtual void init(const vector_type& u);
+
+	///	initializes the operator for a linear problem
+		virtual void init();
+
+	///	compute d = J(u)*c
+		virtual void apply(vector_type& d, const vector_type& c);
+
+	///	Compute d := d - J(u)*c
+		virtual void apply_sub(vector_type& d, const vector_type& c);
+
+	///	Set Dirichlet values
+		void set_dirichlet_values(vector_type& u);
+
+	///	Destructor
+		virtual ~MatrixFreeOperator() {};
+
+	protected:
+	///	checks that the constraints of the discretization are supported
+		void check_constraints();
+
+	///	replaces the constrained rows of d by the rows of the constraint matrix
+		void apply_constrained_rows(vector_type& d, const vector_type& c) const;
+
+	protected:
+	// 	assembling procedure
+		SmartPtr<IAssemble<TAlgebra> > m_spAss;
+
+	// 	DoF Distribution used
+		GridLevel m_gridLevel;
+
+	///	linearization point (NULL for linear problems)
+		SmartPtr<vector_type> m_spU;
+
+	///	matrix only containing the rows set by the constraints
+		matrix_type m_J;
+
+	///	flag if operator has been initialized
+		bool m_bInit;
+};
+
+} // namespace ug
+
+// include implementation
+#include "matrix_free_operator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR__ */
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR_IMPL__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR_IMPL__
+
+#include "matrix_free_operator.h"
+#include "lib_disc/common/local_algebra.h"
+#include "lib_disc/spatial_disc/constraints/constraint_interface.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+////////////////////////////////////////////////////////////////////////////////
+//	LocalToGlobalMapperMatrixFree
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TAlgebra>
+void LocalToGlobalMapperMatrixFree<TAlgebra>::
+add_local_vec_to_global(vector_type& vec, const LocalVector& lvec,
+                        ConstSmartPtr<DoFDistribution> dd)
+{
+	AddLocalVector(vec, lvec);
+}
+
+template <typename TAlgebra>
+void LocalToGlobalMapperMatrixFree<TAlgebra>::
+add_local_mat_to_global(matrix_type& mat, const LocalMatrix& lmat,
+                        ConstSmartPtr<DoFDistribution> dd)
+{
+	const LocalIndices& rowInd = lmat.get_row_indices();
+	const LocalIndices& colInd = lmat.get_col_indices();
+
+	for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+		for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+		{
+			number sum = 0.0;
+			for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+				for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+				{
+					const size_t colIndex = colInd.index(fct2,dof2);
+					const size_t colComp = colInd.comp(fct2,dof2);
+
+					sum += lmat.value(fct1,dof1,fct2,dof2)
+							* BlockRef(m_c[colIndex], colComp);
+				}
+
+			BlockRef(m_d[rowInd.index(fct1,dof1)], rowInd.comp(fct1,dof1)) += sum;
+		}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	MatrixFreeOperator
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::check_constraints()
+{
+	if(m_spAss.invalid())
+		UG_THROW("MatrixFreeOperator: Assembling routine not set.");
+
+	for(size_t i = 0; i < m_spAss->num_constraints(); ++i)
+		if(m_spAss->constraint(i)->type() != CT_DIRICHLET)
+			UG_THROW("MatrixFreeOperator: Only Dirichlet constraints are "
+					"supported, but constraint "<<i<<" is of type "
+					<<m_spAss->constraint(i)->type()<<".");
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::init(const vector_type& u)
+{
+	check_constraints();
+
+//	remember linearization point
+	m_spU = u.clone();
+	m_bInit = true;
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::init()
+{
+	check_constraints();
+
+//	the jacobian of a linear problem does not depend on u, a zero vector
+//	of the correct layout is created in the first application
+	m_spU = SPNULL;
+	m_bInit = true;
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::apply(vector_type& d, const vector_type& c)
+{
+	PROFILE_FUNC_GROUP("discretization");
+
+#ifdef UG_PARALLEL
+	if(!c.has_storage_type(PST_CONSISTENT))
+		UG_THROW("Inadequate storage format of Vector c.");
+#endif
+
+	if(!m_bInit)
+		UG_THROW("MatrixFreeOperator::apply: Operator not initialized.");
+
+	if(m_spU.invalid()){
+		m_spU = c.clone_without_values();
+		m_spU->set(0.0);
+	}
+
+	if(c.size() != m_spU->size() || d.size() != m_spU->size())
+		UG_THROW("MatrixFreeOperator::apply: Size of operator ["<<m_spU->size()
+		        <<"] must match the sizes of vectors x ["<<c.size()<<"], b ["
+		        <<d.size()<<"] for the operation b = A*x.");
+
+	d.set(0.0);
+#ifdef UG_PARALLEL
+	d.set_storage_type(PST_ADDITIVE);
+#endif
+
+//	loop the elements, applying each local jacobian to c. The matrix passed
+//	to the assembling only receives the rows set by the constraints.
+	LocalToGlobalMapperMatrixFree<TAlgebra> map(d, c);
+	m_spAss->ass_tuner()->set_mapping(&map);
+	try{
+		m_spAss->assemble_jacobian(m_J, *m_spU, m_gridLevel);
+	}
+	catch(UGError& err){
+		m_spAss->ass_tuner()->set_mapping();
+		err.push_msg("MatrixFreeOperator::apply: Cannot apply jacobian.",
+		             __FILE__, __LINE__);
+		throw(err);
+	}
+	catch(...){
+	//	the mapper is a local object, it must never stay set in the tuner
+		m_spAss->ass_tuner()->set_mapping();
+		throw;
+	}
+	m_spAss->ass_tuner()->set_mapping();
+
+//	set constrained rows
+	apply_constrained_rows(d, c);
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::
+apply_constrained_rows(vector_type& d, const vector_type& c) const
+{
+	typedef typename matrix_type::const_row_iterator const_row_iterator;
+
+	for(size_t i = 0; i < m_J.num_rows(); ++i)
+	{
+		if(m_J.num_connections(i) == 0) continue;
+
+	//	only components with a nonzero row in the constraint matrix are set
+		for(size_t alpha = 0; alpha < GetSize(d[i]); ++alpha)
+		{
+			bool bConstrained = false;
+			number val = 0.0;
+			for(const_row_iterator it = m_J.begin_row(i); it != m_J.end_row(i); ++it)
+			{
+				const size_t j = it.index();
+				for(size_t beta = 0; beta < GetSize(c[j]); ++beta)
+				{
+					const number a = BlockRef(it.value(), alpha, beta);
+					if(a == 0.0) continue;
+					bConstrained = true;
+					val += a * BlockRef(c[j], beta);
+				}
+			}
+			if(bConstrained) BlockRef(d[i], alpha) = val;
+		}
+	}
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::apply_sub(vector_type& d, const vector_type& c)
+{
+#ifdef UG_PARALLEL
+	if(!d.has_storage_type(PST_ADDITIVE))
+		UG_THROW("Inadequate storage format of Vector d.");
+#endif
+
+	SmartPtr<vector_type> spJc = d.clone_without_values();
+	apply(*spJc, c);
+	d -= *spJc;
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::set_dirichlet_values(vector_type& u)
+{
+	if(m_spAss.invalid())
+		UG_THROW("MatrixFreeOperator: Assembling routine not set.");
+
+	try{
+		m_spAss->adjust_solution(u, m_gridLevel);
+	}
+	UG_CATCH_THROW("MatrixFreeOperator::set_dirichlet_values:"
+				" Cannot assemble solution.");
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR_IMPL__ */
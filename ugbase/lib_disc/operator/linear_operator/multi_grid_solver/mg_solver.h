@@ -48,6 +48,7 @@
 #include "lib_algebra/operator/interface/operator.h"
 #include "lib_algebra/operator/preconditioner/jacobi.h"
 #include "lib_algebra/operator/linear_solver/lu.h"
+#include "lib_algebra/cpu_algebra/sparse_triple_product.h"
 #include "lib_disc/dof_manager/dof_distribution.h"
 #include "lib_disc/operator/linear_operator/transfer_interface.h"
 //only for debugging!!!
@@ -442,6 +443,9 @@ class AssembledMultiGridCycle :
 
 		///	missing coarse grid correction
 			matrix_type RimCpl_Coarse_Fine;
+
+		///	Galerkin product R*A*P to the next coarser level (pattern is reused)
+			SparseTripleProduct<matrix_type> RAP;
 		};
 
 	///	storage for all level
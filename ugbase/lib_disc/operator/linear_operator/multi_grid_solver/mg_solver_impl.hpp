@@ -812,7 +812,12 @@ init_rap_operator()
 	for(int lev = m_topLev; lev >= m_baseLev; --lev)
 	{
 		LevData& ld = *m_vLevData[lev];
-		ld.A->resize_and_clear(ld.st->size(), ld.st->size());
+	//	the level memory is reallocated if the grid changes, so the pattern
+	//	of a previous init can be kept and only the values are reset
+		if(ld.A->num_rows() == ld.st->size() && ld.A->num_cols() == ld.st->size())
+			ld.A->set(0.0);
+		else
+			ld.A->resize_and_clear(ld.st->size(), ld.st->size());
 		#ifdef UG_PARALLEL
 		ld.A->set_storage_type(m_spSurfaceMat->get_storage_mask());
 		ld.A->set_layouts(ld.st->layouts());
@@ -929,7 +934,7 @@ init_rap_operator()
 		#endif
 
 		GMG_PROFILE_BEGIN(GMG_BuildRAP_MultiplyRAP);
-		AddMultiplyOf(*lc.A, *R, *spA, *P);
+		lf.RAP.add_multiply_of(*lc.A, *R, *spA, *P);
 		GMG_PROFILE_END();
 		UG_DLOG(LIB_DISC_MULTIGRID, 4, "  end   init_rap_operator: build rap on lev "<<lev<<"\n");
 	}
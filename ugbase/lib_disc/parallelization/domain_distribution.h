@@ -86,6 +86,25 @@ static bool DistributeDomain(TDomain& domainOut,
 							 PartitionMap& partitionMap,
 							 bool createVerticalInterfaces);
 
+///	writes the partitions of a serial domain to one file, from which each process loads its own part
+/**	The domain has to consist of one level. See SavePartitionedGrid.
+ * \note	Only the grid, the main subset handler and the vertex positions are
+ *			written. In contrast to DistributeDomain, neither the refinement
+ *			projector nor additional subset handlers of the domain are
+ *			transferred. They have to be set up again after loading.*/
+template <typename TDomain>
+static bool SavePartitionedDomain(TDomain& domain, PartitionMap& partitionMap,
+								  const char* filename);
+
+///	loads the partition of the local process from a file written by SavePartitionedDomain
+/**	Each process reads only its own part of the file and the interfaces are
+ * created from the global ids stored in the file, so that no grid data has
+ * to be sent from a root process. Has to be called on all processes.
+ * Refinement projectors and additional subset handlers are not restored,
+ * cf. SavePartitionedDomain. See LoadPartitionedGrid.*/
+template <typename TDomain>
+static bool LoadPartitionedDomain(TDomain& domain, const char* filename);
+
 }//	end of namespace
 
 ////////////////////////////////
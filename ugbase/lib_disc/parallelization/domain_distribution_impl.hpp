@@ -33,10 +33,14 @@
 #ifndef __H__UG__domain_distribution_impl__
 #define __H__UG__domain_distribution_impl__
 
+#include <typeinfo>
 #include "domain_distribution.h"
 #include "lib_grid/algorithms/attachment_util.h"
 #include "lib_grid/parallelization/deprecated/load_balancing.h"
 #include "common/serialization.h"
+#include "lib_grid/file_io/file_io_partitioned.h"
+#include "lib_grid/lib_grid_messages.h"
+#include "lib_grid/refinement/projectors/projection_handler.h"
 
 #ifdef UG_PARALLEL
 	#include "pcl/pcl.h"
@@ -440,6 +444,70 @@ static bool DistributeDomain(TDomain& domainOut,
 	return true;
 }
 
+
+///	returns true if the given projector performs more than linear refinement
+/**	The domain creates a plain RefinementProjector, while LoadDomain installs
+ * a ProjectionHandler if the grid file contains projectors. Only projectors
+ * differing from the plain linear one carry information.*/
+static bool IsNonLinearProjector(ConstSmartPtr<RefinementProjector> proj)
+{
+	if(proj.invalid() || typeid(*proj) == typeid(RefinementProjector))
+		return false;
+
+	const ProjectionHandler* ph = dynamic_cast<const ProjectionHandler*>(proj.get());
+	if(!ph)
+		return true;
+
+	if(IsNonLinearProjector(ph->default_projector()))
+		return true;
+	for(size_t i = 0; i < ph->num_projectors(); ++i){
+		if(IsNonLinearProjector(ph->projector(i)))
+			return true;
+	}
+	return false;
+}
+
+
+template <typename TDomain>
+static bool SavePartitionedDomain(TDomain& domain, PartitionMap& partitionMap,
+								  const char* filename)
+{
+	PROFILE_FUNC_GROUP("parallelization");
+	SmartPtr<MultiGrid> pMG = domain.grid();
+	if(partitionMap.get_partition_handler()->grid() != pMG.get())
+		partitionMap.assign_grid(*pMG);
+
+//	projectors and additional subset handlers are not part of the file
+	if(IsNonLinearProjector(domain.refinement_projector())
+	   || !domain.additional_subset_handler_names().empty())
+	{
+		UG_LOG("WARNING in SavePartitionedDomain: The refinement projector and "
+			   "additional subset handlers of the domain are not written to '"
+			   << filename << "'.\n");
+	}
+
+	return SavePartitionedGrid(*pMG, *domain.subset_handler(), partitionMap,
+							   filename, domain.position_attachment());
+}
+
+
+template <typename TDomain>
+static bool LoadPartitionedDomain(TDomain& domain, const char* filename)
+{
+	PROFILE_FUNC_GROUP("parallelization");
+	MultiGrid& mg = *domain.grid();
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STARTS));
+	bool success = LoadPartitionedGrid(mg, *domain.subset_handler(), filename,
+									   domain.position_attachment());
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STOPS));
+
+#ifdef UG_PARALLEL
+	success = pcl::AllProcsTrue(success);
+#endif
+	return success;
+}
+
 }//	end of namespace
 
 #endif
@@ -33,10 +33,13 @@
 #ifndef __H__UG__LIB_DISC__SPATIAL_DISC__ASS_TUNER__
 #define __H__UG__LIB_DISC__SPATIAL_DISC__ASS_TUNER__
 
+#include <map>
+
 #include "lib_grid/tools/bool_marker.h"
 #include "lib_grid/tools/selector_grid.h"
 #include "lib_disc/spatial_disc/local_to_global/local_to_global_mapper.h"
 #include "lib_disc/spatial_disc/elem_disc/elem_disc_interface.h"
+#include "lib_disc/dof_manager/local_index_cache.h"
 
 namespace ug{
 
@@ -114,7 +117,9 @@ class AssemblingTuner
 		m_bSingleAssIndex(false), m_SingleAssIndex(0),
 		m_bForceRegGrid(false), m_bModifySolutionImplemented(false),
 		m_ConstraintTypesEnabled(CT_ALL), m_ElemTypesEnabled(EDT_ALL),
-		m_bMatrixIsConst(false)
+		m_bMatrixIsConst(false), m_numThreads(1),
+		m_bReuseMatrixPattern(false), m_bCacheLocalIndices(false),
+		m_userDataBatchSize(0)
 		{
 			m_pMapper = &m_pMapperCommon;
 		}
@@ -128,6 +133,9 @@ class AssemblingTuner
 				m_pMapper = &m_pMapperCommon;
 		}
 
+	///	returns if the default local to global mapping is used
+		bool default_mapping() const {return m_pMapper == &m_pMapperCommon;}
+
 	/// LocalToGlobalMapper-function calls
 		void add_local_vec_to_global(vector_type& vec, const LocalVector& lvec,
 		                 ConstSmartPtr<DoFDistribution> dd) const
@@ -140,6 +148,23 @@ class AssemblingTuner
 		void modify_LocalSol(LocalVector& vecMod, const LocalVector& lvec,
 		                         ConstSmartPtr<DoFDistribution> dd) const
 		{ m_pMapper->modify_LocalSol(vecMod, lvec, dd);}
+
+	///	adds a local matrix to the global one, using cached matrix positions if possible
+	/**
+	 * If a cache is passed and the default mapping is used, the positions of
+	 * the local couplings in the global matrix are taken from the cache for
+	 * the i'th element of the loop. Otherwise, the mapper is used.
+	 */
+		void add_local_mat_to_global(matrix_type& mat, const LocalMatrix& lmat,
+		                             ConstSmartPtr<DoFDistribution> dd,
+		                             LocalIndexCache* pCache, size_t i,
+		                             GridObject* elem) const
+		{
+			if(pCache != NULL && default_mapping())
+				AddLocalMatrixToGlobal(mat, lmat, *pCache, i, elem);
+			else
+				m_pMapper->add_local_mat_to_global(mat, lmat, dd);
+		}
 	///	sets a marker to exclude elements from assembling
 	/**
 	 * This methods sets a marker. Only elements that are marked will be
@@ -249,6 +274,89 @@ class AssemblingTuner
 	 */
 		bool matrix_is_const() const {return m_bMatrixIsConst;}
 
+	///	sets the number of threads used in the element loops
+	/**
+	 * If more than one thread is requested and ug has been compiled with
+	 * OpenMP, the stationary element loops for the stiffness matrix, the
+	 * jacobian and the defect are carried out by several threads, each with
+	 * its own DataEvaluator and local algebra. The elements are coloured such
+	 * that elements of one colour share no algebra index, thus the local
+	 * contributions of one colour are added to the global matrix/vector
+	 * without locking. This is only done for subsets where all element
+	 * discretizations report IElemDiscBase::thread_safe_assembling() and if
+	 * the default local to global mapping is used; otherwise the serial loop
+	 * is used.
+	 *
+	 * \param[in]	numThreads		number of threads (0 or 1: serial assembling)
+	 */
+		void set_num_threads(size_t numThreads) {m_numThreads = numThreads;}
+
+	///	returns the number of threads used in the element loops
+		size_t num_threads() const {return m_numThreads;}
+
+	///	sets if the sparsity pattern of assembled matrices is reused
+	/**
+	 * If enabled, a matrix whose pattern has already been built with pattern
+	 * reuse for the same revision of the DoFDistribution is not cleared in
+	 * resize(), but only its values are set to zero. The revision is stored
+	 * as a tag in the matrix, which is reset whenever the matrix is resized. Thus, the sparsity
+	 * pattern built in the first assembling is kept (in compressed form) and
+	 * subsequent assemblings (e.g. in every Newton step) only add values to
+	 * existing entries. Entries not present in the pattern are still added.
+	 * The pattern is rebuilt as soon as the DoFDistribution has changed.
+	 *
+	 * \param[in]	bReuse		flag if pattern should be reused
+	 */
+		void set_reuse_matrix_pattern(bool bReuse)
+		{
+			m_bReuseMatrixPattern = bReuse;
+		}
+
+	///	returns if the sparsity pattern of assembled matrices is reused
+		bool matrix_pattern_reused() const {return m_bReuseMatrixPattern;}
+
+	///	sets if the local indices of the elements are cached
+	/**
+	 * If enabled, the LocalIndices of the elements are computed only once
+	 * per revision of the DoFDistribution and then read from a flat cache in
+	 * the element loops of the jacobian, stiffness/mass matrix and defect.
+	 * For matrices, also the storage positions of the local couplings in the
+	 * global matrix are cached, such that (in combination with a reused
+	 * sparsity pattern) no search in the matrix rows is needed. This needs
+	 * additional memory of the order of the matrix size.
+	 *
+	 * \param[in]	bCache		flag if indices should be cached
+	 */
+		void set_cache_local_indices(bool bCache)
+		{
+			m_bCacheLocalIndices = bCache;
+			if(!bCache) m_mLocalIndexCache.clear();
+		}
+
+	///	returns if the local indices of the elements are cached
+		bool local_indices_cached() const {return m_bCacheLocalIndices;}
+
+	///	returns the cache of local indices for an element loop (NULL if not cached)
+		LocalIndexCache* local_index_cache(ConstSmartPtr<DoFDistribution> dd,
+		                                   ReferenceObjectID roid, int si, bool bHang) const;
+
+	///	sets the number of elements for which user data is evaluated at once
+	/**
+	 * If set to a value greater than zero, the element loops gather the
+	 * integration points of the next blockSize elements and evaluate user
+	 * data, that only depends on the global position and the time (e.g. lua
+	 * functions or random fields), for the whole block in one call. The
+	 * values are then handed to the element discs element by element. If an
+	 * element disc uses other integration points than expected for the block,
+	 * the data is evaluated per element as usual.
+	 *
+	 * \param[in]	blockSize	number of elements per block (0: disabled)
+	 */
+		void set_user_data_batch_size(size_t blockSize) {m_userDataBatchSize = blockSize;}
+
+	///	returns the number of elements for which user data is evaluated at once
+		size_t user_data_batch_size() const {return m_userDataBatchSize;}
+
 	protected:
 	///	default LocalToGlobalMapper
 		LocalToGlobalMapper<TAlgebra> m_pMapperCommon;
@@ -281,6 +389,22 @@ class AssemblingTuner
 
 	/// disables matrix assembling if set to false
 		bool m_bMatrixIsConst;
+
+	///	number of threads used in the element loops
+		size_t m_numThreads;
+
+	///	flag if the sparsity pattern of assembled matrices is reused
+		bool m_bReuseMatrixPattern;
+
+	///	flag if local indices are cached
+		bool m_bCacheLocalIndices;
+
+	///	caches of local indices, one per (dof distribution, roid, subset) loop
+		typedef std::pair<const DoFDistribution*, std::pair<int, int> > LocalIndexCacheKey;
+		mutable std::map<LocalIndexCacheKey, LocalIndexCache> m_mLocalIndexCache;
+
+	///	number of elements for which user data is evaluated at once (0: off)
+		size_t m_userDataBatchSize;
 };
 
 } // end namespace ug
@@ -57,10 +57,38 @@ void AssemblingTuner<TAlgebra>::resize(ConstSmartPtr<DoFDistribution> dd,
 	}
 	else{
 		const size_t numIndex = dd->num_indices();
+
+	//	if the pattern has been built for the current dof distribution, only
+	//	reset the values (set() also defragments the matrix if needed)
+		const RevisionCounter& rev = dd->revision();
+		if(m_bReuseMatrixPattern && rev.valid()
+			&& mat.has_pattern_tag(rev.obj(), rev.counter())
+			&& mat.num_rows() == numIndex && mat.num_cols() == numIndex){
+			mat.set(0.0);
+			return;
+		}
+
 		mat.resize_and_clear(numIndex, numIndex);
+
+	//	the tag is stored in the matrix and reset whenever its pattern is rebuilt
+		if(m_bReuseMatrixPattern && rev.valid())
+			mat.set_pattern_tag(rev.obj(), rev.counter());
 	}
 }
 
+template <typename TAlgebra>
+LocalIndexCache* AssemblingTuner<TAlgebra>::
+local_index_cache(ConstSmartPtr<DoFDistribution> dd,
+                  ReferenceObjectID roid, int si, bool bHang) const
+{
+	if(!m_bCacheLocalIndices || single_index_assembling_enabled()) return NULL;
+
+	LocalIndexCache& cache = m_mLocalIndexCache[LocalIndexCacheKey(dd.get(),
+	                                            std::make_pair((int)roid, si))];
+	cache.update(dd, bHang);
+	return &cache;
+}
+
 template <typename TAlgebra>
 template <typename TElem>
 bool AssemblingTuner<TAlgebra>::element_used(TElem* elem) const
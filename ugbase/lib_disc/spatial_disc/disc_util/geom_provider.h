@@ -46,6 +46,10 @@ namespace ug{
  *
  * In addition, the object can be shared between unrelated code parts, if the
  * same object is intended to be used, but no passing is possible or wanted.
+ *
+ * If compiled with OpenMP, every thread has its own instances, such that
+ * element discretizations updating a geometry per element can be used in
+ * thread-parallel element loops.
  */
 template <typename TGeom>
 class GeomProvider
@@ -67,10 +71,17 @@ class GeomProvider
 		/// destructor
 		~GeomProvider() {clear_geoms();}
 
-		/// singleton provider
+		/// singleton provider (one per thread if compiled with OpenMP)
 		static GeomProvider<TGeom>& inst() {
+		#ifdef UG_OPENMP
+			static GeomProvider<TGeom>* pInst = NULL;
+			#pragma omp threadprivate(pInst)
+			if(pInst == NULL) pInst = new GeomProvider<TGeom>;
+			return *pInst;
+		#else
 			static GeomProvider<TGeom> inst;
 			return inst;
+		#endif
 		}
 
 		/// struct to sort keys
@@ -91,10 +102,10 @@ class GeomProvider
 
 		/// vector holding instances
 		typedef std::map<LFEIDandQuadOrder, TGeom*> MapType;
-		static MapType m_mLFEIDandOrder;
+		MapType m_mLFEIDandOrder;
 
 		/// returns class based on identifier
-		static TGeom& get_class(const LFEID lfeID, const int quadOrder) {
+		TGeom& get_class(const LFEID lfeID, const int quadOrder) {
 
 			LFEIDandQuadOrder key(lfeID, quadOrder);
 
@@ -115,7 +126,7 @@ class GeomProvider
 		}
 
 		/// clears all instances
-		static void clear_geoms(){
+		void clear_geoms(){
 			typedef typename std::map<LFEIDandQuadOrder, TGeom*>::iterator MapIter;
 			for(MapIter iter = m_mLFEIDandOrder.begin(); iter != m_mLFEIDandOrder.end(); ++iter)
 				if(iter->second)
@@ -139,11 +150,18 @@ class GeomProvider
 
 		///	returns a singleton based on the identifier
 		static inline TGeom& get(){
-			static TGeom inst;
 			if(!staticLocalData)
 				UG_THROW("GeomProvider: accessing geometry without keys, but"
 						 " geometry may change local data. Use access by keys instead.");
+		#ifdef UG_OPENMP
+			static TGeom* pInst = NULL;
+			#pragma omp threadprivate(pInst)
+			if(pInst == NULL) pInst = new TGeom;
+			return *pInst;
+		#else
+			static TGeom inst;
 			return inst;
+		#endif
 		}
 
 		///	clears all singletons
@@ -152,10 +170,6 @@ class GeomProvider
 		}
 };
 
-template <typename TGeom>
-std::map<typename GeomProvider<TGeom>::LFEIDandQuadOrder, TGeom*> GeomProvider<TGeom>::m_mLFEIDandOrder
-						= std::map<typename GeomProvider<TGeom>::LFEIDandQuadOrder, TGeom*>();
-
 
 } // end namespace ug
 
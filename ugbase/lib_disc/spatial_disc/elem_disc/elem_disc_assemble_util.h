@@ -36,6 +36,7 @@
 // extern includes
 #include <iostream>
 #include <vector>
+#include <bitset>
 
 // other ug4 modules
 #include "common/common.h"
@@ -45,6 +46,7 @@
 #include "./elem_disc_interface.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/common/local_algebra.h"
+#include "lib_disc/dof_manager/local_index_cache.h"
 #include "lib_disc/spatial_disc/user_data/data_evaluator.h"
 #include "bridge/util_algebra_dependent.h"
 
@@ -124,6 +126,17 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	#ifdef UG_OPENMP
+	//	use the threaded element loop if requested and possible
+		if(ThreadedAssemblingPossible(vElemDisc, spAssTuner))
+		{
+			ThreadedMatrixAssembler assembler(STIFF, "AssembleStiffnessMatrix", A, u);
+			if(AssembleElemLoopThreaded<TElem>(assembler, vElemDisc, spDomain, dd,
+			                                   iterBegin, iterEnd, si, bNonRegularGrid, spAssTuner))
+				return;
+		}
+	#endif
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -141,6 +154,10 @@ public:
 	//	local indices and local algebra
 		LocalIndices ind; LocalVector locU; LocalMatrix locA;
 
+	//	cache of local indices (if enabled)
+		LocalIndexCache* pCache = spAssTuner->local_index_cache(dd, id, si, Eval.use_hanging());
+		size_t elemCnt = 0;
+
 	//	Loop over all elements
 		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
 		{
@@ -152,9 +169,15 @@ public:
 
 		//	check if elem is skipped from assembling
 			if(!spAssTuner->element_used(elem)) continue;
+			const size_t elemIndex = elemCnt++;
+
+		//	evaluate position dependent user data for a block of elements
+			if(spAssTuner->user_data_batch_size() > 0 && Eval.pos_data_prefetch_needed(elem))
+				PrefetchPosData<TElem>(Eval, iter, iterEnd, *spDomain, spAssTuner);
 
 		//	get global indices
-			dd->indices(elem, ind, Eval.use_hanging());
+			if(pCache) pCache->indices(elemIndex, elem, ind);
+			else dd->indices(elem, ind, Eval.use_hanging());
 
 		//	adapt local algebra
 			locU.resize(ind); locA.resize(ind);
@@ -179,7 +202,7 @@ public:
 
 		//	send local to global matrix
 			try{
-				spAssTuner->add_local_mat_to_global(A,locA,dd);
+				spAssTuner->add_local_mat_to_global(A, locA, dd, pCache, elemIndex, elem);
 			}
 			UG_CATCH_THROW("AssembleStiffnessMatrix: Cannot add local matrix.");
 		}
@@ -249,6 +272,10 @@ public:
 	//	local indices and local algebra
 		LocalIndices ind; LocalVector locU; LocalMatrix locM;
 
+	//	cache of local indices (if enabled)
+		LocalIndexCache* pCache = spAssTuner->local_index_cache(dd, id, si, Eval.use_hanging());
+		size_t elemCnt = 0;
+
 	//	Loop over all elements
 		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
 		{
@@ -260,9 +287,15 @@ public:
 
 		//	check if elem is skipped from assembling
 			if(!spAssTuner->element_used(elem)) continue;
+			const size_t elemIndex = elemCnt++;
+
+		//	evaluate position dependent user data for a block of elements
+			if(spAssTuner->user_data_batch_size() > 0 && Eval.pos_data_prefetch_needed(elem))
+				PrefetchPosData<TElem>(Eval, iter, iterEnd, *spDomain, spAssTuner);
 
 		//	get global indices
-			dd->indices(elem, ind, Eval.use_hanging());
+			if(pCache) pCache->indices(elemIndex, elem, ind);
+			else dd->indices(elem, ind, Eval.use_hanging());
 
 		//	adapt local algebra
 			locU.resize(ind); locM.resize(ind);
@@ -287,7 +320,7 @@ public:
 
 		// send local to global matrix
 			try{
-				spAssTuner->add_local_mat_to_global(M, locM, dd);
+				spAssTuner->add_local_mat_to_global(M, locM, dd, pCache, elemIndex, elem);
 			}
 			UG_CATCH_THROW("AssembleMassMatrix: Cannot add local matrix.");
 		}
@@ -338,6 +371,17 @@ public:
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	#ifdef UG_OPENMP
+	//	use the threaded element loop if requested and possible
+		if(ThreadedAssemblingPossible(vElemDisc, spAssTuner))
+		{
+			ThreadedMatrixAssembler assembler(STIFF | RHS, "(stationary) AssembleJacobian", J, u);
+			if(AssembleElemLoopThreaded<TElem>(assembler, vElemDisc, spDomain, dd,
+			                                   iterBegin, iterEnd, si, bNonRegularGrid, spAssTuner))
+				return;
+		}
+	#endif
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -356,6 +400,10 @@ public:
 	//	local indices and local algebra
 		LocalIndices ind; LocalVector locU; LocalMatrix locJ;
 
+	//	cache of local indices (if enabled)
+		LocalIndexCache* pCache = spAssTuner->local_index_cache(dd, id, si, Eval.use_hanging());
+		size_t elemCnt = 0;
+
 	//	Loop over all elements
 		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
 		{
@@ -367,9 +415,15 @@ public:
 
 		//	check if elem is skipped from assembling
 			if(!spAssTuner->element_used(elem)) continue;
+			const size_t elemIndex = elemCnt++;
+
+		//	evaluate position dependent user data for a block of elements
+			if(spAssTuner->user_data_batch_size() > 0 && Eval.pos_data_prefetch_needed(elem))
+				PrefetchPosData<TElem>(Eval, iter, iterEnd, *spDomain, spAssTuner);
 
 		//	get global indices
-			dd->indices(elem, ind, Eval.use_hanging());
+			if(pCache) pCache->indices(elemIndex, elem, ind);
+			else dd->indices(elem, ind, Eval.use_hanging());
 
 		//	adapt local algebra
 			locU.resize(ind); locJ.resize(ind);
@@ -396,7 +450,7 @@ public:
 
 		// send local to global matrix
 			try{
-				spAssTuner->add_local_mat_to_global(J, locJ, dd);
+				spAssTuner->add_local_mat_to_global(J, locJ, dd, pCache, elemIndex, elem);
 			}
 			UG_CATCH_THROW("(stationary) AssembleJacobian: Cannot add local matrix.");
 		}
@@ -478,6 +532,10 @@ public:
 	//	local algebra
 		LocalIndices ind; LocalVector locU; LocalMatrix locJ;
 
+	//	cache of local indices (if enabled)
+		LocalIndexCache* pCache = spAssTuner->local_index_cache(dd, id, si, Eval.use_hanging());
+		size_t elemCnt = 0;
+
 		EL_PROFILE_BEGIN(Elem_AssembleJacobian);
 	//	Loop over all elements
 		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
@@ -490,9 +548,11 @@ public:
 
 		//	check if elem is skipped from assembling
 			if(!spAssTuner->element_used(elem)) continue;
+			const size_t elemIndex = elemCnt++;
 
 		//	get global indices
-			dd->indices(elem, ind, Eval.use_hanging());
+			if(pCache) pCache->indices(elemIndex, elem, ind);
+			else dd->indices(elem, ind, Eval.use_hanging());
 
 		//	adapt local algebra
 			locU.resize(ind); locJ.resize(ind);
@@ -535,7 +595,7 @@ public:
 
 		// send local to global matrix
 			try{
-				spAssTuner->add_local_mat_to_global(J, locJ, dd);
+				spAssTuner->add_local_mat_to_global(J, locJ, dd, pCache, elemIndex, elem);
 			}
 			UG_CATCH_THROW("(instationary) AssembleJacobian: Cannot add local matrix.");
 
@@ -589,6 +649,17 @@ public:
 	//	check if at least one element exists, else return
 		if(iterBegin == iterEnd) return;
 
+	#ifdef UG_OPENMP
+	//	use the threaded element loop if requested and possible
+		if(ThreadedAssemblingPossible(vElemDisc, spAssTuner))
+		{
+			ThreadedDefectAssembler assembler(d, u);
+			if(AssembleElemLoopThreaded<TElem>(assembler, vElemDisc, spDomain, dd,
+			                                   iterBegin, iterEnd, si, bNonRegularGrid, spAssTuner))
+				return;
+		}
+	#endif
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -607,6 +678,10 @@ public:
 	//	local indices and local algebra
 		LocalIndices ind; LocalVector locU, locD, tmpLocD;
 
+	//	cache of local indices (if enabled)
+		LocalIndexCache* pCache = spAssTuner->local_index_cache(dd, id, si, Eval.use_hanging());
+		size_t elemCnt = 0;
+
 	//	Loop over all elements
 		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
 		{
@@ -618,9 +693,15 @@ public:
 
 		//	check if elem is skipped from assembling
 			if(!spAssTuner->element_used(elem)) continue;
+			const size_t elemIndex = elemCnt++;
+
+		//	evaluate position dependent user data for a block of elements
+			if(spAssTuner->user_data_batch_size() > 0 && Eval.pos_data_prefetch_needed(elem))
+				PrefetchPosData<TElem>(Eval, iter, iterEnd, *spDomain, spAssTuner);
 
 		//	get global indices
-			dd->indices(elem, ind, Eval.use_hanging());
+			if(pCache) pCache->indices(elemIndex, elem, ind);
+			else dd->indices(elem, ind, Eval.use_hanging());
 
 		//	adapt local algebra
 			locU.resize(ind); locD.resize(ind); tmpLocD.resize(ind);
@@ -758,6 +839,10 @@ public:
 	//	local indices and local algebra
 		LocalIndices ind; LocalVector locD, tmpLocD;
 
+	//	cache of local indices (if enabled)
+		LocalIndexCache* pCache = spAssTuner->local_index_cache(dd, id, si, Eval.use_hanging());
+		size_t elemCnt = 0;
+
 	//	Loop over all elements
 		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
 		{
@@ -769,9 +854,11 @@ public:
 
 		//	check if elem is skipped from assembling
 			if(!spAssTuner->element_used(elem)) continue;
+			const size_t elemIndex = elemCnt++;
 
 		//	get global indices
-			dd->indices(elem, ind, Eval.use_hanging());
+			if(pCache) pCache->indices(elemIndex, elem, ind);
+			else dd->indices(elem, ind, Eval.use_hanging());
 
 		//	adapt local algebra
 			locD.resize(ind); tmpLocD.resize(ind);
@@ -948,6 +1035,10 @@ public:
 		//	check if elem is skipped from assembling
 			if(!spAssTuner->element_used(elem)) continue;
 
+		//	evaluate position dependent user data for a block of elements
+			if(spAssTuner->user_data_batch_size() > 0 && Eval.pos_data_prefetch_needed(elem))
+				PrefetchPosData<TElem>(Eval, iter, iterEnd, *spDomain, spAssTuner);
+
 		//	get global indices
 			dd->indices(elem, ind, Eval.use_hanging());
 
@@ -1291,6 +1382,10 @@ public:
 		//	check if elem is skipped from assembling
 			if(!spAssTuner->element_used(elem)) continue;
 
+		//	evaluate position dependent user data for a block of elements
+			if(spAssTuner->user_data_batch_size() > 0 && Eval.pos_data_prefetch_needed(elem))
+				PrefetchPosData<TElem>(Eval, iter, iterEnd, *spDomain, spAssTuner);
+
 		//	get global indices
 			dd->indices(elem, ind, Eval.use_hanging());
 
@@ -2060,6 +2155,363 @@ public:
 		UG_CATCH_THROW("AssembleErrorEstimator: Cannot create Data Evaluator.");
 	}
 
+////////////////////////////////////////////////////////////////////////////////
+// Blockwise evaluation of user data
+////////////////////////////////////////////////////////////////////////////////
+
+protected:
+	/**
+	 * Collects the next used elements (at most user_data_batch_size() many),
+	 * starting at iter, and lets the DataEvaluator evaluate the position
+	 * dependent user data for all of them at once.
+	 */
+	template <typename TElem, typename TIterator>
+	static void
+	PrefetchPosData(DataEvaluator<domain_type>& Eval,
+	                TIterator iter, TIterator iterEnd,
+	                const domain_type& dom,
+	                ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+		const size_t blockSize = spAssTuner->user_data_batch_size();
+
+		std::vector<GridObject*> vElem;
+		std::vector<MathVector<domain_type::dim> > vCornerCoords;
+		vElem.reserve(blockSize);
+		vCornerCoords.reserve(blockSize * TElem::NUM_VERTICES);
+
+		MathVector<domain_type::dim> vCo[TElem::NUM_VERTICES];
+		for(; iter != iterEnd && vElem.size() < blockSize; ++iter)
+		{
+			TElem* elem = *iter;
+			if(!spAssTuner->element_used(elem)) continue;
+
+			FillCornerCoordinates(vCo, *elem, dom);
+			vElem.push_back(elem);
+			vCornerCoords.insert(vCornerCoords.end(), vCo, vCo + TElem::NUM_VERTICES);
+		}
+
+		Eval.prefetch_pos_data(id, vElem, vCornerCoords);
+	}
+
+////////////////////////////////////////////////////////////////////////////////
+// Thread-parallel element loops (OpenMP)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef UG_OPENMP
+protected:
+	///	returns if the element loop can be carried out by several threads
+	/**
+	 * Besides the opt-in of every element discretization, no import may be
+	 * connected to user data: the (coupled) user data objects are shared by
+	 * the DataEvaluators of all threads and store the evaluated values per
+	 * series in members, so concurrent evaluation is not possible. Since the
+	 * elements are coloured by their algebra indices, the default local to
+	 * global mapping must be used. Otherwise, the serial element loop is used.
+	 */
+	static bool
+	ThreadedAssemblingPossible(const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                           ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		if(spAssTuner->num_threads() < 2 || !spAssTuner->default_mapping())
+			return false;
+		for(size_t i = 0; i < vElemDisc.size(); ++i)
+		{
+			if(!vElemDisc[i]->thread_safe_assembling()) return false;
+			for(size_t imp = 0; imp < vElemDisc[i]->num_imports(); ++imp)
+				if(vElemDisc[i]->get_import(imp).data_given()) return false;
+		}
+		return true;
+	}
+
+	///	collects the elements of the loop that are used for assembling
+	template <typename TElem, typename TIterator>
+	static void
+	CollectUsedElements(std::vector<TElem*>& vElem,
+	                    TIterator iterBegin, TIterator iterEnd,
+	                    ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+		vElem.clear();
+		for(TIterator iter = iterBegin; iter != iterEnd; ++iter)
+			if(spAssTuner->element_used(*iter)) vElem.push_back(*iter);
+	}
+
+	///	stores the exception currently handled by a thread
+	/**
+	 * Exceptions must not leave an OpenMP region. Thus, they are caught in
+	 * the threads, stored and the first one is rethrown after the region.
+	 * This function must be called from within a catch block.
+	 */
+	static void
+	StoreThreadError(std::vector<UGError>& vErr, const char* name, const char* msg)
+	{
+		const std::string fullMsg = std::string(name) + ": " + msg;
+		#pragma omp critical(ug_assemble_error)
+		{
+			try {throw;}
+			catch(UGError& err)
+			{
+				vErr.push_back(err);
+				vErr.back().push_msg(fullMsg, __FILE__, __LINE__);
+			}
+			catch(const std::exception& ex)
+			{
+				vErr.push_back(UGError(fullMsg, ex, __FILE__, __LINE__));
+			}
+			catch(...)
+			{
+				vErr.push_back(UGError(fullMsg + " Unknown exception.", __FILE__, __LINE__));
+			}
+		}
+	}
+
+	///	local assembling of the threaded stiffness matrix and (stationary) jacobian loop
+	/**
+	 * The local matrices are added at the matrix positions computed before
+	 * the threads are started. No smart pointers are held, since the
+	 * object is copied by every thread.
+	 */
+	struct ThreadedMatrixAssembler
+	{
+		ThreadedMatrixAssembler(int discPart, const char* name,
+		                        matrix_type& A, const vector_type& u)
+			: m_discPart(discPart), m_name(name), m_A(A), m_u(u) {}
+
+	///	computes the matrix positions of all elements (called serially)
+		void begin(LocalIndexCache& cache) {cache.update_matrix_positions(m_A);}
+
+	///	assembles the local matrix of an element and adds it to the global one
+		void assemble(DataEvaluator<domain_type>& Eval, GridObject* elem,
+		              ReferenceObjectID id,
+		              const MathVector<domain_type::dim> vCornerCoords[],
+		              const LocalIndices& ind, LocalIndexCache& cache, size_t i)
+		{
+			m_locU.resize(ind); m_locA.resize(ind);
+			GetLocalVector(m_locU, m_u);
+
+			Eval.prepare_elem(m_locU, elem, id, vCornerCoords, ind, true);
+
+			m_locA = 0.0;
+			Eval.add_jac_A_elem(m_locA, m_locU, elem, vCornerCoords);
+
+			AddLocalMatrixToGlobalAtPositions(m_A, m_locA, cache.matrix_positions(i, elem));
+		}
+
+	///	marks the values of the matrix as changed (called serially)
+		void end() {m_A.values_changed();}
+
+		int m_discPart;
+		const char* m_name;
+		matrix_type& m_A;
+		const vector_type& m_u;
+		LocalVector m_locU;
+		LocalMatrix m_locA;
+	};
+
+	///	local assembling of the threaded (stationary) defect loop
+	struct ThreadedDefectAssembler
+	{
+		ThreadedDefectAssembler(vector_type& d, const vector_type& u)
+			: m_discPart(STIFF | RHS), m_name("(stationary) AssembleDefect"),
+			  m_d(d), m_u(u) {}
+
+		void begin(LocalIndexCache& cache) {}
+
+	///	assembles the local defect of an element and adds it to the global one
+	/**
+	 * The solution is not modified, since this is a no-op for the default
+	 * local to global mapping (see ThreadedAssemblingPossible).
+	 */
+		void assemble(DataEvaluator<domain_type>& Eval, GridObject* elem,
+		              ReferenceObjectID id,
+		              const MathVector<domain_type::dim> vCornerCoords[],
+		              const LocalIndices& ind, LocalIndexCache& cache, size_t i)
+		{
+			m_locU.resize(ind); m_locD.resize(ind); m_tmpLocD.resize(ind);
+			GetLocalVector(m_locU, m_u);
+
+			Eval.prepare_elem(m_locU, elem, id, vCornerCoords, ind);
+
+			m_locD = 0.0;
+			Eval.add_def_A_elem(m_locD, m_locU, elem, vCornerCoords);
+
+			m_tmpLocD = 0.0;
+			Eval.add_rhs_elem(m_tmpLocD, elem, vCornerCoords);
+			m_locD.scale_append(-1, m_tmpLocD);
+
+			AddLocalVector(m_d, m_locD);
+		}
+
+		void end() {}
+
+		int m_discPart;
+		const char* m_name;
+		vector_type& m_d;
+		const vector_type& m_u;
+		LocalVector m_locU, m_locD, m_tmpLocD;
+	};
+
+	///	carries out an element loop by several threads
+	/**
+	 * The elements are coloured, such that elements of the same colour share
+	 * no algebra index. The elements of one colour are distributed among the
+	 * threads, which add their local contributions to the global matrix or
+	 * vector without locking (see TLocalAssembler::assemble). Every thread
+	 * uses its own copy of the local assembler, its own DataEvaluator and
+	 * (via the GeomProvider) its own geometries. The element discretizations
+	 * are shared: their prepare_elem_loop and finish_elem_loop are called by
+	 * one thread at a time and never while another thread is in the element
+	 * loop. The per element methods are run concurrently, which the element
+	 * discretizations allow by IElemDiscBase::thread_safe_assembling().
+	 *
+	 * \returns false if the element loop has not been carried out, since the
+	 * 			elements could not be cached or coloured. The serial loop must
+	 * 			be used then.
+	 */
+	template <typename TElem, typename TLocalAssembler, typename TIterator>
+	static bool
+	AssembleElemLoopThreaded(	TLocalAssembler& assembler,
+								const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+								ConstSmartPtr<domain_type> spDomain,
+								ConstSmartPtr<DoFDistribution> dd,
+								TIterator iterBegin,
+								TIterator iterEnd,
+								int si, bool bNonRegularGrid,
+								ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+	{
+	//	reference object id
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+	//	maximal number of colours (otherwise the serial loop is used)
+		static const size_t maxColours = 128;
+
+	//	elements used in assembling (random access needed for work sharing)
+		std::vector<TElem*> vElem;
+		CollectUsedElements(vElem, iterBegin, iterEnd, spAssTuner);
+
+	//	hanging dofs are used if needed by one of the discretizations (as in the DataEvaluator)
+		bool bHang = false;
+		if(bNonRegularGrid)
+			for(size_t i = 0; i < vElemDisc.size(); ++i)
+				bHang |= vElemDisc[i]->use_hanging();
+
+	//	the indices of all elements are cached, such that the threads only read them
+		LocalIndexCache localCache;
+		LocalIndexCache* pCache = spAssTuner->local_index_cache(dd, id, si, bHang);
+		if(pCache == NULL) {localCache.update(dd, bHang); pCache = &localCache;}
+
+	//	colour the elements: elements of the same colour share no algebra index
+		std::vector<std::bitset<maxColours> > vIndexColours(dd->num_indices());
+		std::vector<size_t> vColour(vElem.size());
+		std::vector<size_t> vColourStart(maxColours + 1, 0);
+		size_t numColours = 0;
+		LocalIndices ind;
+		for(size_t i = 0; i < vElem.size(); ++i)
+		{
+			pCache->indices(i, vElem[i], ind);
+			if(!pCache->cached(i, vElem[i])) return false;
+
+			std::bitset<maxColours> used;
+			for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+				for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+					used |= vIndexColours[ind.index(fct, dof)];
+
+			size_t c = 0;
+			while(c < maxColours && used[c]) ++c;
+			if(c == maxColours) return false;
+
+			for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+				for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+					vIndexColours[ind.index(fct, dof)].set(c);
+
+			vColour[i] = c;
+			++vColourStart[c+1];
+			if(c + 1 > numColours) numColours = c + 1;
+		}
+
+	//	sort the elements by colour
+		for(size_t c = 0; c < numColours; ++c)
+			vColourStart[c+1] += vColourStart[c];
+		std::vector<size_t> vOrder(vElem.size());
+		std::vector<size_t> vNext(vColourStart.begin(), vColourStart.begin() + numColours);
+		for(size_t i = 0; i < vElem.size(); ++i)
+			vOrder[vNext[vColour[i]]++] = i;
+
+		assembler.begin(*pCache);
+
+	//	errors thrown in the threads, rethrown after the parallel region
+		std::vector<UGError> vErr;
+
+		#pragma omp parallel num_threads(spAssTuner->num_threads())
+		{
+		//	thread-local storage
+			TLocalAssembler locAss(assembler);
+			MathVector<domain_type::dim> vCornerCoords[TElem::NUM_VERTICES];
+			LocalIndices locInd;
+			SmartPtr<DataEvaluator<domain_type> > spEval;
+
+		//	the DataEvaluator writes to the shared element discretizations and
+		//	copies shared smart pointers, thus is created by one thread at a time
+			#pragma omp critical(ug_assemble_elem_loop)
+			{
+				try
+				{
+					spEval = make_sp(new DataEvaluator<domain_type>(locAss.m_discPart,
+					                 vElemDisc, dd->function_pattern(), bNonRegularGrid));
+					spEval->prepare_elem_loop(id, si);
+				}
+				catch(...)
+				{
+					StoreThreadError(vErr, locAss.m_name, "Cannot prepare element loop.");
+					spEval = SPNULL;
+				}
+			}
+			#pragma omp barrier
+
+			for(size_t c = 0; c < numColours; ++c)
+			{
+				const long colourBegin = (long) vColourStart[c];
+				const long colourEnd = (long) vColourStart[c+1];
+
+				#pragma omp for schedule(dynamic, 64)
+				for(long k = colourBegin; k < colourEnd; ++k)
+				{
+					if(spEval.invalid()) continue;
+					const size_t i = vOrder[k];
+					try
+					{
+						FillCornerCoordinates(vCornerCoords, *vElem[i], *spDomain);
+						pCache->indices(i, vElem[i], locInd);
+						locAss.assemble(*spEval, vElem[i], id, vCornerCoords, locInd, *pCache, i);
+					}
+					catch(...)
+					{
+						StoreThreadError(vErr, locAss.m_name, "Cannot assemble element.");
+					}
+				}
+			}
+
+			#pragma omp critical(ug_assemble_elem_loop)
+			{
+				if(spEval.valid())
+				{
+					try {spEval->finish_elem_loop();}
+					catch(...)
+					{
+						StoreThreadError(vErr, locAss.m_name, "Cannot finish element loop.");
+					}
+					spEval = SPNULL;
+				}
+			}
+		}
+
+		assembler.end();
+
+		if(!vErr.empty()) throw vErr[0];
+		return true;
+	}
+#endif // UG_OPENMP
+
 }; // class StdGlobAssembler
 
 } // end namespace ug
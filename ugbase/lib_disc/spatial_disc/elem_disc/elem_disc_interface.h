@@ -750,6 +750,24 @@ class IElemDiscBase
 	 * element assemblings but is needed for finite volumes
 	 */
 		virtual bool use_hanging() const {return false;}
+
+	///	returns if the discretization may be assembled by several threads concurrently
+	/**
+	 * If threaded assembling is requested (cf. AssemblingTuner::set_num_threads),
+	 * every thread uses its own DataEvaluator, LocalIndices and local algebra,
+	 * but all threads share this element discretization. prep_elem_loop and
+	 * fsh_elem_loop are called once per thread, but by one thread at a time
+	 * and never during the element loop of another thread. An implementation
+	 * may only return true if its prep_elem/add_*_elem methods do not
+	 * store per-element data in members; geometries obtained from the
+	 * GeomProvider are thread-local and may be updated (but must not be
+	 * kept in static references). Note, that this is not sufficient: user data connected to the imports
+	 * is shared by all threads and stores its values per series (m_vvValue,
+	 * m_vvBatchValue), hence the assembling falls back to the serial element
+	 * loop as soon as any import of the discretization is connected to data.
+	 * The default is false, leading to the serial element loop.
+	 */
+		virtual bool thread_safe_assembling() const {return false;}
 };
 
 
@@ -142,6 +142,16 @@ class NeumannBoundaryFV1
 	///	type of trial space for each function used
 		virtual void prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid);
 
+	///	returns if the discretization may be assembled by several threads concurrently
+	/**
+	 * The geometry is taken from the (thread-local) GeomProvider in every
+	 * assembling function, thus the element methods only write to the
+	 * geometry of the calling thread. Concurrent assembling is possible, if
+	 * only constant boundary values are used and no boundary value is
+	 * given as import.
+	 */
+		virtual bool thread_safe_assembling() const;
+
 	protected:
 	///	assembling functions for fv1
 	///	\{
@@ -34,6 +34,8 @@
 
 #include "data_evaluator.h"
 #include "lib_disc/common/groups_util.h"
+#include "lib_disc/reference_element/reference_element_util.h"
+#include "lib_disc/reference_element/reference_mapping_provider.h"
 
 namespace ug{
 
@@ -85,6 +87,17 @@ prepare_elem_loop(const ReferenceObjectID id, int si)
 //	evaluate constant data
 	for(size_t i = 0; i < m_vConstData.size(); ++i)
 		m_vConstData[i]->compute((LocalVector*)NULL, NULL, NULL, false);
+
+//	mark position data that can be evaluated blockwise
+	clear_batch();
+	m_vPosDataBatched.assign(m_vPosData.size(), false);
+	m_numPosDataBatched = 0;
+	for(size_t i = 0; i < m_vPosData.size(); ++i){
+		if(m_vPosData[i]->batch_evaluable()){
+			m_vPosDataBatched[i] = true;
+			++m_numPosDataBatched;
+		}
+	}
 }
 
 template <typename TDomain>
@@ -99,6 +112,111 @@ void DataEvaluator<TDomain>::finish_elem_loop()
 
 //	clear positions at user data
 	clear_positions_in_user_data();
+
+//	forget prefetched block
+	clear_batch();
+}
+
+template <typename TDomain>
+void DataEvaluator<TDomain>::clear_batch()
+{
+	m_vBatchElem.clear();
+	m_batchCurr = 0;
+}
+
+template <typename TDomain>
+template <int refDim>
+void DataEvaluator<TDomain>::
+map_batch_ips(std::vector<MathVector<dim> >& vGlobIP,
+              const ICplUserData<dim>& data, size_t s,
+              const ReferenceObjectID roid, size_t numElem,
+              const std::vector<MathVector<dim> >& vCornerCoords) const
+{
+	const size_t numIP = data.num_ip(s);
+	const size_t numCo = vCornerCoords.size() / numElem;
+	const MathVector<refDim>* vLocIP = data.template local_ips<refDim>(s);
+
+	vGlobIP.resize(numElem * numIP);
+	for(size_t k = 0; k < numElem; ++k)
+	{
+		DimReferenceMapping<refDim, dim>& map
+			= ReferenceMappingProvider::get<refDim, dim>(roid, &vCornerCoords[k*numCo]);
+		map.local_to_global(&vGlobIP[k*numIP], vLocIP, numIP);
+	}
+}
+
+template <typename TDomain>
+void DataEvaluator<TDomain>::
+prefetch_pos_data(const ReferenceObjectID roid,
+                  const std::vector<GridObject*>& vElem,
+                  const std::vector<MathVector<dim> >& vCornerCoords)
+{
+	clear_batch();
+	const size_t numElem = vElem.size();
+	if(numElem == 0) return;
+
+	const int refDim = ReferenceElementDimension(roid);
+	m_vvBatchNumIP.resize(m_vPosData.size());
+	m_vvvBatchIP.resize(m_vPosData.size());
+
+	try{
+	for(size_t i = 0; i < m_vPosData.size(); ++i)
+	{
+		if(!m_vPosDataBatched[i]) continue;
+		ICplUserData<dim>& data = *m_vPosData[i];
+
+	//	only ips given on the element itself can be mapped
+		if(data.num_series() > 0 && data.dim_local_ips() != refDim){
+			m_vPosDataBatched[i] = false;
+			--m_numPosDataBatched;
+			continue;
+		}
+
+		m_vvBatchNumIP[i].resize(data.num_series());
+		m_vvvBatchIP[i].resize(data.num_series());
+		for(size_t s = 0; s < data.num_series(); ++s)
+		{
+			std::vector<MathVector<dim> >& vGlobIP = m_vvvBatchIP[i][s];
+			m_vvBatchNumIP[i][s] = data.num_ip(s);
+			if(data.num_ip(s) == 0) continue;
+
+			switch(refDim){
+				case 1: map_batch_ips<1>(vGlobIP, data, s, roid, numElem, vCornerCoords); break;
+				case 2: map_batch_ips<2>(vGlobIP, data, s, roid, numElem, vCornerCoords); break;
+				case 3: map_batch_ips<3>(vGlobIP, data, s, roid, numElem, vCornerCoords); break;
+				default: UG_THROW("DataEvaluator: Reference dimension "<<refDim<<" not supported.");
+			}
+
+			data.compute_batch(s, &vGlobIP[0], vGlobIP.size());
+		}
+	}
+	}
+	UG_CATCH_THROW("DataEvaluator::prefetch_pos_data: Cannot evaluate data for block.");
+
+	m_vBatchElem = vElem;
+}
+
+template <typename TDomain>
+bool DataEvaluator<TDomain>::batch_values_valid(size_t i, size_t k) const
+{
+	const ICplUserData<dim>& data = *m_vPosData[i];
+	if(data.num_series() != m_vvBatchNumIP[i].size()) return false;
+
+//	the prefetched values are only valid, if the element disc has requested
+//	the data at the positions used for the block
+	for(size_t s = 0; s < data.num_series(); ++s)
+	{
+		const size_t numIP = m_vvBatchNumIP[i][s];
+		if(data.num_ip(s) != numIP) return false;
+		if(numIP == 0) continue;
+
+		const MathVector<dim>* vIP = data.ips(s);
+		const MathVector<dim>* vBatchIP = &(m_vvvBatchIP[i][s][k*numIP]);
+		for(size_t ip = 0; ip < numIP; ++ip)
+			if(VecDistanceSq(vIP[ip], vBatchIP[ip]) > 1e-20 * (1.0 + VecLengthSq(vIP[ip])))
+				return false;
+	}
+	return true;
 }
 
 
@@ -162,9 +280,28 @@ prepare_elem(LocalVector& u, GridObject* elem, const ReferenceObjectID roid, con
 			m_vDependentData[i]->update_dof_sizes(ind);
 	}
 
-//	evaluate position data
+//	evaluate position data (copy from the prefetched block if possible)
+	const bool bInBatch = (m_batchCurr < m_vBatchElem.size()
+							&& m_vBatchElem[m_batchCurr] == elem);
 	for(size_t i = 0; i < m_vPosData.size(); ++i)
+	{
+		if(bInBatch && m_vPosDataBatched[i])
+		{
+			if(batch_values_valid(i, m_batchCurr))
+			{
+				for(size_t s = 0; s < m_vPosData[i]->num_series(); ++s)
+					m_vPosData[i]->copy_batch_values(s, m_batchCurr * m_vvBatchNumIP[i][s]);
+				continue;
+			}
+
+		//	ips differ from the block, evaluate per element from now on
+			m_vPosDataBatched[i] = false;
+			--m_numPosDataBatched;
+		}
 		m_vPosData[i]->compute(&u, elem, vCornerCoords, false);
+	}
+	if(bInBatch) ++m_batchCurr;
+	else clear_batch();
 
 // 	process dependent data:
 //	We can not simply compute exports first, then Linker, because an export
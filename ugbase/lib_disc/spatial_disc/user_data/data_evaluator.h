@@ -180,7 +180,8 @@ public:
 		              LocalVectorTimeSeries* locTimeSeries = NULL,
 		              const std::vector<number>* vScaleMass = NULL,
 		              const std::vector<number>* vScaleStiff = NULL)
-	: DataEvaluatorBase<TDomain, IElemDisc<TDomain> > (discPart, vElemDisc, fctPat, bNonRegularGrid, locTimeSeries, vScaleMass, vScaleStiff) {}
+	: DataEvaluatorBase<TDomain, IElemDisc<TDomain> > (discPart, vElemDisc, fctPat, bNonRegularGrid, locTimeSeries, vScaleMass, vScaleStiff),
+	  m_batchCurr(0), m_numPosDataBatched(0) {}
 
 
 	////////////////////////////////////////////
@@ -228,6 +229,69 @@ public:
 			void add_rhs_elem(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCornerCoords[], ProcessType type = PT_ALL);
 
 			using base_type::time_series_needed;
+
+	////////////////////////////////////////////
+	// Blockwise evaluation of position data
+	///////////////////////////////////////////
+
+		///	returns if the position data should be prefetched for a block starting at elem
+			bool pos_data_prefetch_needed(GridObject* elem) const
+			{
+				if(m_numPosDataBatched == 0) return false;
+				return m_batchCurr >= m_vBatchElem.size()
+						|| m_vBatchElem[m_batchCurr] != elem;
+			}
+
+		///	evaluates the position data for a block of elements at once
+		/**
+		 * For all position dependent user data, that supports batched
+		 * evaluation, the global integration points of all passed elements
+		 * are computed from the currently registered local integration points
+		 * and the data is evaluated for the whole block in one call.
+		 * prepare_elem then copies the values for the elements of the block,
+		 * which must be prepared in the same order as passed here.
+		 *
+		 * \param[in]	roid			reference object id of the elements
+		 * \param[in]	vElem			elements of the block
+		 * \param[in]	vCornerCoords	corner coordinates of all elements
+		 */
+			void prefetch_pos_data(const ReferenceObjectID roid,
+			                       const std::vector<GridObject*>& vElem,
+			                       const std::vector<MathVector<dim> >& vCornerCoords);
+
+protected:
+		///	computes the global ips of a series for all elements of a block
+			template <int refDim>
+			void map_batch_ips(std::vector<MathVector<dim> >& vGlobIP,
+			                   const ICplUserData<dim>& data, size_t s,
+			                   const ReferenceObjectID roid, size_t numElem,
+			                   const std::vector<MathVector<dim> >& vCornerCoords) const;
+
+		///	returns if the prefetched values of a data can be used for the k'th element of the block
+			bool batch_values_valid(size_t i, size_t k) const;
+
+		///	clears the current block
+			void clear_batch();
+
+protected:
+	///	elements of the current block
+		std::vector<GridObject*> m_vBatchElem;
+
+	///	position of the next element to be prepared in the block
+		size_t m_batchCurr;
+
+	///	flags if position data is evaluated blockwise (per entry of m_vPosData)
+		std::vector<bool> m_vPosDataBatched;
+
+	///	number of position data evaluated blockwise
+		size_t m_numPosDataBatched;
+
+	///	number of ips per series used for the block (per entry of m_vPosData)
+		std::vector<std::vector<size_t> > m_vvBatchNumIP;
+
+	///	global ips per series used for the block (per entry of m_vPosData)
+		std::vector<std::vector<std::vector<MathVector<dim> > > > m_vvvBatchIP;
+
 protected:
 
 	using base_type::m_vElemDisc;
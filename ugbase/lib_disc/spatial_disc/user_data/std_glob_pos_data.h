@@ -116,6 +116,9 @@ class StdGlobPosData
 	///	returns if provided data is continuous over geometric object boundaries
 		virtual bool continuous() const {return true;}
 
+	///	returns that the data can be evaluated for many elements at once
+		virtual bool batch_evaluable() const {return true;}
+
 	protected:
 	///	access to implementation
 		TImpl& getImpl() {return static_cast<TImpl&>(*this);}
@@ -290,6 +290,34 @@ class ICplUserData : virtual public UserDataInfo
 	///	resize arrays
 		virtual void update_dof_sizes(const LocalIndices& ind) {}
 
+	public:
+	///	returns if the data can be evaluated for many elements at once
+	/**
+	 * Data, that only depends on the global position and the time, can be
+	 * evaluated for the integration points of a whole block of elements in
+	 * one call (see compute_batch). This allows the implementation to
+	 * vectorize the evaluation and avoids one virtual call per element.
+	 */
+		virtual bool batch_evaluable() const {return false;}
+
+	///	evaluates the data for a block of global positions of a series
+	/**
+	 * The values are computed at the current time for all numIP positions
+	 * and are stored in an internal buffer, from which they are copied
+	 * per element by copy_batch_values.
+	 */
+		virtual void compute_batch(size_t s, const MathVector<dim>* vGlobIP,
+		                           size_t numIP)
+		{
+			UG_THROW("ICplUserData: batched evaluation not supported.");
+		}
+
+	///	copies num_ip(s) values, starting at offset, from the batch buffer
+		virtual void copy_batch_values(size_t s, size_t offset)
+		{
+			UG_THROW("ICplUserData: batched evaluation not supported.");
+		}
+
 	public:
 	///	returns the number of ip series
 		size_t num_series() const {return m_vNumIP.size();}
@@ -518,6 +546,13 @@ class CplUserData : public ICplUserData<dim>, public UserData<TData,dim,TRet>
 	///	register all callbacks registered by class
 		void unregister_storage_callback(DataImport<TData,dim>* obj);
 
+	///	evaluates the data for a block of global positions of a series
+		virtual void compute_batch(size_t s, const MathVector<dim>* vGlobIP,
+		                           size_t numIP);
+
+	///	copies num_ip(s) values, starting at offset, from the batch buffer
+		virtual void copy_batch_values(size_t s, size_t offset);
+
 	protected:
 	///	checks in debug mode the correct index
 		inline void check_series(size_t s) const;
@@ -547,6 +582,9 @@ class CplUserData : public ICplUserData<dim>, public UserData<TData,dim,TRet>
 	/// bool flag at ip (size: (0,...num_series-1) x (0,...,num_ip-1))
 		std::vector<std::vector<bool> > m_vvBoolFlag;
 
+	///	values computed for a block of elements (size: num_series x block ips)
+		std::vector<std::vector<TData> > m_vvBatchValue;
+
 	///	registered callbacks
 //		typedef void (DataImport<TData,dim>::*CallbackFct)();
 		typedef boost::function<void ()> CallbackFct;
@@ -304,6 +304,35 @@ call_storage_callback() const
 	}
 }
 
+template <typename TData, int dim, typename TRet>
+void CplUserData<TData,dim,TRet>::
+compute_batch(size_t s, const MathVector<dim>* vGlobIP, size_t numIP)
+{
+	check_series(s);
+	if(m_vvBatchValue.size() < num_series())
+		m_vvBatchValue.resize(num_series());
+
+	std::vector<TData>& vBatch = m_vvBatchValue[s];
+	if(vBatch.size() < numIP) vBatch.resize(numIP);
+	if(numIP == 0) return;
+
+	this->operator()(&vBatch[0], vGlobIP, this->time(), this->subset(), numIP);
+}
+
+template <typename TData, int dim, typename TRet>
+void CplUserData<TData,dim,TRet>::
+copy_batch_values(size_t s, size_t offset)
+{
+	check_series(s);
+	UG_ASSERT(s < m_vvBatchValue.size(), "Batch not computed for series "<<s);
+	UG_ASSERT(offset + num_ip(s) <= m_vvBatchValue[s].size(),
+	          "Batch too small for series "<<s);
+
+	const TData* vBatch = &(m_vvBatchValue[s][offset]);
+	for(size_t ip = 0; ip < num_ip(s); ++ip)
+		m_vvValue[s][ip] = vBatch[ip];
+}
+
 template <typename TData, int dim, typename TRet>
 inline void CplUserData<TData,dim,TRet>::check_series(size_t s) const
 {
@@ -352,6 +381,7 @@ void CplUserData<TData,dim,TRet>::local_ip_series_to_be_cleared()
 //	clear all series
 	m_vvValue.clear();
 	m_vvBoolFlag.clear();
+	m_vvBatchValue.clear();
 
 //	call base class callback (if implementation given)
 //	base_type::local_ip_series_to_be_cleared();
@@ -38,6 +38,10 @@
 #include "debug_util.h"
 #include "common/util/hash.h"
 
+#ifdef UG_PARALLEL
+	#include "lib_grid/parallelization/distributed_grid.h"
+#endif
+
 using namespace std;
 
 #define PROFILE_GRID_SERIALIZATION
@@ -2580,4 +2584,241 @@ bool DeserializeSubsetHandler(Grid& grid, ISubsetHandler& sh,
 							in, readPropertyMap);
 }
 
+
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+//	DISTRIBUTED MULTI-GRID
+
+#ifdef UG_PARALLEL
+////////////////////////////////////////////////////////////////////////
+//	WriteGridLayoutsToStream
+//	helper method for SerializeDistributedMultiGrid
+/**	For each layout-key the interfaces of each level are written. Interface
+ * elements are written in order, using their serialization index.*/
+template <class TElem>
+static
+void WriteGridLayoutsToStream(GridLayoutMap& glm,
+							  MultiElementAttachmentAccessor<AInt>& aaInt,
+							  BinaryBuffer& out)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Map			TLayoutMap;
+	typedef typename GridLayoutMap::Types<TElem>::Layout		TLayout;
+	typedef typename GridLayoutMap::Types<TElem>::Interface		TInterface;
+
+	int numLayouts = 0;
+	for(typename TLayoutMap::iterator iter = glm.layouts_begin<TElem>();
+		iter != glm.layouts_end<TElem>(); ++iter)
+		++numLayouts;
+	Serialize(out, numLayouts);
+
+	for(typename TLayoutMap::iterator iter = glm.layouts_begin<TElem>();
+		iter != glm.layouts_end<TElem>(); ++iter)
+	{
+		Serialize(out, iter->first);
+		TLayout& layout = iter->second;
+
+		int numLevels = (int)layout.num_levels();
+		Serialize(out, numLevels);
+		for(int lvl = 0; lvl < numLevels; ++lvl){
+			int numInterfaces = 0;
+			for(typename TLayout::iterator iIter = layout.begin(lvl);
+				iIter != layout.end(lvl); ++iIter)
+				++numInterfaces;
+			Serialize(out, numInterfaces);
+
+			for(typename TLayout::iterator iIter = layout.begin(lvl);
+				iIter != layout.end(lvl); ++iIter)
+			{
+				TInterface& itfc = layout.interface(iIter);
+				Serialize(out, layout.proc_id(iIter));
+				Serialize(out, (int)itfc.size());
+				for(typename TInterface::iterator eIter = itfc.begin();
+					eIter != itfc.end(); ++eIter)
+				{
+					Serialize(out, aaInt[itfc.get_element(eIter)]);
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+//	ReadGridLayoutsFromStream
+//	helper method for DeserializeDistributedMultiGrid
+template <class TElem>
+static
+bool ReadGridLayoutsFromStream(GridLayoutMap& glm,
+							   const vector<TElem*>& vElems,
+							   BinaryBuffer& in)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Layout		TLayout;
+	typedef typename GridLayoutMap::Types<TElem>::Interface		TInterface;
+
+	int numLayouts = Deserialize<int>(in);
+	for(int i = 0; i < numLayouts; ++i){
+		GridLayoutMap::Key key = Deserialize<GridLayoutMap::Key>(in);
+		TLayout& layout = glm.get_layout<TElem>(key);
+
+		int numLevels = Deserialize<int>(in);
+		for(int lvl = 0; lvl < numLevels; ++lvl){
+			int numInterfaces = Deserialize<int>(in);
+			for(int j = 0; j < numInterfaces; ++j){
+				int procID = Deserialize<int>(in);
+				int numElems = Deserialize<int>(in);
+				TInterface& itfc = layout.interface(procID, lvl);
+				for(int k = 0; k < numElems; ++k){
+					int ind = Deserialize<int>(in);
+					if(ind < 0 || ind >= (int)vElems.size()){
+						UG_LOG("ERROR in DeserializeDistributedMultiGrid: "
+								"Bad interface element index.\n");
+						return false;
+					}
+					itfc.push_back(vElems[ind]);
+				}
+			}
+		}
+	}
+	return true;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////
+//	SerializeDistributedMultiGrid
+bool SerializeDistributedMultiGrid(MultiGrid& mg, ISubsetHandler& sh,
+								   MultiElementAttachmentAccessor<AInt>& aaInt,
+								   BinaryBuffer& out)
+{
+	SRLZ_PROFILE_FUNC();
+
+//	write a magic number at the beginning and at the end.
+	int magicNumber = 9834721;
+	out.write((char*)&magicNumber, sizeof(int));
+
+	if(!SerializeMultiGridElements(mg, mg.get_grid_objects(), aaInt, out))
+		return false;
+
+//	subset-infos (an empty collection only writes the infos)
+	if(!SerializeSubsetHandler(mg, sh, GridObjectCollection(), out))
+		return false;
+
+	WriteSubsetIndicesInSerializationOrder<Vertex>(mg.get_grid_objects(), sh, aaInt, out);
+	WriteSubsetIndicesInSerializationOrder<Edge>(mg.get_grid_objects(), sh, aaInt, out);
+	WriteSubsetIndicesInSerializationOrder<Face>(mg.get_grid_objects(), sh, aaInt, out);
+	WriteSubsetIndicesInSerializationOrder<Volume>(mg.get_grid_objects(), sh, aaInt, out);
+
+#ifdef UG_PARALLEL
+	DistributedGridManager* pDGM = mg.distributed_grid_manager();
+	bool hasLayouts = (pDGM != NULL);
+	Serialize(out, hasLayouts);
+	if(hasLayouts){
+		GridLayoutMap& glm = pDGM->grid_layout_map();
+		WriteGridLayoutsToStream<Vertex>(glm, aaInt, out);
+		WriteGridLayoutsToStream<Edge>(glm, aaInt, out);
+		WriteGridLayoutsToStream<Face>(glm, aaInt, out);
+		WriteGridLayoutsToStream<Volume>(glm, aaInt, out);
+	}
+#else
+	Serialize(out, false);
+#endif
+
+	out.write((char*)&magicNumber, sizeof(int));
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+//	DeserializeDistributedMultiGrid
+bool DeserializeDistributedMultiGrid(MultiGrid& mg, ISubsetHandler& sh,
+									 BinaryBuffer& in,
+									 std::vector<Vertex*>* pvVrts,
+									 std::vector<Edge*>* pvEdges,
+									 std::vector<Face*>* pvFaces,
+									 std::vector<Volume*>* pvVols)
+{
+	SRLZ_PROFILE_FUNC();
+
+	if(mg.num_vertices() > 0){
+		UG_LOG("ERROR in DeserializeDistributedMultiGrid: The grid has to be empty.\n");
+		return false;
+	}
+
+	vector<Vertex*>	vVrtsTMP;
+	vector<Edge*>	vEdgesTMP;
+	vector<Face*>	vFacesTMP;
+	vector<Volume*>	vVolsTMP;
+
+	if(!pvVrts)
+		pvVrts = &vVrtsTMP;
+	if(!pvEdges)
+		pvEdges = &vEdgesTMP;
+	if(!pvFaces)
+		pvFaces = &vFacesTMP;
+	if(!pvVols)
+		pvVols = &vVolsTMP;
+
+	int magicNumber = 9834721;
+	int tInd;
+	in.read((char*)&tInd, sizeof(int));
+	if(tInd != magicNumber){
+		UG_LOG("ERROR in DeserializeDistributedMultiGrid: Magic number mismatch "
+				"before deserialization.\n");
+		return false;
+	}
+
+//	interfaces are restored from the stream and must not be created
+//	automatically during element creation
+#ifdef UG_PARALLEL
+	DistributedGridManager* pDGM = mg.distributed_grid_manager();
+	if(pDGM)
+		pDGM->enable_interface_management(false);
+#endif
+
+	bool success = DeserializeMultiGridElements(mg, in, pvVrts, pvEdges, pvFaces, pvVols)
+				&& DeserializeSubsetHandler(mg, sh, GridObjectCollection(), in)
+				&& ReadSubsetIndicesInSerializationOrder(sh, *pvVrts, in)
+				&& ReadSubsetIndicesInSerializationOrder(sh, *pvEdges, in)
+				&& ReadSubsetIndicesInSerializationOrder(sh, *pvFaces, in)
+				&& ReadSubsetIndicesInSerializationOrder(sh, *pvVols, in);
+
+	bool hasLayouts = success && Deserialize<bool>(in);
+#ifdef UG_PARALLEL
+	if(pDGM){
+		if(hasLayouts){
+			GridLayoutMap& glm = pDGM->grid_layout_map();
+			success = ReadGridLayoutsFromStream(glm, *pvVrts, in)
+					&& ReadGridLayoutsFromStream(glm, *pvEdges, in)
+					&& ReadGridLayoutsFromStream(glm, *pvFaces, in)
+					&& ReadGridLayoutsFromStream(glm, *pvVols, in);
+			glm.remove_empty_interfaces();
+		}
+	//	interface management has to be enabled again on all paths
+		pDGM->enable_interface_management(true);
+		pDGM->grid_layouts_changed(false);
+	}
+	else if(hasLayouts){
+		UG_LOG("ERROR in DeserializeDistributedMultiGrid: The stream contains "
+				"grid layouts, but the grid has no DistributedGridManager.\n");
+		success = false;
+	}
+#else
+	if(hasLayouts){
+		UG_LOG("ERROR in DeserializeDistributedMultiGrid: The stream contains "
+				"grid layouts, which can only be read in a parallel build.\n");
+		success = false;
+	}
+#endif
+
+	if(!success)
+		return false;
+
+	in.read((char*)&tInd, sizeof(int));
+	if(tInd != magicNumber){
+		UG_LOG("ERROR in DeserializeDistributedMultiGrid: Magic number mismatch "
+				"after deserialization.\n");
+		return false;
+	}
+
+	return true;
+}
+
 }//	end of namespace
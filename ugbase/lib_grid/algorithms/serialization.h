@@ -595,6 +595,74 @@ bool DeserializeSubsetHandler(Grid& grid, ISubsetHandler& sh,
 							BinaryBuffer& in,
 							bool readPropertyMap = true);
 
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+//	DISTRIBUTED MULTI-GRID
+
+////////////////////////////////////////////////////////////////////////
+///	writes all elements, subsets and grid layouts of a MultiGrid to a stream.
+/**
+ * Writes the elements of mg (see SerializeMultiGridElements), the
+ * subset-infos and subset-indices of all elements and, in a parallel
+ * environment, all interfaces of the grid-layout-map of the
+ * DistributedGridManager of mg.
+ *
+ * The caller is responsible to attach the aInt attachment to the elements
+ * of the grid before calling this method and to detach it afterwards.
+ * After termination the attachments hold the indices that were assigned
+ * to the respective elements - starting from 0 for each element type.
+ * Those indices match the positions of the elements in the vectors
+ * returned by DeserializeDistributedMultiGrid and may thus be used to
+ * serialize additional element data.
+ *
+ * In contrary to a redistribution, the grid layouts are written as they are.
+ * The stream thus has to be read by the same process on the same number
+ * of processes.
+ */
+bool SerializeDistributedMultiGrid(MultiGrid& mg, ISubsetHandler& sh,
+								   MultiElementAttachmentAccessor<AInt>& aaInt,
+								   BinaryBuffer& out);
+
+////////////////////////////////////////////////////////////////////////
+///	restores elements, subsets and grid layouts written by SerializeDistributedMultiGrid.
+/**
+ * mg has to be empty. If you pass a pointer to a std::vector using pvVrts,
+ * pvEdges, pvFaces or pvVolumes, those vectors will contain the elements
+ * of the grid in the order they were written.
+ *
+ * In a parallel environment, the interface management of the
+ * DistributedGridManager is disabled during creation. The interfaces are
+ * then restored from the stream and the DistributedGridManager is informed
+ * that the grid layouts changed.
+ */
+bool DeserializeDistributedMultiGrid(MultiGrid& mg, ISubsetHandler& sh,
+									 BinaryBuffer& in,
+									 std::vector<Vertex*>* pvVrts = NULL,
+									 std::vector<Edge*>* pvEdges = NULL,
+									 std::vector<Face*>* pvFaces = NULL,
+									 std::vector<Volume*>* pvVols = NULL);
+
+////////////////////////////////////////////////////////////////////////
+///	writes the subset indices of the elements in goc in the order given by aaInt
+/**	The indices in aaInt have to be the serialization indices of the elements
+ * in goc (as assigned by SerializeMultiGridElements), starting from 0 for
+ * each element type.*/
+template <class TElem>
+void WriteSubsetIndicesInSerializationOrder(GridObjectCollection goc,
+								ISubsetHandler& sh,
+								MultiElementAttachmentAccessor<AInt>& aaInt,
+								BinaryBuffer& out);
+
+////////////////////////////////////////////////////////////////////////
+///	reads subset indices written by WriteSubsetIndicesInSerializationOrder
+/**	vElems has to contain the elements in the order they were serialized.
+ * \returns false if the number of indices does not match the elements.*/
+template <class TElem>
+bool ReadSubsetIndicesInSerializationOrder(ISubsetHandler& sh,
+								const std::vector<TElem*>& vElems,
+								BinaryBuffer& in);
+
 /*
 bool SerializeSelector(Grid& grid, Selector& sel, BinaryBuffer& out);
 
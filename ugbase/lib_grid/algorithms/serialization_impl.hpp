@@ -246,6 +246,47 @@ bool DeserializeAttachment(Grid& grid, TAttachment& attachment,
 
 	return true;
 }
+
+////////////////////////////////////////////////////////////////////////
+template <class TElem>
+void WriteSubsetIndicesInSerializationOrder(GridObjectCollection goc,
+								ISubsetHandler& sh,
+								MultiElementAttachmentAccessor<AInt>& aaInt,
+								BinaryBuffer& out)
+{
+	typedef typename geometry_traits<TElem>::iterator	TIter;
+
+	std::vector<int> vSubsetInds(goc.num<TElem>(), -1);
+	for(size_t lvl = 0; lvl < goc.num_levels(); ++lvl){
+		for(TIter iter = goc.begin<TElem>(lvl); iter != goc.end<TElem>(lvl); ++iter){
+			TElem* e = *iter;
+			vSubsetInds[aaInt[e]] = sh.get_subset_index(e);
+		}
+	}
+	Serialize(out, vSubsetInds);
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TElem>
+bool ReadSubsetIndicesInSerializationOrder(ISubsetHandler& sh,
+								const std::vector<TElem*>& vElems,
+								BinaryBuffer& in)
+{
+	std::vector<int> vSubsetInds;
+	Deserialize(in, vSubsetInds);
+	if(vSubsetInds.size() != vElems.size()){
+		UG_LOG("ERROR in ReadSubsetIndicesInSerializationOrder: Number of subset "
+				"indices does not match the number of elements.\n");
+		return false;
+	}
+
+	for(size_t i = 0; i < vElems.size(); ++i){
+		if(vSubsetInds[i] >= 0)
+			sh.assign_subset(vElems[i], vSubsetInds[i]);
+	}
+	return true;
+}
+
 }
 
 #endif
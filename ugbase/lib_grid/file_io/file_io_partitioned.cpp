@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <vector>
+#include "file_io_partitioned.h"
+#include "common/error.h"
+#include "common/serialization.h"
+#include "common/util/binary_buffer.h"
+#include "common/util/combined_file.h"
+#include "common/profiler/profiler.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "lib_grid/tools/selector_multi_grid.h"
+#include "lib_grid/common_attachments.h"
+#include "lib_grid/parallelization/parallel_grid_layout.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl.h"
+	#include "pcl/parallel_file.h"
+	#include "lib_grid/parallelization/distributed_grid.h"
+#endif
+
+using namespace std;
+
+namespace ug
+{
+
+///	magic number at the beginning and at the end of each partition block
+static const int PARTITIONED_GRID_MAGIC_NUMBER = 5128734;
+
+///	holds the sorted ranks of the processes on which an element is required
+typedef Attachment<vector<int> >	AProcVec;
+
+
+////////////////////////////////////////////////////////////////////////
+//	helpers for SavePartitionedGrid
+static void InsertProc(vector<int>& procs, int proc)
+{
+	vector<int>::iterator iter = lower_bound(procs.begin(), procs.end(), proc);
+	if(iter == procs.end() || *iter != proc)
+		procs.insert(iter, proc);
+}
+
+///	adds the target process of the partition of each element.
+/**	Elements which neither are contained in a partition nor received
+ * processes from an associated element are assigned to process 0.*/
+template <class TElem>
+static bool AddOwnTargetProcs(MultiGrid& mg, PartitionMap& pm,
+							  MultiElementAttachmentAccessor<AProcVec>& aaProcs)
+{
+	typedef typename geometry_traits<TElem>::iterator	TIter;
+	SubsetHandler& partSH = *pm.get_partition_handler();
+
+	for(TIter iter = mg.begin<TElem>(); iter != mg.end<TElem>(); ++iter){
+		TElem* e = *iter;
+		int si = partSH.get_subset_index(e);
+		if(si >= 0){
+			if(si >= (int)pm.num_target_procs()){
+				UG_LOG("ERROR in SavePartitionedGrid: No target process "
+						"specified for partition " << si << ".\n");
+				return false;
+			}
+			InsertProc(aaProcs[e], pm.get_target_proc(si));
+		}
+		if(aaProcs[e].empty())
+			aaProcs[e].push_back(0);
+	}
+	return true;
+}
+
+///	passes the target processes of each element of type TElem to its sides
+template <class TElem, class TSide>
+static void PassTargetProcsToSides(MultiGrid& mg,
+								   MultiElementAttachmentAccessor<AProcVec>& aaProcs)
+{
+	typedef typename geometry_traits<TElem>::iterator	TIter;
+	typename Grid::traits<TSide>::secure_container	sides;
+
+	for(TIter iter = mg.begin<TElem>(); iter != mg.end<TElem>(); ++iter){
+		TElem* e = *iter;
+		const vector<int>& procs = aaProcs[e];
+		mg.associated_elements(sides, e);
+		for(size_t i = 0; i < sides.size(); ++i){
+			vector<int>& sideProcs = aaProcs[sides[i]];
+			for(size_t j = 0; j < procs.size(); ++j)
+				InsertProc(sideProcs, procs[j]);
+		}
+	}
+}
+
+///	assigns consecutive global indices and collects the elements of each process
+template <class TElem>
+static void SortIntoProcessLists(MultiGrid& mg,
+								 MultiElementAttachmentAccessor<AProcVec>& aaProcs,
+								 MultiElementAttachmentAccessor<AInt>& aaGlobalInd,
+								 vector<vector<TElem*> >& vProcElems)
+{
+	typedef typename geometry_traits<TElem>::iterator	TIter;
+
+	int globalInd = 0;
+	for(TIter iter = mg.begin<TElem>(); iter != mg.end<TElem>(); ++iter){
+		TElem* e = *iter;
+		aaGlobalInd[e] = globalInd++;
+		const vector<int>& procs = aaProcs[e];
+		for(size_t i = 0; i < procs.size(); ++i)
+			vProcElems[procs[i]].push_back(e);
+	}
+}
+
+///	writes local index, global index and sharing processes of each shared element in goc
+template <class TElem>
+static void WriteSharedElements(GridObjectCollection& goc,
+								MultiElementAttachmentAccessor<AInt>& aaInt,
+								MultiElementAttachmentAccessor<AInt>& aaGlobalInd,
+								MultiElementAttachmentAccessor<AProcVec>& aaProcs,
+								BinaryBuffer& out)
+{
+	typedef typename geometry_traits<TElem>::iterator	TIter;
+
+	int numShared = 0;
+	for(TIter iter = goc.begin<TElem>(0); iter != goc.end<TElem>(0); ++iter){
+		if(aaProcs[*iter].size() > 1)
+			++numShared;
+	}
+
+	Serialize(out, numShared);
+	for(TIter iter = goc.begin<TElem>(0); iter != goc.end<TElem>(0); ++iter){
+		TElem* e = *iter;
+		if(aaProcs[e].size() > 1){
+			Serialize(out, aaInt[e]);
+			Serialize(out, aaGlobalInd[e]);
+			Serialize(out, aaProcs[e]);
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	helpers for LoadPartitionedGrid
+///	reads the shared elements and adds them to the horizontal interfaces
+/**	The elements of each interface are sorted by their global index, so that
+ * both sides of an interface see the same order without communication.
+ * pglm may only be NULL if no shared elements exist.*/
+template <class TElem>
+static bool ReadSharedElements(const vector<TElem*>& vElems, BinaryBuffer& in,
+							   GridLayoutMap* pglm)
+{
+	typedef pair<int, TElem*>						IndElemPair;
+	typedef map<int, vector<IndElemPair> >			InterfaceMap;
+
+	int numShared = Deserialize<int>(in);
+	if(numShared == 0)
+		return true;
+
+#ifdef UG_PARALLEL
+	if(!pglm){
+		UG_LOG("ERROR in LoadPartitionedGrid: The grid has no "
+				"DistributedGridManager.\n");
+		return false;
+	}
+
+	InterfaceMap masterInterfaces, slaveInterfaces;
+	const int localProc = pcl::ProcRank();
+	vector<int> procs;
+
+	for(int i = 0; i < numShared; ++i){
+		int localInd = Deserialize<int>(in);
+		int globalInd = Deserialize<int>(in);
+		Deserialize(in, procs);
+		if(localInd < 0 || localInd >= (int)vElems.size() || procs.empty()){
+			UG_LOG("ERROR in LoadPartitionedGrid: Bad shared element entry.\n");
+			return false;
+		}
+
+		TElem* e = vElems[localInd];
+		if(procs.front() == localProc){
+			for(size_t j = 1; j < procs.size(); ++j)
+				masterInterfaces[procs[j]].push_back(IndElemPair(globalInd, e));
+		}
+		else
+			slaveInterfaces[procs.front()].push_back(IndElemPair(globalInd, e));
+	}
+
+	GridLayoutMap& glm = *pglm;
+	for(int i = 0; i < 2; ++i){
+		InterfaceMap& interfaces = (i == 0) ? masterInterfaces : slaveInterfaces;
+		typename GridLayoutMap::Types<TElem>::Layout& layout =
+			glm.get_layout<TElem>((i == 0) ? INT_H_MASTER : INT_H_SLAVE);
+
+		for(typename InterfaceMap::iterator iter = interfaces.begin();
+			iter != interfaces.end(); ++iter)
+		{
+			vector<IndElemPair>& elems = iter->second;
+			sort(elems.begin(), elems.end());
+			typename GridLayoutMap::Types<TElem>::Interface& itfc =
+				layout.interface(iter->first, 0);
+			for(size_t j = 0; j < elems.size(); ++j)
+				itfc.push_back(elems[j].second);
+		}
+	}
+	return true;
+#else
+	UG_LOG("ERROR in LoadPartitionedGrid: The file contains shared elements, "
+			"which can only be read in a parallel build.\n");
+	return false;
+#endif
+}
+
+///	reads the block of the local process from a combined parallel file
+static void ReadPartitionBlock(BinaryBuffer& buf, const char* filename)
+{
+#ifdef UG_PARALLEL
+	pcl::ReadCombinedParallelFile(buf, filename);
+#else
+	try{
+		ReadCombinedFileSerial(buf, filename);
+	}
+	UG_CATCH_THROW("LoadPartitionedGrid: Could not read '" << filename << "'.");
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////
+template <class TAPos>
+bool SavePartitionedGrid(MultiGrid& mg, ISubsetHandler& sh, PartitionMap& pm,
+						 const char* filename, TAPos& aPos)
+{
+	PROFILE_FUNC_GROUP("grid");
+	typedef typename TAPos::ValueType	TPos;
+
+	if(mg.num_levels() > 1){
+		UG_LOG("ERROR in SavePartitionedGrid: Only grids with one level are "
+				"supported.\n");
+		return false;
+	}
+
+	if(pm.get_partition_handler()->grid() != &mg){
+		UG_LOG("ERROR in SavePartitionedGrid: The partition map does not "
+				"operate on the given grid.\n");
+		return false;
+	}
+
+	if(!mg.has_vertex_attachment(aPos)){
+		UG_LOG("ERROR in SavePartitionedGrid: Missing position attachment.\n");
+		return false;
+	}
+	Grid::VertexAttachmentAccessor<TAPos> aaPos(mg, aPos);
+
+//	one block is written for each process up to the highest target process
+	int numProcs = 1;
+	for(size_t i = 0; i < pm.num_target_procs(); ++i)
+		numProcs = max(numProcs, pm.get_target_proc(i) + 1);
+
+//	find the processes on which each element is required
+	AProcVec aProcs;
+	mg.attach_to_all(aProcs);
+	MultiElementAttachmentAccessor<AProcVec> aaProcs(mg, aProcs);
+
+	bool success = AddOwnTargetProcs<Volume>(mg, pm, aaProcs);
+	PassTargetProcsToSides<Volume, Face>(mg, aaProcs);
+	success = success && AddOwnTargetProcs<Face>(mg, pm, aaProcs);
+	PassTargetProcsToSides<Face, Edge>(mg, aaProcs);
+	success = success && AddOwnTargetProcs<Edge>(mg, pm, aaProcs);
+	PassTargetProcsToSides<Edge, Vertex>(mg, aaProcs);
+	success = success && AddOwnTargetProcs<Vertex>(mg, pm, aaProcs);
+
+	FILE* f = NULL;
+	if(success){
+		f = fopen(filename, "wb");
+		if(!f){
+			UG_LOG("ERROR in SavePartitionedGrid: Could not open '" << filename << "'.\n");
+			success = false;
+		}
+	}
+
+	if(!success){
+		mg.detach_from_all(aProcs);
+		return false;
+	}
+
+	AInt aGlobalInd;
+	mg.attach_to_all(aGlobalInd);
+	MultiElementAttachmentAccessor<AInt> aaGlobalInd(mg, aGlobalInd);
+
+	vector<vector<Vertex*> >	vProcVrts(numProcs);
+	vector<vector<Edge*> >		vProcEdges(numProcs);
+	vector<vector<Face*> >		vProcFaces(numProcs);
+	vector<vector<Volume*> >	vProcVols(numProcs);
+	SortIntoProcessLists(mg, aaProcs, aaGlobalInd, vProcVrts);
+	SortIntoProcessLists(mg, aaProcs, aaGlobalInd, vProcEdges);
+	SortIntoProcessLists(mg, aaProcs, aaGlobalInd, vProcFaces);
+	SortIntoProcessLists(mg, aaProcs, aaGlobalInd, vProcVols);
+
+	AInt aInt;
+	mg.attach_to_all(aInt);
+	MultiElementAttachmentAccessor<AInt> aaInt(mg, aInt);
+
+//	the header is written again, as soon as all offsets are known
+	int header[2] = {COMBINED_FILE_FORMAT_OFFSET64, numProcs};
+	vector<int64_t> nextOffsets(numProcs, 0);
+	success = (fwrite(header, sizeof(int), 2, f) == 2)
+			&& (fwrite(&nextOffsets.front(), sizeof(int64_t), numProcs, f) == (size_t)numProcs);
+	int64_t offset = 2 * sizeof(int) + numProcs * sizeof(int64_t);
+
+	MGSelector sel(mg);
+	BinaryBuffer buf;
+	for(int p = 0; p < numProcs && success; ++p){
+		sel.clear();
+		sel.select(vProcVrts[p].begin(), vProcVrts[p].end());
+		sel.select(vProcEdges[p].begin(), vProcEdges[p].end());
+		sel.select(vProcFaces[p].begin(), vProcFaces[p].end());
+		sel.select(vProcVols[p].begin(), vProcVols[p].end());
+		GridObjectCollection goc = sel.get_grid_objects();
+
+		buf.clear();
+		Serialize(buf, PARTITIONED_GRID_MAGIC_NUMBER);
+		success = SerializeMultiGridElements(mg, goc, aaInt, buf)
+				&& SerializeSubsetHandler(mg, sh, GridObjectCollection(), buf);
+		if(!success)
+			break;
+
+		WriteSubsetIndicesInSerializationOrder<Vertex>(goc, sh, aaInt, buf);
+		WriteSubsetIndicesInSerializationOrder<Edge>(goc, sh, aaInt, buf);
+		WriteSubsetIndicesInSerializationOrder<Face>(goc, sh, aaInt, buf);
+		WriteSubsetIndicesInSerializationOrder<Volume>(goc, sh, aaInt, buf);
+
+		vector<TPos> vPos(goc.num<Vertex>());
+		for(VertexIterator iter = goc.begin<Vertex>(0); iter != goc.end<Vertex>(0); ++iter)
+			vPos[aaInt[*iter]] = aaPos[*iter];
+		Serialize(buf, vPos);
+
+		WriteSharedElements<Vertex>(goc, aaInt, aaGlobalInd, aaProcs, buf);
+		WriteSharedElements<Edge>(goc, aaInt, aaGlobalInd, aaProcs, buf);
+		WriteSharedElements<Face>(goc, aaInt, aaGlobalInd, aaProcs, buf);
+		WriteSharedElements<Volume>(goc, aaInt, aaGlobalInd, aaProcs, buf);
+		Serialize(buf, PARTITIONED_GRID_MAGIC_NUMBER);
+
+		success = (fwrite(buf.buffer(), sizeof(char), buf.write_pos(), f) == buf.write_pos());
+		offset += buf.write_pos();
+		nextOffsets[p] = offset;
+	}
+
+	success = success && (fseek(f, 2 * sizeof(int), SEEK_SET) == 0)
+			&& (fwrite(&nextOffsets.front(), sizeof(int64_t), numProcs, f) == (size_t)numProcs);
+	fclose(f);
+
+	mg.detach_from_all(aInt);
+	mg.detach_from_all(aGlobalInd);
+	mg.detach_from_all(aProcs);
+
+	if(!success)
+		UG_LOG("ERROR in SavePartitionedGrid: Could not write '" << filename << "'.\n");
+	return success;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+template <class TAPos>
+bool LoadPartitionedGrid(MultiGrid& mg, ISubsetHandler& sh,
+						 const char* filename, TAPos& aPos)
+{
+	PROFILE_FUNC_GROUP("grid");
+	typedef typename TAPos::ValueType	TPos;
+
+	if(mg.num_vertices() > 0){
+		UG_LOG("ERROR in LoadPartitionedGrid: The grid has to be empty.\n");
+		return false;
+	}
+
+	BinaryBuffer buf;
+	ReadPartitionBlock(buf, filename);
+
+	if(Deserialize<int>(buf) != PARTITIONED_GRID_MAGIC_NUMBER){
+		UG_LOG("ERROR in LoadPartitionedGrid: '" << filename << "' is not a "
+				"partitioned grid file.\n");
+		return false;
+	}
+
+//	interfaces are built from the shared elements in the file and must not
+//	be created automatically during element creation
+	GridLayoutMap* pglm = NULL;
+#ifdef UG_PARALLEL
+	DistributedGridManager* pDGM = mg.distributed_grid_manager();
+	if(pDGM){
+		pDGM->enable_interface_management(false);
+		pglm = &pDGM->grid_layout_map();
+	}
+#endif
+
+	vector<Vertex*>	vVrts;
+	vector<Edge*>	vEdges;
+	vector<Face*>	vFaces;
+	vector<Volume*>	vVols;
+
+	bool success = DeserializeMultiGridElements(mg, buf, &vVrts, &vEdges, &vFaces, &vVols)
+				&& DeserializeSubsetHandler(mg, sh, GridObjectCollection(), buf)
+				&& ReadSubsetIndicesInSerializationOrder(sh, vVrts, buf)
+				&& ReadSubsetIndicesInSerializationOrder(sh, vEdges, buf)
+				&& ReadSubsetIndicesInSerializationOrder(sh, vFaces, buf)
+				&& ReadSubsetIndicesInSerializationOrder(sh, vVols, buf);
+
+	if(success){
+		vector<TPos> vPos;
+		Deserialize(buf, vPos);
+		if(vPos.size() == vVrts.size()){
+			if(!mg.has_vertex_attachment(aPos))
+				mg.attach_to_vertices(aPos);
+			Grid::VertexAttachmentAccessor<TAPos> aaPos(mg, aPos);
+			for(size_t i = 0; i < vVrts.size(); ++i)
+				aaPos[vVrts[i]] = vPos[i];
+		}
+		else{
+			UG_LOG("ERROR in LoadPartitionedGrid: Number of positions does "
+					"not match the number of vertices.\n");
+			success = false;
+		}
+	}
+
+	success = success && ReadSharedElements(vVrts, buf, pglm)
+					  && ReadSharedElements(vEdges, buf, pglm)
+					  && ReadSharedElements(vFaces, buf, pglm)
+					  && ReadSharedElements(vVols, buf, pglm);
+
+#ifdef UG_PARALLEL
+	if(pDGM){
+		pDGM->enable_interface_management(true);
+		pDGM->grid_layouts_changed(false);
+	}
+#endif
+
+	if(success && (Deserialize<int>(buf) != PARTITIONED_GRID_MAGIC_NUMBER)){
+		UG_LOG("ERROR in LoadPartitionedGrid: Magic number mismatch after "
+				"deserialization.\n");
+		success = false;
+	}
+
+	return success;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	explicit instantiations
+template bool SavePartitionedGrid<APosition1>(MultiGrid&, ISubsetHandler&, PartitionMap&, const char*, APosition1&);
+template bool SavePartitionedGrid<APosition2>(MultiGrid&, ISubsetHandler&, PartitionMap&, const char*, APosition2&);
+template bool SavePartitionedGrid<APosition>(MultiGrid&, ISubsetHandler&, PartitionMap&, const char*, APosition&);
+
+template bool LoadPartitionedGrid<APosition1>(MultiGrid&, ISubsetHandler&, const char*, APosition1&);
+template bool LoadPartitionedGrid<APosition2>(MultiGrid&, ISubsetHandler&, const char*, APosition2&);
+template bool LoadPartitionedGrid<APosition>(MultiGrid&, ISubsetHandler&, const char*, APosition&);
+
+}//	end of namespace
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_GRID__FILE_IO_PARTITIONED__
+#define __H__LIB_GRID__FILE_IO_PARTITIONED__
+
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/tools/subset_handler_interface.h"
+#include "lib_grid/tools/partition_map.h"
+
+namespace ug
+{
+
+///	Writes the partitions of a serial grid to one file, from which each process loads its own part.
+/**	The grid is split according to the given partition map. For each target
+ * process, the elements of its partitions together with all their sides are
+ * written to a separate block of a combined parallel file (see
+ * pcl::WriteCombinedParallelFile). The block also contains the subset
+ * information, the vertex positions and, for each element which is shared
+ * between several target processes, a global id and the list of processes
+ * which share it.
+ *
+ * The number of blocks equals the highest target process in the partition
+ * map plus one. The file thus has to be loaded on exactly that number of
+ * processes.
+ *
+ * Elements which are not contained in any partition are written to process 0.
+ *
+ * This method is not collective. It has to be called on a process which
+ * holds the whole grid. Only grids with one level are supported.
+ *
+ * Only the given subset handler is written. Further subset handlers and
+ * other attachments of the grid are not contained in the file.
+ */
+template <class TAPos>
+bool SavePartitionedGrid(MultiGrid& mg, ISubsetHandler& sh, PartitionMap& pm,
+						 const char* filename, TAPos& aPos);
+
+///	Loads the part of a grid which was written by SavePartitionedGrid for the local process.
+/**	Each process only reads its own block from the file. No grid data is
+ * sent between processes. In a parallel environment the horizontal interfaces
+ * of the loaded elements are created from the global ids stored in the file.
+ * Master of a shared element is the process with the lowest rank among the
+ * processes which share it.
+ *
+ * This method is collective and has to be called on as many processes as
+ * there are blocks in the file. The given grid has to be empty.
+ */
+template <class TAPos>
+bool LoadPartitionedGrid(MultiGrid& mg, ISubsetHandler& sh,
+						 const char* filename, TAPos& aPos);
+
+}//	end of namespace
+
+#endif
@@ -83,7 +83,8 @@ bool LoadGridFromUGX(Grid& grid, ISubsetHandler& sh,
 ////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////
 //	GridWriterUGX
-GridWriterUGX::GridWriterUGX()
+GridWriterUGX::GridWriterUGX() :
+	m_bBinary(false)
 {
 	xml_node<>* decl = m_doc.allocate_node(node_declaration);
 	decl->append_attribute(m_doc.allocate_attribute("version", "1.0"));
@@ -115,6 +116,22 @@ write_to_file(const char* filename)
 	return false;
 }
 
+rapidxml::xml_node<>* GridWriterUGX::
+create_data_node(const char* name, const UGXDataWriter& data)
+{
+	if(data.empty()){
+	//	return an emtpy node
+		return m_doc.allocate_node(node_element, name);
+	}
+
+	string str = data.str();
+	char* nodeData = m_doc.allocate_string(str.c_str(), str.size() + 1);
+	xml_node<>* node = m_doc.allocate_node(node_element, name, nodeData);
+	if(data.binary())
+		node->append_attribute(m_doc.allocate_attribute("format", "base64"));
+	return node;
+}
+
 void GridWriterUGX::
 add_subset_attributes(rapidxml::xml_node<>* targetNode,
 					  ISubsetHandler& sh, size_t subsetIndex)
@@ -196,8 +213,8 @@ create_subset_element_node(const char* name, const ISubsetHandler& sh,
 							size_t si)
 {
 
-//	the stringstream to which we'll write the data
-	stringstream ss;
+//	collects the data of the node
+	UGXDataWriter ss(m_bBinary);
 
 	if(sh.grid()){
 	//	access the grid
@@ -211,31 +228,21 @@ create_subset_element_node(const char* name, const ISubsetHandler& sh,
 				for(typename geometry_traits<TGeomObj>::iterator iter =
 					goc.begin<TGeomObj>(lvl); iter != goc.end<TGeomObj>(lvl); ++iter)
 				{
-					ss << aaInd[*iter] << " ";
+					ss << aaInd[*iter];
 				}
 			}
 		}
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, name, nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, name);
-	}
+	return create_data_node(name, ss);
 }
 
 template <class TGeomObj>
 rapidxml::xml_node<>* GridWriterUGX::
 create_selector_element_node(const char* name, const ISelector& sel)
 {
-//	the stringstream to which we'll write the data
-	stringstream ss;
+//	collects the data of the node
+	UGXDataWriter ss(m_bBinary);
 
 	if(sel.grid()){
 	//	access the grid
@@ -249,23 +256,13 @@ create_selector_element_node(const char* name, const ISelector& sel)
 				for(typename geometry_traits<TGeomObj>::iterator iter =
 					goc.begin<TGeomObj>(lvl); iter != goc.end<TGeomObj>(lvl); ++iter)
 				{
-					ss << aaInd[*iter] << " " << (int)sel.get_selection_status(*iter) << " ";
+					ss << aaInd[*iter] << (int)sel.get_selection_status(*iter);
 				}
 			}
 		}
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, name, nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, name);
-	}
+	return create_data_node(name, ss);
 }
 
 void GridWriterUGX::
@@ -514,23 +511,13 @@ create_edge_node(RegularEdgeIterator edgesBegin,
 				 AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(RegularEdgeIterator iter = edgesBegin; iter != edgesEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " ";
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "edges", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "edges");
-	}
+	return create_data_node("edges", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -539,23 +526,13 @@ create_constraining_edge_node(ConstrainingEdgeIterator edgesBegin,
 							  AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(ConstrainingEdgeIterator iter = edgesBegin; iter != edgesEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " ";
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "constraining_edges", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "constraining_edges");
-	}
+	return create_data_node("constraining_edges", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -566,11 +543,11 @@ create_constrained_edge_node(ConstrainedEdgeIterator edgesBegin,
 							 AAFaceIndex aaIndFACE)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(ConstrainedEdgeIterator iter = edgesBegin; iter != edgesEnd; ++iter)
 	{
 	//	write endpoint indices
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " ";
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)];
 
 	//	write index of associated constraining element
 	//	codes:	-1: no constraining element
@@ -581,24 +558,14 @@ create_constrained_edge_node(ConstrainedEdgeIterator edgesBegin,
 		Edge* ce = dynamic_cast<Edge*>((*iter)->get_constraining_object());
 		Face* cf = dynamic_cast<Face*>((*iter)->get_constraining_object());
 		if(ce)
-			ss << "1 " << aaIndEDGE[ce] << " ";
+			ss << 1 << aaIndEDGE[ce];
 		else if(cf)
-			ss << "2 " << aaIndFACE[cf] << " ";
+			ss << 2 << aaIndFACE[cf];
 		else
-			ss << "-1 ";
+			ss << -1;
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "constrained_edges", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "constrained_edges");
-	}
+	return create_data_node("constrained_edges", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -607,24 +574,14 @@ create_triangle_node(TriangleIterator trisBegin,
 				 	 AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(TriangleIterator iter = trisBegin; iter != trisEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)]
-			<< " " << aaIndVRT[(*iter)->vertex(2)] << " " ;
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "triangles", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "triangles");
-	}
+	return create_data_node("triangles", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -633,24 +590,14 @@ create_constraining_triangle_node(ConstrainingTriangleIterator trisBegin,
 								  AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(ConstrainingTriangleIterator iter = trisBegin; iter != trisEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)]
-			<< " " << aaIndVRT[(*iter)->vertex(2)] << " " ;
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "constraining_triangles", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "constraining_triangles");
-	}
+	return create_data_node("constraining_triangles", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -660,12 +607,12 @@ create_constrained_triangle_node(ConstrainedTriangleIterator trisBegin,
 								 AAFaceIndex aaIndFACE)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(ConstrainedTriangleIterator iter = trisBegin; iter != trisEnd; ++iter)
 	{
 	//	write endpoint indices
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)]
-			<< " " << aaIndVRT[(*iter)->vertex(2)] << " " ;
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)];
 	//	write index of associated constraining element
 	//	codes:	-1: no constraining element
 	//			0: vertex. index follows
@@ -674,22 +621,12 @@ create_constrained_triangle_node(ConstrainedTriangleIterator trisBegin,
 	//			3: volume. index follows
 		Face* cf = dynamic_cast<Face*>((*iter)->get_constraining_object());
 		if(cf)
-			ss << "2 " << aaIndFACE[cf] << " ";
+			ss << 2 << aaIndFACE[cf];
 		else
-			ss << "-1 ";
+			ss << -1;
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "constrained_triangles", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "constrained_triangles");
-	}
+	return create_data_node("constrained_triangles", ss);
 }
 
 
@@ -699,24 +636,14 @@ create_quadrilateral_node(QuadrilateralIterator quadsBegin,
 						  AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(QuadrilateralIterator iter = quadsBegin; iter != quadsEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " "
-			<< aaIndVRT[(*iter)->vertex(2)] << " " << aaIndVRT[(*iter)->vertex(3)] << " " ;
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)] << aaIndVRT[(*iter)->vertex(3)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "quadrilaterals", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "quadrilaterals");
-	}
+	return create_data_node("quadrilaterals", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -725,24 +652,14 @@ create_constraining_quadrilateral_node(ConstrainingQuadrilateralIterator quadsBe
 									   AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(ConstrainingQuadrilateralIterator iter = quadsBegin; iter != quadsEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " "
-			<< aaIndVRT[(*iter)->vertex(2)] << " " << aaIndVRT[(*iter)->vertex(3)] << " " ;
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)] << aaIndVRT[(*iter)->vertex(3)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "constraining_quadrilaterals", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "constraining_quadrilaterals");
-	}
+	return create_data_node("constraining_quadrilaterals", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -752,11 +669,11 @@ create_constrained_quadrilateral_node(ConstrainedQuadrilateralIterator quadsBegi
 									  AAFaceIndex aaIndFACE)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(ConstrainedQuadrilateralIterator iter = quadsBegin; iter != quadsEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " "
-			<< aaIndVRT[(*iter)->vertex(2)] << " " << aaIndVRT[(*iter)->vertex(3)] << " " ;
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)] << aaIndVRT[(*iter)->vertex(3)];
 	//	write index of associated constraining element
 	//	codes:	-1: no constraining element
 	//			0: vertex. index follows
@@ -765,22 +682,12 @@ create_constrained_quadrilateral_node(ConstrainedQuadrilateralIterator quadsBegi
 	//			3: volume. index follows
 		Face* cf = dynamic_cast<Face*>((*iter)->get_constraining_object());
 		if(cf)
-			ss << "2 " << aaIndFACE[cf] << " ";
+			ss << 2 << aaIndFACE[cf];
 		else
-			ss << "-1 ";
+			ss << -1;
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "constrained_quadrilaterals", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "constrained_quadrilaterals");
-	}
+	return create_data_node("constrained_quadrilaterals", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -789,24 +696,14 @@ create_tetrahedron_node(TetrahedronIterator tetsBegin,
 						  AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(TetrahedronIterator iter = tetsBegin; iter != tetsEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " "
-			<< aaIndVRT[(*iter)->vertex(2)] << " " << aaIndVRT[(*iter)->vertex(3)] << " " ;
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)] << aaIndVRT[(*iter)->vertex(3)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "tetrahedrons", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "tetrahedrons");
-	}
+	return create_data_node("tetrahedrons", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -815,26 +712,16 @@ create_hexahedron_node(HexahedronIterator hexasBegin,
 						  AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(HexahedronIterator iter = hexasBegin; iter != hexasEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " "
-			<< aaIndVRT[(*iter)->vertex(2)] << " " << aaIndVRT[(*iter)->vertex(3)] << " "
-			<< aaIndVRT[(*iter)->vertex(4)] << " " << aaIndVRT[(*iter)->vertex(5)] << " "
-			<< aaIndVRT[(*iter)->vertex(6)] << " " << aaIndVRT[(*iter)->vertex(7)] << " ";
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)] << aaIndVRT[(*iter)->vertex(3)]
+			<< aaIndVRT[(*iter)->vertex(4)] << aaIndVRT[(*iter)->vertex(5)]
+			<< aaIndVRT[(*iter)->vertex(6)] << aaIndVRT[(*iter)->vertex(7)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "hexahedrons", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "hexahedrons");
-	}
+	return create_data_node("hexahedrons", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -843,25 +730,15 @@ create_prism_node(PrismIterator prismsBegin,
 					AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(PrismIterator iter = prismsBegin; iter != prismsEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " "
-			<< aaIndVRT[(*iter)->vertex(2)] << " " << aaIndVRT[(*iter)->vertex(3)] << " "
-			<< aaIndVRT[(*iter)->vertex(4)] << " " << aaIndVRT[(*iter)->vertex(5)] << " ";
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)] << aaIndVRT[(*iter)->vertex(3)]
+			<< aaIndVRT[(*iter)->vertex(4)] << aaIndVRT[(*iter)->vertex(5)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "prisms", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "prisms");
-	}
+	return create_data_node("prisms", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -870,25 +747,15 @@ create_pyramid_node(PyramidIterator pyrasBegin,
 					AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(PyramidIterator iter = pyrasBegin; iter != pyrasEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " "
-			<< aaIndVRT[(*iter)->vertex(2)] << " " << aaIndVRT[(*iter)->vertex(3)] << " "
-			<< aaIndVRT[(*iter)->vertex(4)] << " ";
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)] << aaIndVRT[(*iter)->vertex(3)]
+			<< aaIndVRT[(*iter)->vertex(4)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "pyramids", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "pyramids");
-	}
+	return create_data_node("pyramids", ss);
 }
 
 rapidxml::xml_node<>* GridWriterUGX::
@@ -897,25 +764,15 @@ create_octahedron_node(OctahedronIterator octsBegin,
 						AAVrtIndex aaIndVRT)
 {
 //	write the elements to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(OctahedronIterator iter = octsBegin; iter != octsEnd; ++iter)
 	{
-		ss << aaIndVRT[(*iter)->vertex(0)] << " " << aaIndVRT[(*iter)->vertex(1)] << " "
-			<< aaIndVRT[(*iter)->vertex(2)] << " " << aaIndVRT[(*iter)->vertex(3)] << " "
-			<< aaIndVRT[(*iter)->vertex(4)] << " " << aaIndVRT[(*iter)->vertex(5)] << " ";
+		ss << aaIndVRT[(*iter)->vertex(0)] << aaIndVRT[(*iter)->vertex(1)]
+			<< aaIndVRT[(*iter)->vertex(2)] << aaIndVRT[(*iter)->vertex(3)]
+			<< aaIndVRT[(*iter)->vertex(4)] << aaIndVRT[(*iter)->vertex(5)];
 	}
 
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create and return the node
-		return m_doc.allocate_node(node_element, "octahedrons", nodeData);
-	}
-	else{
-	//	return an emtpy node
-		return m_doc.allocate_node(node_element, "octahedrons");
-	}
+	return create_data_node("octahedrons", ss);
 }
 
 
@@ -1053,7 +910,7 @@ read_subset_handler_elements(ISubsetHandler& shOut,
 	while(elemNode)
 	{
 	//	read the indices
-		stringstream ss(elemNode->value(), ios_base::in);
+		UGXDataReader ss(m_parser, elemNode);
 
 		size_t index;
 		while(!ss.eof()){
@@ -1159,7 +1016,7 @@ read_selector_elements(ISelector& selOut, const char* elemNodeName,
 	while(elemNode)
 	{
 	//	read the indices
-		stringstream ss(elemNode->value(), ios_base::in);
+		UGXDataReader ss(m_parser, elemNode);
 
 		size_t index;
 		int state;
@@ -1246,9 +1103,8 @@ read_projector(xml_node<>* projNode)
 		try {
 			SPRefinementProjector proj = projFac.create(attribType->value());
 
-			string str(projNode->value(), projNode->value_size());
-			stringstream ss(str, ios_base::in);
-			boost::archive::text_iarchive ar(ss, boost::archive::no_header);
+			UGXDataReader in(m_parser, projNode);
+			boost::archive::text_iarchive ar(in.stream(), boost::archive::no_header);
 			archivar.archive(ar, *proj);
 			return proj;
 		}
@@ -1301,28 +1157,10 @@ projection_handler(ProjectionHandler& phOut, size_t phIndex, size_t refGridIndex
 bool GridReaderUGX::
 parse_file(const char* filename)
 {
-	ifstream in(filename, ios::binary);
-	if(!in)
+//	parse the xml-data. Large data blocks remain in the file.
+	if(!m_parser.parse_file(m_doc, filename))
 		return false;
 
-//	get the length of the file
-	streampos posStart = in.tellg();
-	in.seekg(0, ios_base::end);
-	streampos posEnd = in.tellg();
-	streamsize size = posEnd - posStart;
-
-//	go back to the start of the file
-	in.seekg(posStart);
-
-//	read the whole file en-block and terminate it with 0
-	char* fileContent = m_doc.allocate_string(0, size + 1);
-	in.read(fileContent, size);
-	fileContent[size] = 0;
-	in.close();
-
-//	parse the xml-data
-	m_doc.parse<0>(fileContent);
-
 //	notify derived classes that a new document has been parsed.
 	return new_document_parsed();
 }
@@ -1371,9 +1209,8 @@ create_edges(std::vector<Edge*>& edgesOut,
 			Grid& grid, rapidxml::xml_node<>* node,
 			std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the edges
 	int i1, i2;
@@ -1407,9 +1244,8 @@ create_constraining_edges(std::vector<Edge*>& edgesOut,
 						  Grid& grid, rapidxml::xml_node<>* node,
 			 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the edges
 	int i1, i2;
@@ -1443,9 +1279,8 @@ create_constrained_edges(std::vector<Edge*>& edgesOut,
 						  Grid& grid, rapidxml::xml_node<>* node,
 			 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the edges
 	int i1, i2;
@@ -1489,9 +1324,8 @@ create_triangles(std::vector<Face*>& facesOut,
 				  Grid& grid, rapidxml::xml_node<>* node,
 				  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1526,9 +1360,8 @@ create_constraining_triangles(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1564,9 +1397,8 @@ create_constrained_triangles(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1611,9 +1443,8 @@ create_quadrilaterals(std::vector<Face*>& facesOut,
 					   Grid& grid, rapidxml::xml_node<>* node,
 					   std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1650,9 +1481,8 @@ create_constraining_quadrilaterals(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1691,9 +1521,8 @@ create_constrained_quadrilaterals(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1742,9 +1571,8 @@ create_tetrahedrons(std::vector<Volume*>& volsOut,
 					 Grid& grid, rapidxml::xml_node<>* node,
 					 std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the tetrahedrons
 	int i1, i2, i3, i4;
@@ -1781,9 +1609,8 @@ create_hexahedrons(std::vector<Volume*>& volsOut,
 					Grid& grid, rapidxml::xml_node<>* node,
 					std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5, i6, i7, i8;
@@ -1824,9 +1651,8 @@ create_prisms(std::vector<Volume*>& volsOut,
 			  Grid& grid, rapidxml::xml_node<>* node,
 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5, i6;
@@ -1865,9 +1691,8 @@ create_pyramids(std::vector<Volume*>& volsOut,
 				Grid& grid, rapidxml::xml_node<>* node,
 				std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5;
@@ -1905,9 +1730,8 @@ create_octahedrons(std::vector<Volume*>& volsOut,
 					Grid& grid, rapidxml::xml_node<>* node,
 					std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, node);
 
 //	read the octahedrons
 	int i1, i2, i3, i4, i5, i6;
@@ -1950,28 +1774,11 @@ UGXFileInfo::UGXFileInfo() :
 bool UGXFileInfo::parse_file(const char* filename)
 {
 	PROFILE_FUNC_GROUP("UGXFileInfo");
-	ifstream in(filename, ios::binary);
-	if(!in)
-		return false;
-
-//	get the length of the file
-	streampos posStart = in.tellg();
-	in.seekg(0, ios_base::end);
-	streampos posEnd = in.tellg();
-	streamsize size = posEnd - posStart;
-
-//	go back to the start of the file
-	in.seekg(posStart);
-
-//	read the whole file en-block and terminate it with 0
+//	parse the xml-structure. Large data blocks remain in the file.
 	rapidxml::xml_document<> doc;
-	char* fileContent = doc.allocate_string(0, size + 1);
-	in.read(fileContent, size);
-	fileContent[size] = 0;
-	in.close();
-
-//	parse the xml-data
-	doc.parse<0>(fileContent);
+	UGXFileParser parser;
+	if(!parser.parse_file(doc, filename))
+		return false;
 
 	xml_node<>* curNode = doc.first_node("grid");
 	while(curNode){
@@ -2005,7 +1812,7 @@ bool UGXFileInfo::parse_file(const char* filename)
 		{
 			// create a bounding box around the vertices contained in this xml node
 			AABox<vector3> newBox;
-			bool validBox = calculate_vertex_node_bbox(vrtNode, newBox);
+			bool validBox = calculate_vertex_node_bbox(parser, vrtNode, newBox);
 		    if (validBox)
 		    	box = AABox<vector3>(box, newBox);
 
@@ -2181,7 +1988,9 @@ UGXFileInfo::subset_info(size_t gridInd, size_t shInd, size_t subsetInd) const
 }
 
 bool
-UGXFileInfo::calculate_vertex_node_bbox(rapidxml::xml_node<>* vrtNode, AABox<vector3>& bb) const
+UGXFileInfo::calculate_vertex_node_bbox(const UGXFileParser& parser,
+										rapidxml::xml_node<>* vrtNode,
+										AABox<vector3>& bb) const
 {
 	size_t numSrcCoords = 0;
 	rapidxml::xml_attribute<>* attrib = vrtNode->first_attribute("coords");
@@ -2196,9 +2005,8 @@ UGXFileInfo::calculate_vertex_node_bbox(rapidxml::xml_node<>* vrtNode, AABox<vec
 	if (numSrcCoords > 3)
 		return false;
 
-//	create a buffer with which we can access the data
-	std::string str(vrtNode->value(), vrtNode->value_size());
-	std::stringstream ss(str, std::ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(parser, vrtNode);
 
 	AABox<vector3> box(vector3(0, 0, 0), vector3(0, 0, 0));
 	vector3 min(0, 0, 0);
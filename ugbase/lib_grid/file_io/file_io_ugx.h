@@ -48,6 +48,7 @@
 #include "lib_grid/grid_objects/grid_objects.h"
 #include "lib_grid/refinement/projectors/refinement_projector.h"
 #include "common/math/misc/shapes.h"	// AABox
+#include "file_io_ugx_data.h"
 
 namespace ug
 {
@@ -134,6 +135,12 @@ class GridWriterUGX
 							const char* name,
 							size_t refGridIndex);
 
+	///	enables binary output of vertices, elements, subsets and selectors.
+	/**	The data is stored base64 encoded in the xml nodes. This reduces
+	 *	the file size and avoids the conversion of ascii numbers during
+	 *	loading. Default is false. Has to be set before the grid is added.*/
+		void set_binary(bool binary)	{m_bBinary = binary;}
+
 		virtual bool write_to_stream(std::ostream& out);
 
 		bool write_to_file(const char* filename);
@@ -146,6 +153,10 @@ class GridWriterUGX
 
 	protected:
 		void init_grid_attachments(Grid& grid);
+
+	///	creates a node with the given name, which holds the given data
+		rapidxml::xml_node<>*
+		create_data_node(const char* name, const UGXDataWriter& data);
 		
 	//	VERTICES
 		template <class TAAPos>
@@ -287,6 +298,9 @@ class GridWriterUGX
 
 	///	attached to vertices of each grid during add_grid.
 		AInt	m_aInt;
+
+	///	write vertices, elements, subsets and selectors as binary data
+		bool	m_bBinary;
 };
 
 
@@ -304,8 +318,14 @@ class GridReaderUGX
 		virtual ~GridReaderUGX();
 
 	///	parses an xml file
+	/**	Large data blocks remain in the file and are read block by block
+	 *	during the creation of the grid (see UGXFileParser).*/
 		bool parse_file(const char* filename);
 
+	///	data blocks larger than the given size (in bytes) are not loaded during parse_file.
+	/**	A threshold of 0 loads the whole file into memory. Default is 64 KiB.*/
+		void set_block_threshold(size_t size)	{m_parser.set_block_threshold(size);}
+
 	///	returns the number of grids
 		inline size_t num_grids() const	{return m_entries.size();}
 
@@ -489,6 +509,9 @@ class GridReaderUGX
 	///	the xml_document which stores the data
 		rapidxml::xml_document<> m_doc;
 
+	///	parses files and gives access to data blocks which remained in the file
+		UGXFileParser	m_parser;
+
 	///	holds grids which already have been created
 		std::vector<GridEntry>	m_entries;
 };
@@ -600,12 +623,15 @@ class UGXFileInfo{
 	/// calculates the bounding box of a group of vertices
 	/**
 	 *
+	 * @param[in] parser	the parser with which the file was read
 	 * @param[in] vrtNode	node in the xml file (containing vertex information)
 	 * @param[out] bb		output bounding box
 	 *
 	 * @return true iff at least one valid (coordinate dimension in {0,1,2,3}) vertex is contained
 	 */
-		bool calculate_vertex_node_bbox(rapidxml::xml_node<>* vrtNode, AABox<vector3>& bb) const;
+		bool calculate_vertex_node_bbox(const UGXFileParser& parser,
+										rapidxml::xml_node<>* vrtNode,
+										AABox<vector3>& bb) const;
 };
 
 }//	end of namespace
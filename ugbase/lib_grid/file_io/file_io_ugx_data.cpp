@@ -0,0 +1,543 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include "file_io_ugx_data.h"
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+
+using namespace std;
+using namespace rapidxml;
+
+namespace ug
+{
+
+///	node values which were left in the file start with this prefix
+static const char* UGX_BLOCK_PREFIX = "@ugx_data:";
+
+///	size of the chunks in which files and base64 data are processed
+static const size_t UGX_CHUNK_SIZE = 1 << 20;
+
+static const char* BASE64_CHARS =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+///	returns the 6 bit value of a base64 character or -1 for other characters
+static inline int Base64Value(char c)
+{
+	if(c >= 'A' && c <= 'Z') return c - 'A';
+	if(c >= 'a' && c <= 'z') return c - 'a' + 26;
+	if(c >= '0' && c <= '9') return c - '0' + 52;
+	if(c == '+') return 62;
+	if(c == '/') return 63;
+	return -1;
+}
+
+static string EncodeBase64(const vector<char>& data)
+{
+	string str;
+	str.reserve(((data.size() + 2) / 3) * 4);
+
+	const unsigned char* p = (const unsigned char*)(data.empty() ? NULL : &data[0]);
+	size_t i = 0;
+	for(; i + 2 < data.size(); i += 3){
+		unsigned long bits = (p[i] << 16) | (p[i+1] << 8) | p[i+2];
+		str += BASE64_CHARS[(bits >> 18) & 63];
+		str += BASE64_CHARS[(bits >> 12) & 63];
+		str += BASE64_CHARS[(bits >> 6) & 63];
+		str += BASE64_CHARS[bits & 63];
+	}
+
+	size_t rest = data.size() - i;
+	if(rest > 0){
+		unsigned long bits = p[i] << 16;
+		if(rest == 2) bits |= p[i+1] << 8;
+		str += BASE64_CHARS[(bits >> 18) & 63];
+		str += BASE64_CHARS[(bits >> 12) & 63];
+		str += (rest == 2) ? BASE64_CHARS[(bits >> 6) & 63] : '=';
+		str += '=';
+	}
+	return str;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	UGXDataWriter
+UGXDataWriter::
+UGXDataWriter(bool binary) :
+	m_bBinary(binary),
+	m_numValues(0)
+{
+}
+
+UGXDataWriter& UGXDataWriter::
+operator<<(int val)
+{
+	if(m_bBinary){
+		const char* p = (const char*)&val;
+		m_vData.insert(m_vData.end(), p, p + sizeof(int));
+	}
+	else
+		m_ss << val << " ";
+	++m_numValues;
+	return *this;
+}
+
+UGXDataWriter& UGXDataWriter::
+operator<<(double val)
+{
+	if(m_bBinary){
+		const char* p = (const char*)&val;
+		m_vData.insert(m_vData.end(), p, p + sizeof(double));
+	}
+	else
+		m_ss << val << " ";
+	++m_numValues;
+	return *this;
+}
+
+bool UGXDataWriter::
+empty() const
+{
+	return m_numValues == 0;
+}
+
+string UGXDataWriter::
+str() const
+{
+	if(m_bBinary)
+		return EncodeBase64(m_vData);
+
+//	erase the trailing ' '
+	string s = m_ss.str();
+	if(!s.empty())
+		s.resize(s.size() - 1);
+	return s;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///	provides the value of a ugx-node either from memory or from a file
+/**	base64 encoded data is decoded on the fly.*/
+class UGXNodeDataBuf : public std::streambuf
+{
+	public:
+		UGXNodeDataBuf(const char* data, size_t size, bool base64) :
+			m_pData(data), m_dataSize(size), m_dataPos(0),
+			m_bFile(false), m_fileRemaining(0),
+			m_bBase64(base64), m_bits(0), m_numBits(0)
+		{}
+
+		UGXNodeDataBuf(const char* filename, streamoff offset, streamsize size,
+					   bool base64) :
+			m_pData(NULL), m_dataSize(0), m_dataPos(0),
+			m_bFile(true), m_fileRemaining(size),
+			m_bBase64(base64), m_bits(0), m_numBits(0)
+		{
+			m_file.open(filename, ios::binary);
+			UG_COND_THROW(!m_file, "UGXDataReader: Couldn't open file " << filename);
+			m_file.seekg(offset);
+		}
+
+	protected:
+		virtual int_type underflow()
+		{
+			if(gptr() < egptr())
+				return traits_type::to_int_type(*gptr());
+
+			const char* chunk;
+			size_t size;
+			while(next_chunk(chunk, size)){
+				if(!m_bBase64){
+					char* p = const_cast<char*>(chunk);
+					setg(p, p, p + size);
+					return traits_type::to_int_type(*p);
+				}
+
+				size_t num = decode(chunk, size);
+				if(num > 0){
+					setg(&m_vDecoded[0], &m_vDecoded[0], &m_vDecoded[0] + num);
+					return traits_type::to_int_type(m_vDecoded[0]);
+				}
+			}
+			return traits_type::eof();
+		}
+
+	private:
+	///	returns the next chunk of raw data or false if all data was processed
+		bool next_chunk(const char*& chunkOut, size_t& sizeOut)
+		{
+			if(m_bFile){
+				if(m_fileRemaining <= 0)
+					return false;
+				m_vRaw.resize(min<streamsize>(UGX_CHUNK_SIZE, m_fileRemaining));
+				m_file.read(&m_vRaw[0], m_vRaw.size());
+				streamsize num = m_file.gcount();
+				if(num <= 0)
+					return false;
+				m_fileRemaining -= num;
+				chunkOut = &m_vRaw[0];
+				sizeOut = (size_t)num;
+				return true;
+			}
+
+			if(m_dataPos >= m_dataSize)
+				return false;
+		//	ascii data in memory can be handed out directly
+			sizeOut = m_dataSize - m_dataPos;
+			if(m_bBase64)
+				sizeOut = min(sizeOut, UGX_CHUNK_SIZE);
+			chunkOut = m_pData + m_dataPos;
+			m_dataPos += sizeOut;
+			return true;
+		}
+
+	///	decodes base64 characters to m_vDecoded. Returns the number of decoded bytes.
+	/**	Bits which do not yet form a full byte are kept for the next chunk.
+	 *	Whitespace and padding characters are ignored.*/
+		size_t decode(const char* chunk, size_t size)
+		{
+			m_vDecoded.resize(size / 4 * 3 + 3);
+			size_t num = 0;
+			for(size_t i = 0; i < size; ++i){
+				int v = Base64Value(chunk[i]);
+				if(v < 0)
+					continue;
+				m_bits = (m_bits << 6) | (unsigned long)v;
+				m_numBits += 6;
+				if(m_numBits >= 8){
+					m_numBits -= 8;
+					m_vDecoded[num++] = (char)((m_bits >> m_numBits) & 0xFF);
+					m_bits &= (1UL << m_numBits) - 1;
+				}
+			}
+			return num;
+		}
+
+	private:
+		const char*		m_pData;
+		size_t			m_dataSize;
+		size_t			m_dataPos;
+
+		bool			m_bFile;
+		ifstream		m_file;
+		streamsize		m_fileRemaining;
+		vector<char>	m_vRaw;
+
+		bool			m_bBase64;
+		unsigned long	m_bits;
+		int				m_numBits;
+		vector<char>	m_vDecoded;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+//	UGXFileParser
+UGXFileParser::
+UGXFileParser() :
+	m_blockThreshold(64 * 1024)
+{
+}
+
+bool UGXFileParser::
+parse_file(rapidxml::xml_document<>& doc, const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	m_filename = filename;
+	m_vBlocks.clear();
+
+	if(m_blockThreshold == 0)
+		return parse_in_memory(doc, filename);
+	return parse_skeleton(doc, filename);
+}
+
+bool UGXFileParser::
+parse_in_memory(rapidxml::xml_document<>& doc, const char* filename)
+{
+	m_vBlocks.clear();
+
+	ifstream in(filename, ios::binary);
+	if(!in)
+		return false;
+
+//	get the length of the file
+	streampos posStart = in.tellg();
+	in.seekg(0, ios_base::end);
+	streampos posEnd = in.tellg();
+	streamsize size = posEnd - posStart;
+
+//	go back to the start of the file
+	in.seekg(posStart);
+
+//	read the whole file en-block and terminate it with 0
+	char* fileContent = doc.allocate_string(0, size + 1);
+	in.read(fileContent, size);
+	fileContent[size] = 0;
+	in.close();
+
+//	parse the xml-data
+	doc.parse<0>(fileContent);
+	return true;
+}
+
+bool UGXFileParser::
+parse_skeleton(rapidxml::xml_document<>& doc, const char* filename)
+{
+	ifstream in(filename, ios::binary);
+	if(!in)
+		return false;
+
+	enum State{TEXT, TAG, COMMENT, CDATA};
+	State state = TEXT;
+
+//	the file content without large character data
+	string skeleton;
+	size_t tagStart = 0;
+	char quote = 0;
+	int bracketDepth = 0;
+
+//	the current character data. At most m_blockThreshold characters are kept.
+	string text;
+	streamoff textStart = 0;
+	streamsize textSize = 0;
+	bool textHasEntity = false;
+
+	vector<char> buf(UGX_CHUNK_SIZE);
+	streamoff pos = 0;
+	bool eof = false;
+	while(!eof){
+		in.read(&buf[0], buf.size());
+		streamsize num = in.gcount();
+		if(num <= 0){
+		//	terminate the last character data
+			eof = true;
+			if(state != TEXT)
+				break;
+			num = 1;
+			buf[0] = '<';
+		}
+
+		for(streamsize i = 0; i < num; ++i, ++pos){
+			const char c = buf[i];
+			switch(state){
+				case TEXT:
+					if(c != '<'){
+						if(textSize == 0)
+							textStart = pos;
+						if((size_t)textSize < m_blockThreshold)
+							text += c;
+						if(c == '&')
+							textHasEntity = true;
+						++textSize;
+						break;
+					}
+
+				//	the character data ends. Large blocks remain in the file.
+					if((size_t)textSize <= m_blockThreshold)
+						skeleton += text;
+					else{
+						if(textHasEntity)
+							return parse_in_memory(doc, filename);
+						stringstream ss;
+						ss << UGX_BLOCK_PREFIX << m_vBlocks.size();
+						skeleton += ss.str();
+						m_vBlocks.push_back(make_pair(textStart, textSize));
+					}
+					text.clear();
+					textSize = 0;
+					textHasEntity = false;
+
+					if(eof)
+						break;
+
+					tagStart = skeleton.size();
+					skeleton += c;
+					quote = 0;
+					bracketDepth = 0;
+					state = TAG;
+					break;
+
+				case TAG:
+				{
+					skeleton += c;
+					const size_t tagLen = skeleton.size() - tagStart;
+					if(tagLen == 4 && skeleton.compare(tagStart, 4, "<!--") == 0){
+						state = COMMENT;
+						break;
+					}
+					if(tagLen == 9 && skeleton.compare(tagStart, 9, "<![CDATA[") == 0){
+						state = CDATA;
+						break;
+					}
+
+					if(quote){
+						if(c == quote)
+							quote = 0;
+					}
+					else if(c == '"' || c == '\'')
+						quote = c;
+					else if(c == '[')
+						++bracketDepth;
+					else if(c == ']')
+						--bracketDepth;
+					else if(c == '>' && bracketDepth <= 0)
+						state = TEXT;
+				}break;
+
+				case COMMENT:
+					skeleton += c;
+					if(c == '>' && skeleton.size() - tagStart >= 7
+					   && skeleton.compare(skeleton.size() - 3, 3, "-->") == 0)
+						state = TEXT;
+					break;
+
+				case CDATA:
+					skeleton += c;
+					if(c == '>' && skeleton.compare(skeleton.size() - 3, 3, "]]>") == 0)
+						state = TEXT;
+					break;
+			}
+		}
+	}
+	in.close();
+
+//	parse the xml-structure
+	char* content = doc.allocate_string(0, skeleton.size() + 1);
+	memcpy(content, skeleton.c_str(), skeleton.size());
+	content[skeleton.size()] = 0;
+	doc.parse<0>(content);
+	return true;
+}
+
+bool UGXFileParser::
+external_block(rapidxml::xml_node<>* node, std::streamoff& offsetOut,
+			   std::streamsize& sizeOut) const
+{
+	if(m_vBlocks.empty())
+		return false;
+
+	const size_t prefixLen = strlen(UGX_BLOCK_PREFIX);
+	if(node->value_size() <= prefixLen
+	   || strncmp(node->value(), UGX_BLOCK_PREFIX, prefixLen) != 0)
+		return false;
+
+	size_t index = strtoul(node->value() + prefixLen, NULL, 10);
+	UG_COND_THROW(index >= m_vBlocks.size(),
+				  "UGXFileParser: Invalid data block index " << index);
+
+	offsetOut = m_vBlocks[index].first;
+	sizeOut = m_vBlocks[index].second;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	UGXDataReader
+UGXDataReader::
+UGXDataReader(const UGXFileParser& parser, rapidxml::xml_node<>* node) :
+	m_pBuf(NULL),
+	m_in(NULL),
+	m_bBinary(false)
+{
+	xml_attribute<>* attrib = node->first_attribute("format");
+	if(attrib){
+		UG_COND_THROW(strcmp(attrib->value(), "base64") != 0,
+					  "UGXDataReader: Unknown data format '" << attrib->value()
+					  << "' in node '" << node->name() << "'");
+		m_bBinary = true;
+	}
+
+	streamoff offset;
+	streamsize size;
+	if(parser.external_block(node, offset, size))
+		m_pBuf = new UGXNodeDataBuf(parser.filename().c_str(), offset, size, m_bBinary);
+	else
+		m_pBuf = new UGXNodeDataBuf(node->value(), node->value_size(), m_bBinary);
+
+	m_in.rdbuf(m_pBuf);
+}
+
+UGXDataReader::
+~UGXDataReader()
+{
+	m_in.rdbuf(NULL);
+	delete m_pBuf;
+}
+
+UGXDataReader& UGXDataReader::
+operator>>(int& val)
+{
+	if(m_bBinary)
+		m_in.read((char*)&val, sizeof(int));
+	else
+		m_in >> val;
+	return *this;
+}
+
+UGXDataReader& UGXDataReader::
+operator>>(size_t& val)
+{
+	if(m_bBinary){
+		int i;
+		m_in.read((char*)&i, sizeof(int));
+		val = (size_t)i;
+	}
+	else
+		m_in >> val;
+	return *this;
+}
+
+UGXDataReader& UGXDataReader::
+operator>>(float& val)
+{
+	if(m_bBinary){
+		double d;
+		m_in.read((char*)&d, sizeof(double));
+		val = (float)d;
+	}
+	else
+		m_in >> val;
+	return *this;
+}
+
+UGXDataReader& UGXDataReader::
+operator>>(double& val)
+{
+	if(m_bBinary)
+		m_in.read((char*)&val, sizeof(double));
+	else
+		m_in >> val;
+	return *this;
+}
+
+}//	end of namespace
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_GRID__FILE_IO_UGX_DATA__
+#define __H__LIB_GRID__FILE_IO_UGX_DATA__
+
+#include <istream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include "common/parser/rapidxml/rapidxml.hpp"
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+///	Collects the values of a ugx-node either as ascii text or as binary data
+/**	Binary data is stored base64 encoded in the value of the node, using the
+ *	native byte order. Integers are stored as 32 bit values, numbers as 64 bit
+ *	floating point values. Nodes which contain binary data carry the attribute
+ *	format="base64".*/
+class UGXDataWriter
+{
+	public:
+		UGXDataWriter(bool binary);
+
+		UGXDataWriter& operator<<(int val);
+		UGXDataWriter& operator<<(double val);
+
+		inline bool binary() const	{return m_bBinary;}
+
+	///	precision of numbers written as ascii text
+		inline void precision(std::streamsize p)	{m_ss.precision(p);}
+
+	///	returns true if no values were written
+		bool empty() const;
+
+	///	returns the ascii text or the base64 encoded binary data
+		std::string str() const;
+
+	private:
+		bool				m_bBinary;
+		size_t				m_numValues;
+		std::stringstream	m_ss;
+		std::vector<char>	m_vData;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+///	Parses the xml structure of ugx files while leaving large data blocks in the file
+/**	Character data exceeding the block threshold is not copied to the xml
+ *	document. Instead the value of the enclosing node refers to the position
+ *	of the data in the file. A UGXDataReader reads such values block by block,
+ *	so that the memory required to load a grid does not depend on the size of
+ *	the file but only on the size of its xml structure.
+ *
+ *	If a skipped block contains xml entities, the whole file is parsed in
+ *	memory instead, since entities are only translated by the xml parser.*/
+class UGXFileParser
+{
+	public:
+		UGXFileParser();
+
+	///	data blocks larger than the given size (in bytes) remain in the file.
+	/**	A threshold of 0 loads the whole file into the document.*/
+		void set_block_threshold(size_t size)	{m_blockThreshold = size;}
+
+	///	parses the given file into the given document
+		bool parse_file(rapidxml::xml_document<>& doc, const char* filename);
+
+	///	returns true if the value of the given node remained in the file
+		bool external_block(rapidxml::xml_node<>* node,
+							std::streamoff& offsetOut,
+							std::streamsize& sizeOut) const;
+
+	///	name of the file which was parsed last
+		const std::string& filename() const		{return m_filename;}
+
+	protected:
+		bool parse_skeleton(rapidxml::xml_document<>& doc, const char* filename);
+		bool parse_in_memory(rapidxml::xml_document<>& doc, const char* filename);
+
+	private:
+		std::string	m_filename;
+		size_t		m_blockThreshold;
+		std::vector<std::pair<std::streamoff, std::streamsize> >	m_vBlocks;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+///	Reads the values of a ugx-node, written as ascii text or as binary data
+/**	Values are read through the >> operator, as from a std::istream. If the
+ *	node value was left in the file by UGXFileParser, it is read block by
+ *	block from the file.*/
+class UGXDataReader
+{
+	public:
+		UGXDataReader(const UGXFileParser& parser, rapidxml::xml_node<>* node);
+		~UGXDataReader();
+
+		inline bool binary() const	{return m_bBinary;}
+
+		UGXDataReader& operator>>(int& val);
+		UGXDataReader& operator>>(size_t& val);
+		UGXDataReader& operator>>(float& val);
+		UGXDataReader& operator>>(double& val);
+
+		inline bool eof() const		{return m_in.eof();}
+		inline bool fail() const	{return m_in.fail();}
+
+	///	the (decoded) data of the node
+		inline std::istream& stream()	{return m_in;}
+
+	private:
+		UGXDataReader(const UGXDataReader&);
+		UGXDataReader& operator=(const UGXDataReader&);
+
+	private:
+		std::streambuf*	m_pBuf;
+		std::istream	m_in;
+		bool			m_bBinary;
+};
+
+}//	end of namespace
+
+#endif
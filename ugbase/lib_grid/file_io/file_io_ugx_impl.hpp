@@ -226,28 +226,16 @@ create_vertex_node(RegularVertexIterator vrtsBegin,
 	const int numCoords = (int)TAAPos::ValueType::Size;
 
 //	write the vertices to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	ss.precision(18);
 	for(RegularVertexIterator iter = vrtsBegin; iter != vrtsEnd; ++iter)
 	{
 		for(int i = 0; i < numCoords; ++i)
-			ss << aaPos[*iter][i] << " ";
+			ss << aaPos[*iter][i];
 	}
 
 //	create the node
-	xml_node<>* node = NULL;
-
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create a node with some data
-		node = m_doc.allocate_node(node_element, "vertices", nodeData);
-	}
-	else{
-	//	create an emtpy node
-		node = m_doc.allocate_node(node_element, "vertices");
-	}
+	xml_node<>* node = create_data_node("vertices", ss);
 
 	char* buff = m_doc.allocate_string(NULL, 10);
 	sprintf(buff, "%d", numCoords);
@@ -272,11 +260,11 @@ create_constrained_vertex_node(ConstrainedVertexIterator vrtsBegin,
 	const int numCoords = (int)TAAPos::ValueType::Size;
 
 //	write the vertices to a temporary stream
-	stringstream ss;
+	UGXDataWriter ss(m_bBinary);
 	for(ConstrainedVertexIterator iter = vrtsBegin; iter != vrtsEnd; ++iter)
 	{
 		for(int i = 0; i < numCoords; ++i)
-			ss << aaPos[*iter][i] << " ";
+			ss << aaPos[*iter][i];
 			
 	//	write index and local coordinate of associated constraining element
 	//	codes:	-1: no constraining element
@@ -287,28 +275,16 @@ create_constrained_vertex_node(ConstrainedVertexIterator vrtsBegin,
 		Edge* ce = dynamic_cast<Edge*>((*iter)->get_constraining_object());
 		Face* cf = dynamic_cast<Face*>((*iter)->get_constraining_object());
 		if(ce)
-			ss << "1 " << aaIndEDGE[ce] << " " << (*iter)->get_local_coordinate_1() << " ";
+			ss << 1 << aaIndEDGE[ce] << (*iter)->get_local_coordinate_1();
 		else if(cf)
-			ss << "2 " << aaIndFACE[cf] << " " << (*iter)->get_local_coordinate_1()
-			   << " " << (*iter)->get_local_coordinate_2() << " ";
+			ss << 2 << aaIndFACE[cf] << (*iter)->get_local_coordinate_1()
+			   << (*iter)->get_local_coordinate_2();
 		else
-			ss << "-1 ";
+			ss << -1;
 	}
 
 //	create the node
-	xml_node<>* node = NULL;
-
-	if(ss.str().size() > 0){
-	//	allocate a string and erase last character(' ')
-		char* nodeData = m_doc.allocate_string(ss.str().c_str(), ss.str().size());
-		nodeData[ss.str().size()-1] = 0;
-	//	create a node with some data
-		node = m_doc.allocate_node(node_element, "constrained_vertices", nodeData);
-	}
-	else{
-	//	create an emtpy node
-		node = m_doc.allocate_node(node_element, "constrained_vertices");
-	}
+	xml_node<>* node = create_data_node("constrained_vertices", ss);
 
 	char* buff = m_doc.allocate_string(NULL, 10);
 	sprintf(buff, "%d", numCoords);
@@ -700,9 +676,8 @@ create_vertices(std::vector<Vertex*>& vrtsOut, Grid& grid,
 	if(numSrcCoords < 1 || numDestCoords < 1)
 		return false;
 
-//	create a buffer with which we can access the data
-	string str(vrtNode->value(), vrtNode->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, vrtNode);
 
 //	if numDestCoords == numSrcCoords parsing will be faster
 	if(numSrcCoords == numDestCoords){
@@ -785,9 +760,8 @@ create_constrained_vertices(std::vector<Vertex*>& vrtsOut,
 	if(numSrcCoords < 1 || numDestCoords < 1)
 		return false;
 
-//	create a buffer with which we can access the data
-	string str(vrtNode->value(), vrtNode->value_size());
-	stringstream ss(str, ios_base::in);
+//	access the data of the node
+	UGXDataReader ss(m_parser, vrtNode);
 
 //	we have to be careful with reading.
 //	if numDestCoords < numSrcCoords we'll ignore some coords,
@@ -894,9 +868,8 @@ read_attachment(Grid& grid, rapidxml::xml_node<>* node)
 				  GlobalAttachments::type_name(name)
 				  << ", but given type is: " << type);
 
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
-	GlobalAttachments::read_attachment_values<TElem>(ss, grid, name);
+	UGXDataReader in(m_parser, node);
+	GlobalAttachments::read_attachment_values<TElem>(in.stream(), grid, name);
 
 	return true;
 }
@@ -0,0 +1,719 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "partitioner_space_filling_curve.h"
+#include "distributed_grid.h"
+#include "lib_grid/parallelization/util/compol_copy_attachment.h"
+#include "lib_grid/parallelization/util/compol_subset.h"
+#include "lib_grid/parallelization/parallelization_util.h"
+#include "lib_grid/algorithms/attachment_util.h"
+#include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+
+using namespace std;
+
+namespace ug{
+
+template <class TElem, int dim>
+Partitioner_SpaceFillingCurve<TElem, dim>::
+Partitioner_SpaceFillingCurve() :
+	m_mg(NULL),
+	m_hilbertCurve(true),
+	m_tolerance(0.99),
+	m_splitImproveIterations(32)
+{
+	m_processHierarchy = SPProcessHierarchy(new ProcessHierarchy);
+	m_processHierarchy->add_hierarchy_level(0, 1);
+
+	m_balanceWeights = make_sp(new IBalanceWeights());
+}
+
+template <class TElem, int dim>
+Partitioner_SpaceFillingCurve<TElem, dim>::
+~Partitioner_SpaceFillingCurve()
+{
+}
+
+////////////////////////////////
+//	SETTERS AND GETTERS
+////////////////////////////////
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos)
+{
+	m_mg = mg;
+	if(m_sh.valid())
+		m_sh->assign_grid(m_mg);
+	m_aPos = aPos;
+	m_aaPos.access(*m_mg, m_aPos);
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_subset_handler(SmartPtr<SubsetHandler> sh)
+{
+	m_sh = sh;
+	if(m_mg)
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_next_process_hierarchy(SPProcessHierarchy procHierarchy)
+{
+	m_nextProcessHierarchy = procHierarchy;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_balance_weights(SPBalanceWeights balanceWeights)
+{
+	m_balanceWeights = balanceWeights;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_partition_pre_processor(SPPartitionPreProcessor ppp)
+{
+	m_partitionPreProcessor = ppp;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_partition_post_processor(SPPartitionPostProcessor ppp)
+{
+	m_partitionPostProcessor = ppp;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SpaceFillingCurve<TElem, dim>::
+current_process_hierarchy() const
+{
+	return m_processHierarchy;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SpaceFillingCurve<TElem, dim>::
+next_process_hierarchy() const
+{
+	return m_nextProcessHierarchy;
+}
+
+template <class TElem, int dim>
+SubsetHandler& Partitioner_SpaceFillingCurve<TElem, dim>::
+get_partitions()
+{
+	if(m_sh.invalid()){
+		if(m_mg)
+			m_sh = make_sp(new SubsetHandler(*m_mg));
+		else
+			m_sh = make_sp(new SubsetHandler());
+	}
+	return *m_sh;
+}
+
+template <class TElem, int dim>
+const std::vector<int>* Partitioner_SpaceFillingCurve<TElem, dim>::
+get_process_map() const
+{
+	return NULL;
+}
+
+
+////////////////////////////////
+//	PARTITIONING
+////////////////////////////////
+template <class TElem, int dim>
+bool Partitioner_SpaceFillingCurve<TElem, dim>::
+partition(size_t baseLvl, size_t elementThreshold)
+{
+	GDIST_PROFILE_FUNC();
+
+	UG_COND_THROW(m_mg == NULL,
+			"No grid was specified for Partitioner_SpaceFillingCurve. "
+			"partitioning can't be executed without a specified grid.");
+
+	if(m_balanceWeights.invalid())
+		m_balanceWeights = make_sp(new IBalanceWeights());
+
+	MultiGrid& mg = *m_mg;
+	if(m_sh.invalid())
+		m_sh = make_sp(new SubsetHandler(mg));
+	SubsetHandler& sh = *m_sh;
+	sh.clear();
+
+	ANumber aWeight;
+	mg.attach_to<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_starts(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->init_post_processing(m_mg, m_sh.get());
+
+//	assign all elements below baseLvl to the local process
+	for(int i = 0; i < (int)baseLvl; ++i)
+		sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+
+	const ProcessHierarchy* procH;
+	if(m_nextProcessHierarchy.valid())
+		procH = m_nextProcessHierarchy.get();
+	else
+		procH = m_processHierarchy.get();
+
+	m_problemsOccurred = false;
+
+//	iterate over all hierarchy levels and perform rebalancing for all
+//	hierarchy-sections which contain levels higher than baseLvl
+	for(size_t hlevel = 0; hlevel < procH->num_hierarchy_levels(); ++ hlevel)
+	{
+		int numProcs = procH->num_global_procs_involved(hlevel);
+
+		int minLvl = procH->grid_base_level(hlevel);
+		int maxLvl = (int)mg.top_level();
+
+		if(m_balanceWeights->has_level_offsets()){
+			if(mg.top_level() < procH->grid_base_level(hlevel)){
+			//	see Partitioner_DynamicBisection::partition
+				if((hlevel == 0) ||
+					((int)procH->num_global_procs_involved(hlevel - 1) != numProcs))
+				{
+					UG_LOG("Partitioner_SpaceFillingCurve: Ignoring hierarchy level "
+						<< hlevel << " since it doesn't contain any elements yet\n");
+					m_problemsOccurred = true;
+				}
+				continue;
+			}
+		}
+
+		if(hlevel + 1 < procH->num_hierarchy_levels()){
+			maxLvl = min<int>(maxLvl,
+						(int)procH->grid_base_level(hlevel + 1) - 1);
+		}
+
+		if(minLvl < (int)baseLvl)
+			minLvl = (int)baseLvl;
+
+		if(maxLvl < minLvl)
+			continue;
+
+		if(numProcs <= 1){
+			for(int i = minLvl; i <= maxLvl; ++i)
+				sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+			continue;
+		}
+
+	//	if clustered siblings are enabled, we'll perform partitioning on the level
+	//	below minLvl (if such a level exists). However, only the partition-map
+	//	of minLvl and levels above will be adjusted.
+		int partitionLvl = minLvl;
+		pcl::ProcessCommunicator com;
+
+		if((minLvl > 0) && base_class::clustered_siblings_enabled()){
+			partitionLvl = minLvl - 1;
+			size_t partitionHLvl = m_processHierarchy->hierarchy_level_from_grid_level(partitionLvl);
+			com = m_processHierarchy->global_proc_com(partitionHLvl);
+		}
+		else
+			com = procH->global_proc_com(hlevel);
+
+		perform_partitioning(numProcs, minLvl, maxLvl, partitionLvl, aWeight, com);
+
+		for(int i = minLvl; i < maxLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+	}
+
+	if(m_nextProcessHierarchy.valid()){
+		*m_processHierarchy = *m_nextProcessHierarchy;
+		m_nextProcessHierarchy = SPProcessHierarchy(NULL);
+	}
+
+	mg.detach_from<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_done(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->partitioning_done();
+
+	PCL_DEBUG_BARRIER_ALL();
+	return true;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+perform_partitioning(int numTargetProcs, int minLvl, int maxLvl, int partitionLvl,
+					 ANumber aWeight, pcl::ProcessCommunicator com)
+{
+	GDIST_PROFILE_FUNC();
+
+	typedef typename MultiGrid::traits<elem_t>::iterator iter_t;
+
+	MultiGrid&		mg	= *m_mg;
+	SubsetHandler&	sh	= *m_sh;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+	SetAttachmentValues(aaWeight, mg.begin<elem_t>(partitionLvl),
+						mg.end<elem_t>(partitionLvl), 0);
+
+	vector<int> origSubsetIndices;
+	if(partitionLvl < minLvl){
+		origSubsetIndices.reserve(mg.num<elem_t>(partitionLvl));
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			origSubsetIndices.push_back(sh.get_subset_index(*eiter));
+		}
+	}
+
+//	invalidate target partitions of all elements in partitionLvl
+	sh.assign_subset(mg.begin<elem_t>(partitionLvl),
+					   mg.end<elem_t>(partitionLvl), -1);
+
+//	the global bounding box of all elements in partitionLvl defines the domain
+//	of the curve. Since it does not change during refinement, the order of the
+//	elements along the curve is kept between repartitionings.
+	vector_t boxMin, boxMax;
+	VecSet(boxMin, numeric_limits<number>::max());
+	VecSet(boxMax, -numeric_limits<number>::max());
+	for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+		eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+	{
+		if(pdgm && pdgm->is_ghost(*eiter))
+			continue;
+		vector_t c = CalculateCenter(*eiter, m_aaPos);
+		for(int i = 0; i < dim; ++i){
+			boxMin[i] = min(boxMin[i], c[i]);
+			boxMax[i] = max(boxMax[i], c[i]);
+		}
+	}
+
+	if(!com.empty()){
+		vector_t tmp;
+		com.allreduce(&boxMin[0], &tmp[0], dim, PCL_RO_MIN);
+		boxMin = tmp;
+		com.allreduce(&boxMax[0], &tmp[0], dim, PCL_RO_MAX);
+		boxMax = tmp;
+	}
+
+	bool markedElemsOnly = m_balanceWeights->has_level_offsets();
+	vector<Entry> entries;
+	vector<uint64> cuts;
+
+//	iterate over all levels and gather child-weights in the partitionLvl.
+//	Elements with children in higher levels are partitioned first.
+	for(int i_lvl = maxLvl; i_lvl >= minLvl;){
+		gather_weights_from_level(partitionLvl, i_lvl, aWeight, markedElemsOnly);
+
+		entries.clear();
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			elem_t* elem = *eiter;
+			if((aaWeight[elem] > 0) && (sh.get_subset_index(elem) == -1)
+				&& ((!pdgm) || (!pdgm->is_ghost(elem))))
+			{
+				Entry entry;
+				entry.key = 0;
+				entry.weight = aaWeight[elem];
+				entry.elem = elem;
+				entries.push_back(entry);
+			}
+		}
+
+		if(!com.empty()){
+			calculate_keys(entries, boxMin, boxMax);
+			sort(entries.begin(), entries.end());
+			find_cuts(cuts, entries, numTargetProcs, com);
+
+			for(size_t i = 0; i < entries.size(); ++i){
+				int p = (int)(upper_bound(cuts.begin(), cuts.end(), entries[i].key)
+							  - cuts.begin());
+				sh.assign_subset(entries[i].elem, p);
+			}
+		}
+
+		if(markedElemsOnly)
+			markedElemsOnly = false;
+		else
+			--i_lvl;
+	}
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->post_process(partitionLvl);
+
+	if(partitionLvl < minLvl){
+		UG_ASSERT(partitionLvl == minLvl - 1,
+				  "partitionLvl and minLvl should be neighbors");
+
+	//	copy subset indices from partition-level to minLvl
+		for(int i = partitionLvl; i < minLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+
+	//	reset partitions in the specified partition-level
+		size_t counter = 0;
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter, ++counter)
+		{
+			sh.assign_subset(*eiter, origSubsetIndices[counter]);
+		}
+	}
+	else if(pdgm){
+	//	copy subset indices from vertical slaves to vertical masters,
+	//	since partitioning was only performed on vslaves
+		GridLayoutMap& glm = pdgm->grid_layout_map();
+		ComPol_Subset<layout_t>	compolSHCopy(sh, true);
+
+		if(glm.has_layout<elem_t>(INT_V_SLAVE))
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(partitionLvl),
+								 compolSHCopy);
+		if(glm.has_layout<elem_t>(INT_V_MASTER))
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(partitionLvl),
+									compolSHCopy);
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+calculate_keys(std::vector<Entry>& entries, const vector_t& boxMin,
+			   const vector_t& boxMax)
+{
+	const int numBits = 62 / dim;
+	const uint64 maxKeyCoord = (uint64(1) << numBits) - 1;
+	const number maxCoord = (number)maxKeyCoord;
+
+	number scale[dim];
+	for(int i = 0; i < dim; ++i){
+		number ext = boxMax[i] - boxMin[i];
+		scale[i] = (ext > 0) ? maxCoord / ext : 0;
+	}
+
+	uint64 coords[dim];
+	for(size_t iEntry = 0; iEntry < entries.size(); ++iEntry){
+		vector_t c = CalculateCenter(entries[iEntry].elem, m_aaPos);
+		for(int i = 0; i < dim; ++i){
+		//	for dim == 1 maxCoord is rounded up to 2^62, thus clamp in integer space
+			number s = (c[i] - boxMin[i]) * scale[i];
+			if(s > 0)
+				coords[i] = min<uint64>((uint64)min<number>(s, maxCoord), maxKeyCoord);
+			else
+				coords[i] = 0;
+		}
+		entries[iEntry].key = curve_key(coords);
+	}
+}
+
+
+template <class TElem, int dim>
+uint64 Partitioner_SpaceFillingCurve<TElem, dim>::
+curve_key(uint64* x) const
+{
+	const int numBits = 62 / dim;
+
+//	transforms the coordinates to the transposed Hilbert index
+//	(J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004)
+	if(m_hilbertCurve && (dim > 1)){
+		const uint64 m = uint64(1) << (numBits - 1);
+		for(uint64 q = m; q > 1; q >>= 1){
+			uint64 p = q - 1;
+			for(int i = 0; i < dim; ++i){
+				if(x[i] & q)
+					x[0] ^= p;
+				else{
+					uint64 t = (x[0] ^ x[i]) & p;
+					x[0] ^= t;
+					x[i] ^= t;
+				}
+			}
+		}
+
+		for(int i = 1; i < dim; ++i)
+			x[i] ^= x[i-1];
+
+		uint64 t = 0;
+		for(uint64 q = m; q > 1; q >>= 1){
+			if(x[dim-1] & q)
+				t ^= q - 1;
+		}
+		for(int i = 0; i < dim; ++i)
+			x[i] ^= t;
+	}
+
+//	interleave the bits of all coordinates
+	uint64 key = 0;
+	for(int b = numBits - 1; b >= 0; --b){
+		for(int i = 0; i < dim; ++i)
+			key = (key << 1) | ((x[i] >> b) & 1);
+	}
+	return key;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+find_cuts(std::vector<uint64>& cutsOut, std::vector<Entry>& entries,
+		  int numParts, pcl::ProcessCommunicator& com)
+{
+	GDIST_PROFILE_FUNC();
+
+	const uint64 keyEnd = uint64(1) << (dim * (62 / dim));
+
+	number localWeight = 0;
+	for(size_t i = 0; i < entries.size(); ++i)
+		localWeight += entries[i].weight;
+	number totalWeight = com.allreduce(localWeight, PCL_RO_SUM);
+
+//	cut i separates the partitions i and i+1
+	const number avgWeight = totalWeight / (number)numParts;
+	const number tolWeight = (1. - m_tolerance) * avgWeight;
+	vector<Cut> cuts(numParts - 1);
+	for(size_t i = 0; i < cuts.size(); ++i){
+		cuts[i].lo = 0;
+		cuts[i].hi = keyEnd;
+		cuts[i].weightBelow = 0;
+		cuts[i].target = (number)(i + 1) * avgWeight;
+		cuts[i].done = (totalWeight <= 0);
+	}
+
+//	the histograms of all open cuts are reduced together. The number of bins
+//	per cut is chosen such that the reduced data stays small for many processes.
+	vector<size_t>	openCuts;
+	vector<number>	localHist, hist;
+	for(int iteration = 0; iteration < m_splitImproveIterations; ++iteration){
+		openCuts.clear();
+		for(size_t i = 0; i < cuts.size(); ++i){
+			if(!cuts[i].done)
+				openCuts.push_back(i);
+		}
+		if(openCuts.empty())
+			break;
+
+		const size_t numBins = max<size_t>(2, min<size_t>(64, (1 << 16) / openCuts.size()));
+		localHist.assign(openCuts.size() * numBins, 0);
+		for(size_t iOpen = 0; iOpen < openCuts.size(); ++iOpen){
+			Cut& cut = cuts[openCuts[iOpen]];
+			const uint64 binWidth = (cut.hi - cut.lo + numBins - 1) / numBins;
+			Entry searchEntry;
+			searchEntry.key = cut.lo;
+			for(typename vector<Entry>::iterator iter =
+					lower_bound(entries.begin(), entries.end(), searchEntry);
+				(iter != entries.end()) && (iter->key < cut.hi); ++iter)
+			{
+				localHist[iOpen * numBins + (iter->key - cut.lo) / binWidth]
+						+= iter->weight;
+			}
+		}
+
+		com.allreduce(localHist, hist, PCL_RO_SUM);
+
+		for(size_t iOpen = 0; iOpen < openCuts.size(); ++iOpen){
+			Cut& cut = cuts[openCuts[iOpen]];
+			const uint64 binWidth = (cut.hi - cut.lo + numBins - 1) / numBins;
+			const number* binWeights = &hist[iOpen * numBins];
+
+		//	find the bin in which the target weight is reached
+			size_t bin = 0;
+			number weightBelow = cut.weightBelow;
+			while((bin < numBins) && (weightBelow + binWeights[bin] < cut.target)){
+				weightBelow += binWeights[bin];
+				++bin;
+			}
+
+			if(bin == numBins){
+				cut.lo = cut.hi;
+				cut.weightBelow = weightBelow;
+				cut.done = true;
+				continue;
+			}
+
+			uint64 binBegin = cut.lo + bin * binWidth;
+			uint64 binEnd = min(binBegin + binWidth, cut.hi);
+			number weightBelowEnd = weightBelow + binWeights[bin];
+
+			if(fabs(weightBelow - cut.target) <= tolWeight){
+				cut.lo = binBegin;
+				cut.weightBelow = weightBelow;
+				cut.done = true;
+			}
+			else if((fabs(weightBelowEnd - cut.target) <= tolWeight)
+					|| (binEnd - binBegin <= 1))
+			{
+			//	choose the closer one of both bin boundaries
+				if(weightBelowEnd - cut.target < cut.target - weightBelow){
+					cut.lo = binEnd;
+					cut.weightBelow = weightBelowEnd;
+				}
+				else{
+					cut.lo = binBegin;
+					cut.weightBelow = weightBelow;
+				}
+				cut.done = true;
+			}
+			else{
+				cut.lo = binBegin;
+				cut.hi = binEnd;
+				cut.weightBelow = weightBelow;
+			}
+		}
+	}
+
+//	elements with keys smaller than cutsOut[i] are assigned to partitions <= i
+	cutsOut.resize(cuts.size());
+	for(size_t i = 0; i < cuts.size(); ++i){
+		cutsOut[i] = cuts[i].lo;
+		if(i > 0)
+			cutsOut[i] = max(cutsOut[i], cutsOut[i-1]);
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+	MultiGrid& mg = *m_mg;
+
+//	assign partitions to all children in this hierarchy level
+	for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+	{
+		size_t numChildren = mg.num_children<elem_t>(*iter);
+		int si = partitionSH.get_subset_index(*iter);
+		for(size_t i = 0; i < numChildren; ++i)
+			partitionSH.assign_subset(mg.get_child<elem_t>(*iter, i), si);
+	}
+
+	if(mg.is_parallel()){
+		GridLayoutMap& glm = mg.distributed_grid_manager()->grid_layout_map();
+	//	communicate partitions from v-masters to v-slaves, since v-slaves
+	//	havn't got no parents on their procs.
+		ComPol_Subset<layout_t>	compolSHCopy(partitionSH, true);
+		if(glm.has_layout<elem_t>(INT_V_MASTER)){
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl+1),
+								 compolSHCopy);
+		}
+		if(glm.has_layout<elem_t>(INT_V_SLAVE)){
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl+1),
+									compolSHCopy);
+		}
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+gather_weights_from_level(int baseLvl, int childLvl, ANumber aWeight,
+						  bool markedElemsOnly)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+
+	IBalanceWeights& bw = *m_balanceWeights;
+	MultiGrid& mg = *m_mg;
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+
+//	childLvl may be at most one level above the highest level of the grid hierarchy.
+	if(childLvl < baseLvl || childLvl >= (int)mg.num_levels()){
+		SetAttachmentValues(aaWeight, mg.begin<elem_t>(baseLvl), mg.end<elem_t>(baseLvl), 0);
+		return;
+	}
+
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+	ComPol_CopyAttachment<layout_t, ANumber> compolCopy(mg, aWeight);
+
+	for(ElemIter iter = mg.begin<elem_t>(childLvl);
+		iter != mg.end<elem_t>(childLvl); ++iter)
+	{
+		elem_t* e = *iter;
+		if(!markedElemsOnly)
+			aaWeight[e] = bw.get_weight(e);
+		else if((mg.num_children<elem_t>(e) == 0)
+				&& ((!pdgm) || (!pdgm->is_ghost(e)))
+				&& bw.consider_in_level_above(e))
+		{
+			aaWeight[e] = bw.get_refined_weight(e);
+		}
+		else
+			aaWeight[e] = 0;
+	}
+
+	for(int lvl = childLvl - 1; lvl >= baseLvl; --lvl){
+	//	copy from v-slaves to vmasters
+		if(pdgm){
+			GridLayoutMap& glm = pdgm->grid_layout_map();
+			if(glm.has_layout<elem_t>(INT_V_SLAVE))
+				m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl + 1),
+									 compolCopy);
+			if(glm.has_layout<elem_t>(INT_V_MASTER))
+				m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl + 1),
+										compolCopy);
+			m_intfcCom.communicate();
+		}
+
+	//	accumulate child weights in parent elements on lvl
+		for(ElemIter iter = mg.begin<elem_t>(lvl);
+			iter != mg.end<elem_t>(lvl); ++iter)
+		{
+			elem_t* e = *iter;
+			size_t numChildren = mg.num_children<elem_t>(e);
+			if(bw.has_level_offsets() && (lvl == childLvl - 1) && (numChildren == 0)
+				&& ((!pdgm) || (!pdgm->is_ghost(e))) && bw.consider_in_level_above(e))
+			{
+				aaWeight[e] = bw.get_refined_weight(e);
+			}
+			else{
+				aaWeight[e] = 0;
+				for(size_t i = 0; i < numChildren; ++i)
+					aaWeight[e] += aaWeight[mg.get_child<elem_t>(e, i)];
+			}
+		}
+	}
+}
+
+
+template class Partitioner_SpaceFillingCurve<Edge, 1>;
+template class Partitioner_SpaceFillingCurve<Edge, 2>;
+template class Partitioner_SpaceFillingCurve<Face, 2>;
+template class Partitioner_SpaceFillingCurve<Edge, 3>;
+template class Partitioner_SpaceFillingCurve<Face, 3>;
+template class Partitioner_SpaceFillingCurve<Volume, 3>;
+
+}// end of namespace
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__partitioner_space_filling_curve__
+#define __H__UG__partitioner_space_filling_curve__
+
+#include <vector>
+#include "common/types.h"
+#include "parallel_grid_layout.h"
+#include "partitioner.h"
+#include "pcl/pcl_interface_communicator.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_parallelization_distribution
+///	\{
+
+///	Parallel space filling curve partitioner
+/**	The centers of the elements on the partitioning level are mapped to keys
+ * on a Hilbert curve (or optionally a Morton curve) in the global bounding box.
+ * The curve is then cut into pieces of equal weight, where the weight of an
+ * element is the accumulated weight of its descendants in the surface grid,
+ * as specified by the balance weights.
+ *
+ * The cut positions are found through a histogram based search on the keys.
+ * Each search round only requires one global reduction, regardless of the
+ * number of involved processes. No elements have to be sent during partitioning.
+ *
+ * Since the order of the elements along the curve does not change during
+ * adaptive refinement, a repartitioning only moves the cut positions. Elements
+ * thus only migrate between processes which are neighbors on the curve.
+ *
+ * The partitioner can be used inside a LoadBalancer or separately. It can
+ * operate on serial and parallel multigrids and considers the levels of the
+ * process hierarchy.
+ */
+template <class TElem, int dim>
+class Partitioner_SpaceFillingCurve : public IPartitioner{
+	public:
+		typedef IPartitioner	 						base_class;
+		typedef TElem									elem_t;
+		typedef MathVector<dim>							vector_t;
+		typedef Attachment<vector_t>					apos_t;
+		typedef Grid::VertexAttachmentAccessor<apos_t>	aapos_t;
+		typedef typename GridLayoutMap::Types<elem_t>::Layout::LevelLayout	layout_t;
+
+		Partitioner_SpaceFillingCurve();
+		virtual ~Partitioner_SpaceFillingCurve();
+
+		void set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos);
+
+	///	allows to optionally specify a subset-handler on which the balancer shall operate
+		void set_subset_handler(SmartPtr<SubsetHandler> sh);
+
+	///	enables the Hilbert curve. If disabled, a Morton curve is used instead.
+	/**	enabled by default. The Hilbert curve leads to more compact partitions,
+	 * the Morton curve is slightly cheaper to evaluate.*/
+		void enable_hilbert_curve(bool enable)		{m_hilbertCurve = enable;}
+		bool hilbert_curve_enabled() const			{return m_hilbertCurve;}
+
+	///	sets the tolerance threshold. 1: no tolerance, 0: full tolerance.
+	/**	The search for cut positions stops as soon as the weight of each
+	 * partition deviates less than (1 - tol) times the average partition weight
+	 * from the optimum. The tolerance is defaulted to 0.99.*/
+		void set_tolerance(number tol)				{m_tolerance = tol;}
+
+	///	the maximum number of histogram rounds performed to find the cut positions
+		int num_split_improvement_iterations() const		{return m_splitImproveIterations;}
+		void set_num_split_improvement_iterations(int num)	{m_splitImproveIterations = num;}
+
+		virtual void set_next_process_hierarchy(SPProcessHierarchy procHierarchy);
+		virtual void set_balance_weights(SPBalanceWeights balanceWeights);
+
+		virtual void set_partition_pre_processor(SPPartitionPreProcessor ppp);
+		virtual void set_partition_post_processor(SPPartitionPostProcessor ppp);
+
+		virtual ConstSPProcessHierarchy current_process_hierarchy() const;
+		virtual ConstSPProcessHierarchy next_process_hierarchy() const;
+
+		virtual bool supports_balance_weights() const		{return true;}
+		virtual bool supports_repartitioning() const		{return true;}
+
+		virtual bool partition(size_t baseLvl, size_t elementThreshold);
+
+		virtual SubsetHandler& get_partitions();
+		virtual const std::vector<int>* get_process_map() const;
+
+	private:
+		struct Entry{
+			uint64	key;
+			number	weight;
+			elem_t*	elem;
+			bool operator<(const Entry& e) const	{return key < e.key;}
+		};
+
+	///	state of the search for one cut position on the curve
+		struct Cut{
+			uint64	lo;			///< the cut lies in [lo, hi]
+			uint64	hi;
+			number	weightBelow;///< global weight of all keys smaller than lo
+			number	target;		///< global weight which should lie below the cut
+			bool	done;
+		};
+
+		void perform_partitioning(int numTargetProcs, int minLvl, int maxLvl,
+								  int partitionLvl, ANumber aWeight,
+								  pcl::ProcessCommunicator com);
+
+	///	computes the key of each entry on the curve in the given bounding box
+		void calculate_keys(std::vector<Entry>& entries, const vector_t& boxMin,
+							const vector_t& boxMax);
+
+	///	returns the position of the given (scaled) coordinates on the curve
+		uint64 curve_key(uint64* coords) const;
+
+	///	finds the positions at which the curve is cut into numParts parts
+		void find_cuts(std::vector<uint64>& cutsOut, std::vector<Entry>& entries,
+					   int numParts, pcl::ProcessCommunicator& com);
+
+		void copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl);
+
+		void gather_weights_from_level(int baseLvl, int childLvl, ANumber aWeight,
+									   bool markedElemsOnly);
+
+		MultiGrid*								m_mg;
+		apos_t									m_aPos;
+		aapos_t									m_aaPos;
+		SmartPtr<SubsetHandler>					m_sh;
+		SPProcessHierarchy						m_processHierarchy;
+		SPProcessHierarchy						m_nextProcessHierarchy;
+		pcl::InterfaceCommunicator<layout_t>	m_intfcCom;
+
+		SPBalanceWeights						m_balanceWeights;
+		SPPartitionPreProcessor					m_partitionPreProcessor;
+		SPPartitionPostProcessor				m_partitionPostProcessor;
+
+		bool	m_hilbertCurve;
+		number	m_tolerance;
+		int		m_splitImproveIterations;
+};
+
+///	\}
+
+}// end of namespace
+
+#endif
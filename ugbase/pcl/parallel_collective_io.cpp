@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <sstream>
+#include "parallel_collective_io.h"
+#include "pcl_methods.h"
+#include "pcl_profiling.h"
+#include "common/error.h"
+#include "common/log.h"
+
+using namespace std;
+
+namespace pcl{
+
+////////////////////////////////////////////////////////////////////////
+//	global defaults
+
+static int g_collectiveIONumAggregators = 0;
+static size_t g_collectiveIOStripeSize = 1 << 20;
+static bool g_collectiveIOAsync = false;
+
+///	processes per aggregator if the number of aggregators is chosen automatically
+static const int PCL_RANKS_PER_AGGREGATOR = 64;
+
+///	message tag used to send data to the aggregators
+static const int PCL_TAG_COLLECTIVE_IO = 7841;
+
+///	largest block passed to a single MPI call (counts are int)
+static const size_t PCL_MAX_IO_CHUNK = 1 << 30;
+
+void SetCollectiveIONumAggregators(int num)
+{
+	UG_COND_THROW(num < 0, "SetCollectiveIONumAggregators: num has to be >= 0.");
+	g_collectiveIONumAggregators = num;
+}
+
+void SetCollectiveIOStripeSize(size_t size)
+{
+	UG_COND_THROW(size == 0 || size > PCL_MAX_IO_CHUNK,
+				  "SetCollectiveIOStripeSize: size has to be in [1, " << PCL_MAX_IO_CHUNK << "].");
+	g_collectiveIOStripeSize = size;
+}
+
+void SetCollectiveIOAsync(bool bAsync)
+{
+	g_collectiveIOAsync = bAsync;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	pending asynchronous writes
+
+///	file handle, buffers and requests of a write which was not completed on close
+struct PendingFileWrite
+{
+	MPI_File fh;
+	list<vector<char> > lBuf;
+	vector<MPI_Request> vRequest;
+};
+
+static vector<SmartPtr<PendingFileWrite> >& PendingFileWrites()
+{
+	static vector<SmartPtr<PendingFileWrite> > vPending;
+	return vPending;
+}
+
+void CompletePendingFileWrites()
+{
+	vector<SmartPtr<PendingFileWrite> >& vPending = PendingFileWrites();
+	if(vPending.empty()) return;
+
+	PCL_PROFILE(pclCompletePendingFileWrites);
+	for(size_t i = 0; i < vPending.size(); ++i){
+		PendingFileWrite& pw = *vPending[i];
+		if(!pw.vRequest.empty())
+			pcl::MPI_Waitall((int)pw.vRequest.size(), &pw.vRequest[0], MPI_STATUSES_IGNORE);
+		MPI_File_close(&pw.fh);
+	}
+	vPending.clear();
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	CollectiveFileWriter
+
+CollectiveFileWriter::
+CollectiveFileWriter(ProcessCommunicator pc) :
+	m_pc(pc),
+	m_numAggregators(g_collectiveIONumAggregators),
+	m_numAggregatorsUsed(0),
+	m_stripeSize((MPI_Offset)g_collectiveIOStripeSize),
+	m_bAsync(g_collectiveIOAsync),
+	m_bOpen(false)
+{
+}
+
+CollectiveFileWriter::
+~CollectiveFileWriter()
+{
+//	MPI_File_close is collective, thus the file is not closed here
+	if(m_bOpen){
+		wait();
+		UG_LOG("WARNING in CollectiveFileWriter: File has not been closed.\n");
+	}
+}
+
+void CollectiveFileWriter::
+set_stripe_size(size_t size)
+{
+	UG_COND_THROW(size == 0 || size > PCL_MAX_IO_CHUNK,
+				  "CollectiveFileWriter: stripe size has to be in [1, " << PCL_MAX_IO_CHUNK << "].");
+	m_stripeSize = (MPI_Offset)size;
+}
+
+void CollectiveFileWriter::
+open(const string& filename)
+{
+	PCL_PROFILE(pclCollectiveFileWriter_open);
+	UG_COND_THROW(m_bOpen, "CollectiveFileWriter::open: A file is already open.");
+
+	CompletePendingFileWrites();
+
+//	tell the file system about the stripe size (used if the file is created)
+	MPI_Info info;
+	MPI_Info_create(&info);
+	stringstream ss; ss << m_stripeSize;
+	MPI_Info_set(info, const_cast<char*>("striping_unit"), const_cast<char*>(ss.str().c_str()));
+
+	int err = MPI_File_open(m_pc.get_mpi_communicator(), const_cast<char*>(filename.c_str()),
+							MPI_MODE_CREATE | MPI_MODE_WRONLY, info, &m_fh);
+	MPI_Info_free(&info);
+	UG_COND_THROW(err != MPI_SUCCESS, "CollectiveFileWriter: Could not open " << filename);
+
+//	remove old content
+	MPI_File_set_size(m_fh, 0);
+	m_bOpen = true;
+}
+
+void CollectiveFileWriter::
+write_block(MPI_Offset offset, const char* buf, size_t size)
+{
+	for(size_t pos = 0; pos < size; pos += PCL_MAX_IO_CHUNK)
+	{
+		int count = (int)min(size - pos, PCL_MAX_IO_CHUNK);
+		void* p = const_cast<char*>(buf + pos);
+		if(m_bAsync){
+			MPI_Request req;
+			MPI_File_iwrite_at(m_fh, offset + (MPI_Offset)pos, p, count, MPI_BYTE, &req);
+			m_vRequest.push_back(req);
+		}
+		else{
+			MPI_Status status;
+			MPI_File_write_at(m_fh, offset + (MPI_Offset)pos, p, count, MPI_BYTE, &status);
+		}
+	}
+}
+
+void CollectiveFileWriter::
+write_at_all(MPI_Offset offset, const char* buf, size_t size)
+{
+	PCL_PROFILE(pclCollectiveFileWriter_write_at_all);
+	UG_COND_THROW(!m_bOpen, "CollectiveFileWriter::write_at_all: No file open.");
+
+	MPI_Comm comm = m_pc.get_mpi_communicator();
+	const int numProcs = (int)m_pc.size();
+	const int myRank = m_pc.get_local_proc_id();
+
+//	all processes need to know all regions, since each aggregator has to
+//	know from which processes it receives data
+	MPI_Offset myRegion[2] = {offset, (MPI_Offset)size};
+	vector<MPI_Offset> vRegion(2 * numProcs);
+	MPI_Allgather(myRegion, 2, MPI_OFFSET, &vRegion[0], 2, MPI_OFFSET, comm);
+
+	MPI_Offset begin = numeric_limits<MPI_Offset>::max();
+	MPI_Offset end = 0;
+	for(int r = 0; r < numProcs; ++r){
+		if(vRegion[2*r+1] == 0) continue;
+		begin = min(begin, vRegion[2*r]);
+		end = max(end, vRegion[2*r] + vRegion[2*r+1]);
+	}
+	if(end == 0) return;
+
+//	file domains of the aggregators. Those start at multiples of the stripe
+//	size and have to be small enough to be sent with int counts.
+	const MPI_Offset alignedBegin = (begin / m_stripeSize) * m_stripeSize;
+	const MPI_Offset extent = end - alignedBegin;
+	const MPI_Offset maxDomain = ((MPI_Offset)PCL_MAX_IO_CHUNK / m_stripeSize) * m_stripeSize;
+
+	int numAgg = (m_numAggregators > 0) ? m_numAggregators
+				: (numProcs + PCL_RANKS_PER_AGGREGATOR - 1) / PCL_RANKS_PER_AGGREGATOR;
+	numAgg = max(numAgg, (int)((extent + maxDomain - 1) / maxDomain));
+	numAgg = min(numAgg, numProcs);
+
+	MPI_Offset domainSize = (extent + numAgg - 1) / numAgg;
+	domainSize = ((domainSize + m_stripeSize - 1) / m_stripeSize) * m_stripeSize;
+	UG_COND_THROW(domainSize > maxDomain, "CollectiveFileWriter: Too much data "
+				  "for " << numProcs << " processes.");
+
+//	due to the alignment, fewer aggregators may be sufficient
+	numAgg = (int)((extent + domainSize - 1) / domainSize);
+	m_numAggregatorsUsed = numAgg;
+
+//	aggregators are spread evenly over the ranks
+	vector<int> vAggRank(numAgg);
+	int myDomain = -1;
+	for(int i = 0; i < numAgg; ++i){
+		vAggRank[i] = (int)(((long long)i * numProcs) / numAgg);
+		if(vAggRank[i] == myRank) myDomain = i;
+	}
+
+//	aggregators post receives for all overlapping regions
+	vector<MPI_Request> vRequest;
+	list<vector<char> > lDomainBuf;
+	vector<pair<MPI_Offset, MPI_Offset> > vCovered;
+	MPI_Offset domainBegin = 0;
+	if(myDomain >= 0){
+		domainBegin = max(alignedBegin + myDomain * domainSize, begin);
+		MPI_Offset domainEnd = min(alignedBegin + (myDomain + 1) * domainSize, end);
+		lDomainBuf.push_back(vector<char>(domainEnd - domainBegin));
+		char* domainBuf = &lDomainBuf.back()[0];
+
+		for(int r = 0; r < numProcs; ++r){
+			MPI_Offset b = max(vRegion[2*r], domainBegin);
+			MPI_Offset e = min(vRegion[2*r] + vRegion[2*r+1], domainEnd);
+			if(b >= e) continue;
+			vCovered.push_back(make_pair(b, e));
+			if(r == myRank)
+				memcpy(domainBuf + (b - domainBegin), buf + (b - offset), e - b);
+			else{
+				vRequest.push_back(MPI_Request());
+				MPI_Irecv(domainBuf + (b - domainBegin), (int)(e - b), MPI_BYTE, r,
+						  PCL_TAG_COLLECTIVE_IO, comm, &vRequest.back());
+			}
+		}
+	}
+
+//	send the local data to the aggregators
+	if(size > 0){
+		const MPI_Offset myEnd = offset + (MPI_Offset)size;
+		const int first = (int)((offset - alignedBegin) / domainSize);
+		const int last = (int)((myEnd - 1 - alignedBegin) / domainSize);
+		for(int i = first; i <= last; ++i){
+			if(vAggRank[i] == myRank) continue;
+			MPI_Offset b = max(offset, alignedBegin + i * domainSize);
+			MPI_Offset e = min(myEnd, alignedBegin + (i + 1) * domainSize);
+			vRequest.push_back(MPI_Request());
+			MPI_Isend(const_cast<char*>(buf + (b - offset)), (int)(e - b), MPI_BYTE,
+					  vAggRank[i], PCL_TAG_COLLECTIVE_IO, comm, &vRequest.back());
+		}
+	}
+
+	if(!vRequest.empty())
+		pcl::MPI_Waitall((int)vRequest.size(), &vRequest[0], MPI_STATUSES_IGNORE);
+
+//	aggregators write the covered parts of their domain in contiguous blocks
+	if(myDomain >= 0){
+		const char* domainBuf = &lDomainBuf.back()[0];
+		sort(vCovered.begin(), vCovered.end());
+		size_t i = 0;
+		while(i < vCovered.size()){
+			MPI_Offset b = vCovered[i].first;
+			MPI_Offset e = vCovered[i].second;
+			for(++i; i < vCovered.size() && vCovered[i].first <= e; ++i)
+				e = max(e, vCovered[i].second);
+			write_block(b, domainBuf + (b - domainBegin), e - b);
+		}
+
+	//	in asynchronous mode the buffer has to live until the writes completed
+		if(m_bAsync)
+			m_lDomainBuf.splice(m_lDomainBuf.end(), lDomainBuf);
+	}
+}
+
+MPI_Offset CollectiveFileWriter::
+write_ordered(MPI_Offset offset, const char* buf, size_t size)
+{
+	MPI_Offset mySize = (MPI_Offset)size;
+	MPI_Offset myOffset = 0;
+	MPI_Exscan(&mySize, &myOffset, 1, MPI_OFFSET, MPI_SUM, m_pc.get_mpi_communicator());
+	if(m_pc.get_local_proc_id() == 0) myOffset = 0;
+
+	myOffset += offset;
+	write_at_all(myOffset, buf, size);
+	return myOffset;
+}
+
+void CollectiveFileWriter::
+wait()
+{
+	if(!m_vRequest.empty())
+		pcl::MPI_Waitall((int)m_vRequest.size(), &m_vRequest[0], MPI_STATUSES_IGNORE);
+	m_vRequest.clear();
+	m_lDomainBuf.clear();
+}
+
+void CollectiveFileWriter::
+close()
+{
+	if(!m_bOpen) return;
+	m_bOpen = false;
+
+//	in asynchronous mode, all processes defer the (collective) close
+	if(m_bAsync){
+		SmartPtr<PendingFileWrite> pw(new PendingFileWrite);
+		pw->fh = m_fh;
+		pw->lBuf.swap(m_lDomainBuf);
+		pw->vRequest.swap(m_vRequest);
+		PendingFileWrites().push_back(pw);
+		return;
+	}
+
+	wait();
+	MPI_File_close(&m_fh);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	CollectiveFileReader
+
+CollectiveFileReader::
+CollectiveFileReader(ProcessCommunicator pc) :
+	m_pc(pc), m_bOpen(false)
+{
+}
+
+CollectiveFileReader::
+~CollectiveFileReader()
+{
+//	MPI_File_close is collective, thus the file is not closed here
+	if(m_bOpen)
+		UG_LOG("WARNING in CollectiveFileReader: File has not been closed.\n");
+}
+
+void CollectiveFileReader::
+open(const string& filename)
+{
+	PCL_PROFILE(pclCollectiveFileReader_open);
+	UG_COND_THROW(m_bOpen, "CollectiveFileReader::open: A file is already open.");
+
+	CompletePendingFileWrites();
+
+	int err = MPI_File_open(m_pc.get_mpi_communicator(), const_cast<char*>(filename.c_str()),
+							MPI_MODE_RDONLY, MPI_INFO_NULL, &m_fh);
+	UG_COND_THROW(err != MPI_SUCCESS, "CollectiveFileReader: Could not open " << filename);
+	m_bOpen = true;
+}
+
+void CollectiveFileReader::
+read_at_all(MPI_Offset offset, char* buf, size_t size)
+{
+	PCL_PROFILE(pclCollectiveFileReader_read_at_all);
+	UG_COND_THROW(!m_bOpen, "CollectiveFileReader::read_at_all: No file open.");
+
+//	all processes have to take part in the same number of collective reads
+	int myNumChunks = (int)((size + PCL_MAX_IO_CHUNK - 1) / PCL_MAX_IO_CHUNK);
+	int numChunks = 0;
+	MPI_Allreduce(&myNumChunks, &numChunks, 1, MPI_INT, MPI_MAX, m_pc.get_mpi_communicator());
+
+	for(int i = 0; i < numChunks; ++i){
+		size_t pos = min((size_t)i * PCL_MAX_IO_CHUNK, size);
+		int count = (int)min(size - pos, PCL_MAX_IO_CHUNK);
+		MPI_Status status;
+		MPI_File_read_at_all(m_fh, offset + (MPI_Offset)pos, buf + pos, count,
+							 MPI_BYTE, &status);
+	}
+}
+
+void CollectiveFileReader::
+close()
+{
+	if(!m_bOpen) return;
+	MPI_File_close(&m_fh);
+	m_bOpen = false;
+}
+
+}// end of namespace
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__PCL__PARALLEL_COLLECTIVE_IO__
+#define __H__PCL__PARALLEL_COLLECTIVE_IO__
+
+#include <list>
+#include <string>
+#include <vector>
+#include <mpi.h>
+#include "pcl_process_communicator.h"
+#include "common/util/smart_pointer.h"
+
+namespace pcl{
+
+/// \addtogroup pcl
+/// \{
+
+///	sets the default number of aggregator processes for collective file output
+/**	0 (default) selects one aggregator per 64 processes.*/
+void SetCollectiveIONumAggregators(int num);
+
+///	sets the default alignment of the file domains of the aggregators (in bytes)
+/**	The file domain of each aggregator starts at a multiple of this size. It
+ * should match the stripe size of the parallel file system (default 1 MiB).*/
+void SetCollectiveIOStripeSize(size_t size);
+
+///	enables asynchronous flushing of collective file output
+/**	If enabled, writes return as soon as the data has been sent to the
+ * aggregators. The aggregators flush it with non-blocking MPI-IO. Pending
+ * writes are completed on the next collective file operation, by
+ * CompletePendingFileWrites or on pcl::Finalize.*/
+void SetCollectiveIOAsync(bool bAsync);
+
+///	completes all pending asynchronous writes and closes their files
+void CompletePendingFileWrites();
+
+
+///	aggregator based collective file writer
+/**
+ * All processes of the communicator write disjoint regions of one shared
+ * file. Instead of letting every process access the file, the data is sent
+ * to a few aggregator processes (two-phase I/O). Each aggregator owns a
+ * contiguous file domain, which is aligned to the stripe size, and writes
+ * it in large contiguous blocks. This avoids the I/O storm caused by
+ * thousands of small, unaligned, independent writes.
+ *
+ * Aggregators are spread evenly over the ranks of the communicator, such
+ * that they are likely placed on different nodes.
+ *
+ * \code
+ * CollectiveFileWriter w(pc);
+ * w.open("data.bin");
+ * w.write_at_all(myOffset, buf, bufSize);
+ * w.close();
+ * \endcode
+ */
+class CollectiveFileWriter
+{
+	public:
+	///	constructor, uses the global defaults
+		CollectiveFileWriter(ProcessCommunicator pc = ProcessCommunicator(PCD_WORLD));
+
+	///	destructor, completes the local requests but does not close the file
+	/**	Closing is collective, thus close() has to be called explicitly by all
+	 * processes. The destructor may be called on some processes only (e.g.
+	 * if an exception is thrown), hence it only warns if a file is open.*/
+		~CollectiveFileWriter();
+
+	///	sets the number of aggregators (0: automatic)
+		void set_num_aggregators(int num)	{m_numAggregators = num;}
+
+	///	sets the alignment of the aggregator file domains (in bytes)
+		void set_stripe_size(size_t size);
+
+	///	sets whether the aggregators flush asynchronously
+		void set_async(bool bAsync)			{m_bAsync = bAsync;}
+
+	///	collectively creates (or truncates) the file
+		void open(const std::string& filename);
+
+	///	collectively writes the local buffer at the given file offset
+	/**	The regions of all processes must not overlap. The local buffer may be
+	 * reused as soon as this method returns, even in asynchronous mode.*/
+		void write_at_all(MPI_Offset offset, const char* buf, size_t size);
+
+	///	collectively writes the local buffers in rank order, starting at offset
+	/**	\returns the file offset of the local buffer*/
+		MPI_Offset write_ordered(MPI_Offset offset, const char* buf, size_t size);
+
+	///	completes all writes and collectively closes the file
+		void close();
+
+	///	returns the number of aggregators used by the last write
+		int num_aggregators() const			{return m_numAggregatorsUsed;}
+
+	private:
+	///	starts the write of a contiguous block (blocking or non-blocking)
+		void write_block(MPI_Offset offset, const char* buf, size_t size);
+
+	///	waits for all non-blocking writes
+		void wait();
+
+	private:
+		ProcessCommunicator m_pc;
+		int m_numAggregators;
+		int m_numAggregatorsUsed;
+		MPI_Offset m_stripeSize;
+		bool m_bAsync;
+
+		bool m_bOpen;
+		MPI_File m_fh;
+
+	///	domain buffers of the aggregators, kept until the writes completed
+		std::list<std::vector<char> > m_lDomainBuf;
+		std::vector<MPI_Request> m_vRequest;
+};
+
+
+///	collective reader for files written by CollectiveFileWriter
+/**	Each process reads only its own slice of the file.*/
+class CollectiveFileReader
+{
+	public:
+		CollectiveFileReader(ProcessCommunicator pc = ProcessCommunicator(PCD_WORLD));
+
+	///	destructor, does not close the file (see ~CollectiveFileWriter)
+		~CollectiveFileReader();
+
+	///	collectively opens the file for reading
+		void open(const std::string& filename);
+
+	///	collectively reads size bytes at the given offset into buf
+		void read_at_all(MPI_Offset offset, char* buf, size_t size);
+
+	///	collectively closes the file
+		void close();
+
+	private:
+		ProcessCommunicator m_pc;
+		bool m_bOpen;
+		MPI_File m_fh;
+};
+
+// end group pcl
+/// \}
+
+}// end of namespace
+
+#endif
@@ -31,108 +31,128 @@
  */
 
 #include "pcl_process_communicator.h"
+#include "parallel_collective_io.h"
 #include "common/util/binary_buffer.h"
+#include "common/util/combined_file.h"
 #include "common/log.h"
+#include "common/error.h"
+#include "pcl_profiling.h"
+#include <cstring>
+#include <stdint.h>
 #include <map>
 #include <string>
+#include <vector>
 #include <mpi.h>
 
 namespace pcl{
 
+using ug::COMBINED_FILE_FORMAT_OFFSET64;
 
 void WriteCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename, pcl::ProcessCommunicator pc)
 {
-		MPI_Status status;
-	MPI_Comm m_mpiComm = pc.get_mpi_communicator();
-	MPI_File fh;
-	bool bFirst = pc.get_proc_id(0) == pcl::ProcRank();
+	PCL_PROFILE(pclWriteCombinedParallelFile);
+	MPI_Comm comm = pc.get_mpi_communicator();
+	const int numProcs = (int)pc.size();
+	const bool bFirst = pc.get_local_proc_id() == 0;
 
-	char filename[1024];
-	strcpy(filename, strFilename.c_str());
-	if(MPI_File_open(m_mpiComm, filename, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh))
-		UG_THROW("could not open "<<filename);
+//	header: format, number of processes, end offset of the data of each process
+	const MPI_Offset headerSize = 2*sizeof(int) + numProcs*sizeof(int64_t);
 
-	int mySize = buffer.write_pos();
-	int myNextOffset = 0;
-	MPI_Scan(&mySize, &myNextOffset, 1, MPI_INT, MPI_SUM, m_mpiComm);
+	MPI_Offset mySize = buffer.write_pos();
+	MPI_Offset myOffset = 0;
+	MPI_Exscan(&mySize, &myOffset, 1, MPI_OFFSET, MPI_SUM, comm);
+	if(bFirst) myOffset = 0;
+	myOffset += headerSize;
 
+	MPI_Offset myNextOffset = myOffset + mySize;
+	std::vector<MPI_Offset> allNextOffsets(bFirst ? numProcs : 1);
+	MPI_Gather(&myNextOffset, 1, MPI_OFFSET, &allNextOffsets[0], 1, MPI_OFFSET, 0, comm);
 
-	std::vector<int> allNextOffsets;
-	allNextOffsets.resize(pc.size(), 0);
-	//else allNextOffsets.resize(1);
-
-	myNextOffset += (pc.size()+1)*sizeof(int);
-	MPI_Gather(&myNextOffset, 1, MPI_INT, &allNextOffsets[0], 1, MPI_INT, pc.get_proc_id(0), m_mpiComm);
+	CollectiveFileWriter writer(pc);
+	writer.open(strFilename);
 
 	if(bFirst)
 	{
-		int numProcs = pcl::NumProcs();
-		MPI_File_write(fh, &numProcs, sizeof(numProcs), MPI_BYTE, &status);
-		for(size_t i=0; i<allNextOffsets.size(); i++)
-		{
-//			UG_LOG("allNextOffsets[" << i << "] = " << allNextOffsets[i] << "\n");
-			MPI_File_write(fh, &allNextOffsets[i], sizeof(allNextOffsets[i]), MPI_BYTE, &status);
+	//	the first process writes the header in front of its data
+		std::vector<char> block(headerSize + mySize);
+		int format = COMBINED_FILE_FORMAT_OFFSET64;
+		memcpy(&block[0], &format, sizeof(int));
+		memcpy(&block[sizeof(int)], &numProcs, sizeof(int));
+		for(int i = 0; i < numProcs; ++i){
+			int64_t nextOffset = allNextOffsets[i];
+			memcpy(&block[2*sizeof(int) + i*sizeof(int64_t)], &nextOffset, sizeof(int64_t));
 		}
+		if(mySize > 0)
+			memcpy(&block[headerSize], buffer.buffer(), mySize);
+		writer.write_at_all(0, &block[0], block.size());
 	}
+	else
+		writer.write_at_all(myOffset, buffer.buffer(), mySize);
 
-	int myOffset = myNextOffset - buffer.write_pos();
-	MPI_File_seek(fh, myOffset, MPI_SEEK_SET);
-
-//	UG_LOG_ALL_PROCS("MySize = " << mySize << "\n" << " myOffset = " << myOffset << "\n");
-//	UG_LOG_ALL_PROCS("buffer.write_pos() = " << buffer.write_pos() << "\n" << "(pc.size()+1)*sizeof(size_t) = " << (pc.size()+1)*sizeof(size_t) << "\n");
-
-	MPI_File_write(fh, buffer.buffer(), buffer.write_pos(), MPI_BYTE, &status);
-
-	MPI_File_close(&fh);
+	writer.close();
 }
 
 void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename, pcl::ProcessCommunicator pc)
 {
-	MPI_Status status;
-	MPI_Comm m_mpiComm = pc.get_mpi_communicator();
-	MPI_File fh;
-
-	char filename[1024];
-	strcpy(filename, strFilename.c_str());
-	if(MPI_File_open(m_mpiComm, filename, MPI_MODE_CREATE | MPI_MODE_RDWR, MPI_INFO_NULL, &fh))
-		UG_THROW("could not open "<<filename);
-
-	std::vector<int> allNextOffsets;
-	allNextOffsets.resize(pc.size()+1);
+	PCL_PROFILE(pclReadCombinedParallelFile);
+	MPI_Comm comm = pc.get_mpi_communicator();
+	const int numProcs = (int)pc.size();
+	const bool bFirst = pc.get_local_proc_id() == 0;
+
+	CollectiveFileReader reader(pc);
+	reader.open(strFilename);
+
+//	the first process reads the header and sends it to all processes, since
+//	the format decides on the number of the following collective reads.
+//	Files with int offsets start with the number of processes, files with
+//	64 bit offsets with a format id.
+	int header[2] = {0, 0};
+	reader.read_at_all(0, (char*)header, bFirst ? 2*sizeof(int) : 0);
+	MPI_Bcast(header, 2, MPI_INT, 0, comm);
+
+	int fileNumProcs = (header[0] == COMBINED_FILE_FORMAT_OFFSET64) ? header[1] : header[0];
+	if(fileNumProcs != numProcs){
+		reader.close();
+		UG_THROW("checkPoint numProcs = " << fileNumProcs << ", but running on " << numProcs);
+	}
 
-	allNextOffsets[0] = (pc.size()+1)*sizeof(int);
-	bool bFirst = pc.get_proc_id(0) == pcl::ProcRank();
-	if(bFirst)
+	std::vector<MPI_Offset> allOffsets(bFirst ? numProcs+1 : 1);
+	if(header[0] == COMBINED_FILE_FORMAT_OFFSET64)
 	{
-		int numProcs;
-		MPI_File_read(fh, &numProcs, sizeof(numProcs), MPI_BYTE, &status);
-		UG_COND_THROW(numProcs != pcl::NumProcs(), "checkPoint numProcs = " << numProcs << ", but running on " << pcl::NumProcs());
-
-		for(size_t i=1; i<allNextOffsets.size(); i++)
-		{
-			MPI_File_read(fh, &allNextOffsets[i], sizeof(allNextOffsets[i]), MPI_BYTE, &status);
-//			UG_LOG("allNextOffsets[" << i << "] = " << allNextOffsets[i] << "\n");
+		std::vector<int64_t> nextOffsets(numProcs);
+		reader.read_at_all(2*sizeof(int), (char*)&nextOffsets[0],
+						   bFirst ? numProcs*sizeof(int64_t) : 0);
+		if(bFirst){
+			allOffsets[0] = 2*sizeof(int) + numProcs*sizeof(int64_t);
+			for(int i = 0; i < numProcs; ++i) allOffsets[i+1] = nextOffsets[i];
+		}
+	}
+	else
+	{
+		std::vector<int> nextOffsets(numProcs);
+		nextOffsets[0] = header[1];
+		reader.read_at_all(2*sizeof(int), (char*)&nextOffsets[0] + sizeof(int),
+						   bFirst ? (numProcs-1)*sizeof(int) : 0);
+		if(bFirst){
+			allOffsets[0] = (numProcs+1)*sizeof(int);
+			for(int i = 0; i < numProcs; ++i) allOffsets[i+1] = nextOffsets[i];
 		}
 	}
-	int myNextOffset, myNextOffset2;
-	MPI_Scatter(&allNextOffsets[0], 1, MPI_INT, &myNextOffset, 1, MPI_INT, pc.get_proc_id(0), m_mpiComm);
-	MPI_Scatter(&allNextOffsets[1], 1, MPI_INT, &myNextOffset2, 1, MPI_INT, pc.get_proc_id(0), m_mpiComm);
-
-	int mySize = myNextOffset2-myNextOffset;
 
-//	UG_LOG_ALL_PROCS("MySize = " << mySize << "\n" << "myNextOffset = " << myNextOffset << " - " << myNextOffset2 << "\n");
+	MPI_Offset myOffset, myNextOffset;
+	MPI_Scatter(&allOffsets[0], 1, MPI_OFFSET, &myOffset, 1, MPI_OFFSET, 0, comm);
+	MPI_Scatter(bFirst ? &allOffsets[1] : &allOffsets[0], 1, MPI_OFFSET, &myNextOffset, 1, MPI_OFFSET, 0, comm);
 
-	MPI_File_seek(fh, myNextOffset, MPI_SEEK_SET);
+//	each process reads only its own slice
+	size_t mySize = myNextOffset - myOffset;
+	std::vector<char> p(mySize);
+	reader.read_at_all(myOffset, mySize ? &p[0] : NULL, mySize);
+	reader.close();
 
-	char *p = new char[mySize];
-	MPI_File_read(fh, p, mySize, MPI_BYTE, &status);
 	buffer.clear();
 	buffer.reserve(mySize);
-	buffer.write(p, mySize);
-	delete[] p;
-
-	MPI_File_close(&fh);
-	//	UG_LOG("File read.\n");
+	if(mySize > 0)
+		buffer.write(&p[0], mySize);
 }
 
 }
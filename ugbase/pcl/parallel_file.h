@@ -35,6 +35,7 @@
 
 #include "pcl_process_communicator.h"
 #include "common/util/binary_buffer.h"
+#include "common/util/combined_file.h"
 
 namespace pcl{
 
@@ -47,25 +48,31 @@ namespace pcl{
  *
  * The file format is as follows:
  *
- * size_t 	numProcs
- * int		nextOffset[numProcs]
+ * int		-2 (format tag, ug::COMBINED_FILE_FORMAT_OFFSET64)
+ * int 		numProcs
+ * int64	nextOffset[numProcs]
  * byte data1[...]
  * byte data2[...]
  * ...
  *
- * That means, in the file the first entry is size_t numProcs, then an array of ints with the offset of
- * the next data set (see more description below), and then the actual data.
+ * That means, in the file the first entries are a format tag and the number of processes,
+ * then an array of 64 bit integers with the offset of the next data set
+ * (see more description below), and then the actual data.
  * This function is executed in parallel, so if core 0 has 1024 bytes of data, core 1 has 256 bytes of data, and core 3 has 500 bytes,
- * we have sizeof(size_t) + 3*sizeof(int) = 4*8 = 32 bytes of header, so
- * (size_t) 3
- * (int) 32+1024
- * (int) 32+1024+256
- * (int) 32+1024+256+500
+ * we have 2*sizeof(int) + 3*8 = 32 bytes of header, so
+ * (int) -2
+ * (int) 3
+ * (int64) 32+1024
+ * (int64) 32+1024+256
+ * (int64) 32+1024+256+500
  * 32: data1
  * 32+1024: data2
  * 32+1024+256: data2
  *
  * We store the nextOffset to get access to the size of the data written.
+ * The data is written through a CollectiveFileWriter, i.e. only a few
+ * aggregator processes access the file (see parallel_collective_io.h).
+ * Files in the old format with an int numProcs and int offsets can still be read.
  *
  * @param buffer		a Binary buffer with data
  * @param strFilename	the filename
@@ -34,6 +34,7 @@
 #include "pcl_comm_world.h"
 #include "pcl_base.h"
 #include "pcl_profiling.h"
+#include "parallel_collective_io.h"
 #include "common/log.h"
 
 namespace pcl
@@ -65,6 +66,7 @@ void Abort(int errorcode)
 void Finalize()
 {
 	PCL_PROFILE(pclFinalize);
+	CompletePendingFileWrites();
 	MPI_Finalize();
 }
 
@@ -299,6 +299,16 @@ class ProcessCommunicator
 	///	overload for size_t
 		size_t allreduce(const size_t &t, pcl::ReduceOperation op) const;
 
+	///	starts a non-blocking MPI_Iallreduce on the processes of the communicator.
+	/**	The result is only available in recBuf after the request has been
+	 * completed by pcl::MPI_Wait. sendBuf and recBuf must stay valid until then.
+	 * If the MPI implementation does not support non-blocking collectives
+	 * (MPI_VERSION < 3), a blocking MPI_Allreduce is performed and the request
+	 * is set to MPI_REQUEST_NULL.*/
+		void iallreduce(const void* sendBuf, void* recBuf, int count,
+						DataType type, ReduceOperation op,
+						MPI_Request& request) const;
+
 	/** simplified allreduce for buffers.
 	 * \param pSendBuff the input buffer
 	 * \param pReceiveBuff the output buffer